@@ -1,27 +0,0 @@
-
-# Consider dependencies only in project.
-set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
-
-# The set of languages for which implicit dependencies are needed:
-set(CMAKE_DEPENDS_LANGUAGES
-  )
-
-# The set of dependency files which are needed:
-set(CMAKE_DEPENDS_DEPENDENCY_FILES
-  "/home/jm/1st_project_2020136085/src/commands.c" "CMakeFiles/file_system_gui.dir/src/commands.c.o" "gcc" "CMakeFiles/file_system_gui.dir/src/commands.c.o.d"
-  "/home/jm/1st_project_2020136085/src/utils.c" "CMakeFiles/file_system_gui.dir/src/utils.c.o" "gcc" "CMakeFiles/file_system_gui.dir/src/utils.c.o.d"
-  "/home/jm/1st_project_2020136085/build/file_system_gui_autogen/mocs_compilation.cpp" "CMakeFiles/file_system_gui.dir/file_system_gui_autogen/mocs_compilation.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/file_system_gui_autogen/mocs_compilation.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/main.cpp" "CMakeFiles/file_system_gui.dir/src/main.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/main.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/mainwindow.cpp" "CMakeFiles/file_system_gui.dir/src/mainwindow.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/mainwindow.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/mainwindow_file_actions.cpp" "CMakeFiles/file_system_gui.dir/src/mainwindow_file_actions.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/mainwindow_file_actions.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/mainwindow_process_actions.cpp" "CMakeFiles/file_system_gui.dir/src/mainwindow_process_actions.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/mainwindow_process_actions.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/mainwindow_test_actions.cpp" "CMakeFiles/file_system_gui.dir/src/mainwindow_test_actions.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/mainwindow_test_actions.cpp.o.d"
-  "/home/jm/1st_project_2020136085/src/mainwindow_ui.cpp" "CMakeFiles/file_system_gui.dir/src/mainwindow_ui.cpp.o" "gcc" "CMakeFiles/file_system_gui.dir/src/mainwindow_ui.cpp.o.d"
-  )
-
-# Targets to which this target links.
-set(CMAKE_TARGET_LINKED_INFO_FILES
-  )
-
-# Fortran module output directory.
-set(CMAKE_Fortran_TARGET_MODULE_DIR "")
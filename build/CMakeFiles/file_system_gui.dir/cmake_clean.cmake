@@ -1,30 +0,0 @@
-file(REMOVE_RECURSE
-  "CMakeFiles/file_system_gui_autogen.dir/AutogenUsed.txt"
-  "CMakeFiles/file_system_gui_autogen.dir/ParseCache.txt"
-  "file_system_gui_autogen"
-  "CMakeFiles/file_system_gui.dir/file_system_gui_autogen/mocs_compilation.cpp.o"
-  "CMakeFiles/file_system_gui.dir/file_system_gui_autogen/mocs_compilation.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/commands.c.o"
-  "CMakeFiles/file_system_gui.dir/src/commands.c.o.d"
-  "CMakeFiles/file_system_gui.dir/src/main.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/main.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_file_actions.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_file_actions.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_process_actions.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_process_actions.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_test_actions.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_test_actions.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_ui.cpp.o"
-  "CMakeFiles/file_system_gui.dir/src/mainwindow_ui.cpp.o.d"
-  "CMakeFiles/file_system_gui.dir/src/utils.c.o"
-  "CMakeFiles/file_system_gui.dir/src/utils.c.o.d"
-  "bin/file_system_gui"
-  "bin/file_system_gui.pdb"
-)
-
-# Per-language clean rules from dependency scanning.
-foreach(lang C CXX)
-  include(CMakeFiles/file_system_gui.dir/cmake_clean_${lang}.cmake OPTIONAL)
-endforeach()
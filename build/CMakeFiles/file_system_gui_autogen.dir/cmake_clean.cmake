@@ -1,9 +0,0 @@
-file(REMOVE_RECURSE
-  "CMakeFiles/file_system_gui_autogen"
-  "file_system_gui_autogen/mocs_compilation.cpp"
-)
-
-# Per-language clean rules from dependency scanning.
-foreach(lang )
-  include(CMakeFiles/file_system_gui_autogen.dir/cmake_clean_${lang}.cmake OPTIONAL)
-endforeach()
@@ -1,6 +0,0 @@
-// This file is autogenerated. Changes will be overwritten.
-#include "6YEA5652QU/moc_mainwindow.cpp"
-#include "6YEA5652QU/moc_mainwindow_file_actions.cpp"
-#include "6YEA5652QU/moc_mainwindow_process_actions.cpp"
-#include "6YEA5652QU/moc_mainwindow_test_actions.cpp"
-#include "6YEA5652QU/moc_mainwindow_ui.cpp"
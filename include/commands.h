@@ -3,34 +3,52 @@
 #define COMMANDS_H
 
 #include "config.h"
+#include "dirscan.h"
+#include "du.h"
+#include "grep.h"
+#include "pidsig.h"
+#include "procscan.h"
+#include "proctree.h"
+#include <stdio.h>
 #include <sys/mman.h>
 #include <signal.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <time.h>
 
-#define SHARED_SIZE 4096
-
-// 시그널 관련 전역 변수와 함수
-extern volatile sig_atomic_t data_ready;
-
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void handle_usr1(int signo);
+// 결과를 출력하는 빌트인(help, ls, cat, ps, grep, du)의 출력 스트림. 기본은 stdout이고,
+// 파이프라인/리디렉션 단계를 실행하는 스레드만 자기 스트림으로 바꿈 (오류 메시지는 그대로)
+FILE *shell_output(void);
+void shell_set_output(FILE *out);
 
 struct ps_options {
     int long_format;
     int show_all;
+    int show_metrics;    // -v 옵션: 스캔 측정값 출력
+    int tree;            // --tree 옵션: 부모-자식 트리와 하위 트리 합계
 };
 
+struct pkill_options {
+    int sig;             // 기본 SIGTERM
+    int match_flags;     // PROC_MATCH_* (-f, -x, -i)
+    int list_only;       // -n 옵션: 보내지 않고 일치하는 프로세스만 출력 (pgrep)
+    int wait_sec;        // -w 옵션: 종료를 기다릴 시간, 지나면 SIGKILL (0이면 기다리지 않음)
+};
+
+// pkill -w로 SIGKILL을 보낸 뒤 종료를 기다리는 시간
+#define PKILL_KILL_WAIT_MS 1000
+
 struct ls_options {
     int sort_by_time;    // -t 옵션
     int sort_by_size;    // -S 옵션
     int reverse_sort;    // -r 옵션
     int show_all_times;  // -T 옵션
     int long_format;     // -l 옵션 추가
+    int stat_workers;    // -j N 옵션: 병렬 stat 스레드 수 (0이면 기본값)
 };
 
 // 파일 정보를 위한 구조체
@@ -39,8 +57,63 @@ struct file_info {
     struct stat st;
 };
 
+// 메모리 매핑 테스트: 파일을 매핑한 공유 메모리 링(shmring)으로 자식 생산자들이 메시지를
+// 흘려보내고 부모가 받으며 처리량과 지연(보낸 시각부터 받은 시각까지)을 잼
+#define MMAP_TEST_DEFAULT_MESSAGES  2000000UL
+#define MMAP_TEST_DEFAULT_CAPACITY  1024
+#define MMAP_TEST_DEFAULT_MSG_SIZE  48      // 슬롯 헤더와 합쳐 캐시 라인 하나
+#define MMAP_TEST_MAX_PRODUCERS     16
+#define MMAP_TEST_MAX_MSG_SIZE      4096
+
+struct mmap_test_options {
+    unsigned long messages;     // 전체 메시지 수 (생산자들이 나눠 보냄)
+    int producers;              // 1이면 SPSC, 2 이상이면 MPSC
+    uint32_t capacity;          // 링 슬롯 수
+    uint32_t msg_size;          // 메시지 바이트 (타임스탬프와 순번 포함)
+};
+
+struct mmap_test_result {
+    pid_t parent_pid;
+    int producers;
+    uint32_t capacity;
+    uint32_t msg_size;
+    unsigned long messages;     // 받은 메시지 수
+    unsigned long out_of_order; // 생산자별 순번이 어긋난 메시지 수
+    double elapsed_ms;
+    double msgs_per_sec;
+    double mb_per_sec;
+    uint64_t p50_ns, p99_ns, p999_ns, max_ns;
+    uint64_t producer_sleeps;   // 링이 가득 차서 생산자가 잠든 횟수
+    uint64_t consumer_sleeps;   // 링이 비어서 소비자가 잠든 횟수
+};
+
+// ls_bench: 포맷할 항목 수 기본값과, 두 방식의 출력을 비교할 앞부분 항목 수
+#define LS_BENCH_DEFAULT_ENTRIES  100000
+#define LS_BENCH_VERIFY_ENTRIES   5000
+
+// 스트리밍 ls: 요청한 순서의 앞부분만 부분 선택/정렬하여 페이지 단위로 반환
+#define LS_PAGE_SIZE 512
+
+struct ls_pager {
+    struct dir_listing listing;
+    uint32_t *order;     // 출력 순서 (listing 엔트리 인덱스)
+    size_t total;        // 출력 대상 엔트리 수 (페이지를 가져올 때 사라진 엔트리는 빠짐)
+    size_t sorted;       // 정렬이 확정된 앞부분 길이
+    size_t pos;          // 다음에 내보낼 위치
+    struct ls_options opts;
+    unsigned need;
+    dir_entry_cmp_fn cmp;
+    char dir[MAX_PATH_SIZE];
+};
+
+// 구조화된 결과 API 오류 코드 (-1은 errno 참조)
+#define FSOPS_ERR_OUTSIDE_BASE  (-2)
+
+// 데이터 싱크 콜백: 0을 반환하면 계속, 0이 아니면 중단
+typedef int (*data_sink_fn)(void *ctx, const char *data, size_t len);
+
 // 모든 함수 선언을 여기로 이동
-void remove_directory_recursive(const char *path);
+int remove_directory_recursive(const char *path);
 void call_help(void);
 void call_ls(const char *current_dir, const struct ls_options *opts);
 void call_cd(const char *current_dir, const char *path, char *new_dir);
@@ -54,10 +127,34 @@ void call_cat(const char *current_dir, const char *path);
 void call_cp(const char *current_dir, const char *source, const char *target);
 void call_ps(const char *options);
 int call_kill(const char *pid_str, const char *sig_str);
-void call_mmap_test(const char *filename);
-void execute_program(const char *program_name, char **args);
+int call_pkill(const char *pattern, const struct pkill_options *opts);
+void call_mmap_test(const char *filename, const struct mmap_test_options *opts);
+void call_stat_bench(const char *current_dir, const char *path);
+void call_cp_bench(const char *current_dir, const char *size_mb_str);
+void call_ls_bench(const char *count_str);
+void call_du(const char *current_dir, const char *path, const struct du_options *opts,
+             int apparent, int human);
+void call_grep(const char *current_dir, const char *pattern, const char *path,
+               const struct grep_options *opts);
+// 파이프라인 앞 단계의 출력처럼 fd로 들어오는 입력에서 일치하는 줄만 출력.
+// 일치가 있으면 0, 없으면 1, 오류면 -1
+int call_grep_fd(int fd, const char *pattern, const struct grep_options *opts);
 int setup_chroot(const char* path);
 
+// 구조화된 결과 API: stdout을 거치지 않고 호출자에게 레코드를 직접 반환
+int ls_collect(const char *current_dir, const struct ls_options *opts,
+               struct file_info **files, size_t *count);
+int ls_pager_open(struct ls_pager *p, const char *current_dir, const struct ls_options *opts);
+size_t ls_pager_next(struct ls_pager *p, struct file_info *out, size_t max);
+void ls_pager_close(struct ls_pager *p);
+int cat_read(const char *current_dir, const char *path, data_sink_fn sink, void *ctx);
+void parse_ps_options(const char *options, struct ps_options *opts);
+int ps_collect(const struct ps_options *opts, struct proc_info **procs, size_t *count,
+               struct proc_scan_metrics *metrics);
+void mmap_test_default_options(struct mmap_test_options *opts);
+int mmap_test_run(const char *filename, const struct mmap_test_options *opts,
+                  struct mmap_test_result *result);
+
 #ifdef __cplusplus
 }
 #endif 
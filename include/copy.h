@@ -0,0 +1,67 @@
+#pragma once
+#ifndef COPY_H
+#define COPY_H
+
+#include "config.h"
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 사용자 공간 버퍼 경로에서 쓰는 정렬된 버퍼 크기
+#define COPY_BUF_SIZE   (1024 * 1024)
+#define COPY_BUF_ALIGN  4096
+
+// 실제로 사용된 복사 방식
+enum copy_method {
+    COPY_METHOD_NONE = 0,
+    COPY_METHOD_RANGE,      // copy_file_range (커널 내부 복사, reflink 가능)
+    COPY_METHOD_SENDFILE,   // sendfile (페이지 캐시 간 복사)
+    COPY_METHOD_BUFFER      // read/write + 정렬된 버퍼
+};
+
+// 호출 전에 0으로 초기화해야 함
+struct copy_stats {
+    unsigned long long bytes;
+    enum copy_method method;
+    unsigned long long *progress;  // NULL이 아니면 복사한 바이트를 원자적으로 더함
+    const int *cancel;             // NULL이 아니고 0이 아니게 되면 ECANCELED로 중단
+};
+
+int copy_fd(int in_fd, int out_fd, struct copy_stats *stats);
+int copy_file(const char *src, const char *dst, struct copy_stats *stats);
+const char *copy_method_name(enum copy_method method);
+
+// 여러 파일/디렉토리 트리를 워커 스레드로 병렬 복사 (작업 훔치기 방식)
+#define COPY_MAX_WORKERS  16
+
+struct copy_job;
+
+struct copy_progress {
+    unsigned long long files_total;   // 탐색이 끝나기 전에는 계속 늘어남
+    unsigned long long files_done;
+    unsigned long long bytes_total;
+    unsigned long long bytes_done;
+    unsigned long long errors;
+    int finished;
+};
+
+// copy_job_start 플래그
+#define COPY_JOB_MOVE  0x01   // 이동: 같은 장치면 rename, 다른 장치면 복사+검증 후 원본 삭제
+                              // (대상이 이미 있으면 거부, 실패/취소된 항목은 대상을 지워 되돌림)
+
+// sources[i]를 targets[i]로 복사. workers가 0 이하면 CPU 수 사용
+struct copy_job *copy_job_start(const char *const *sources, const char *const *targets,
+                                size_t n, int workers, int flags);
+void copy_job_progress(struct copy_job *job, struct copy_progress *out);
+void copy_job_cancel(struct copy_job *job);
+int copy_job_wait(struct copy_job *job);             // 오류나 취소가 있었으면 -1
+const char *copy_job_error(struct copy_job *job);    // 첫 번째 오류 메시지, 없으면 NULL
+void copy_job_free(struct copy_job *job);            // copy_job_wait 후에 호출
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COPY_H
@@ -0,0 +1,74 @@
+#ifndef DIR_STATS_TRACKER_H
+#define DIR_STATS_TRACKER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+class QSocketNotifier;
+
+// 현재 디렉토리의 파일 수/디렉토리 수/총 크기를 증분으로 유지.
+// 전체 집계는 디렉토리를 바꿀 때와 주기적인 일관성 검사 때만 (워커 스레드에서) 하고,
+// 그 사이에는 inotify 이벤트와 작업 직후의 touch로 바뀐 이름만 다시 stat 함
+class DirStatsTracker : public QObject {
+    Q_OBJECT
+public:
+    static const int RESCAN_INTERVAL_MS = 30000;  // 일관성 검사 주기
+    static const int COALESCE_MS = 50;            // 이벤트를 모아서 처리하는 간격
+
+    struct Entry {
+        enum Kind { File, Dir, Other } kind;
+        qint64 size;
+    };
+
+    explicit DirStatsTracker(QObject *parent = nullptr);
+    ~DirStatsTracker() override;
+
+    void setDirectory(const QString &path);  // 같은 디렉토리면 아무것도 안 함
+    void touch(const QString &name);         // 현재 디렉토리의 항목 하나를 다시 stat
+    void touchPath(const QString &path);     // 현재 디렉토리 바로 아래가 아니면 무시
+
+    bool ready() const { return loaded; }
+    int fileCount() const { return files; }
+    int dirCount() const { return dirs; }
+    qint64 totalSize() const { return bytes; }
+
+signals:
+    void statsChanged();
+
+private:
+    void readEvents();
+    void flushPending();
+    void startFullScan();
+    void finishFullScan(qulonglong generation, const QHash<QByteArray, Entry> &result);
+    void apply(const QByteArray &name);
+    void account(const Entry &entry, int sign);
+    void closeDirectory();
+
+    QString dirPath;
+    int dirFd = -1;
+    int inotifyFd = -1;
+    int watch = -1;
+    QSocketNotifier *notifier = nullptr;
+
+    QHash<QByteArray, Entry> entries;
+    int files = 0;
+    int dirs = 0;
+    qint64 bytes = 0;
+    bool loaded = false;
+
+    QSet<QByteArray> pending;            // 아직 처리하지 않은 변경 이름
+    QTimer coalesceTimer;
+    QTimer rescanTimer;
+
+    QThreadPool pool;
+    qulonglong scanGeneration = 0;
+    bool scanning = false;
+    QSet<QByteArray> touchedDuringScan;  // 전체 집계 도중 바뀐 이름 (결과 반영 후 다시 적용)
+};
+
+#endif // DIR_STATS_TRACKER_H
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef DIRSCAN_H
+#define DIRSCAN_H
+
+#include "config.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 엔트리별로 가져올 메타데이터 필드 (statx 마스크로 변환됨)
+#define DIRSCAN_NEED_TYPE   0x01   // 파일 유형 (d_type으로 충분하면 stat 생략)
+#define DIRSCAN_NEED_SIZE   0x02   // 크기
+#define DIRSCAN_NEED_MTIME  0x04   // 수정 시간
+#define DIRSCAN_NEED_TIMES  0x08   // 접근/변경 시간 (-T)
+#define DIRSCAN_NEED_OWNER  0x10   // 권한, 링크 수, uid/gid
+#define DIRSCAN_NEED_INODE  0x20   // inode 번호
+#define DIRSCAN_NEED_ALL    0x3f
+
+// dir_listing_open 플래그
+#define DIRSCAN_SKIP_DOTS   0x01   // "." 과 ".." 제외
+
+// 디렉토리 엔트리 하나 (이름은 listing의 names 아레나에 저장)
+struct dir_entry {
+    uint32_t name_off;
+    uint16_t name_len;
+    uint8_t d_type;
+    uint8_t fetched;     // 채워진 DIRSCAN_NEED_* 필드
+    int error;           // 마지막 stat 실패 시 errno, 성공이면 0
+    mode_t mode;
+    nlink_t nlink;
+    uid_t uid;
+    gid_t gid;
+    off_t size;
+    ino_t ino;
+    time_t atime;
+    time_t mtime;
+    time_t ctime;
+};
+
+// 디렉토리 fd를 유지하는 목록 (엔트리/이름 버퍼는 기하급수적으로 증가)
+struct dir_listing {
+    int dirfd;
+    struct dir_entry *entries;
+    size_t count;
+    size_t capacity;
+    char *names;
+    size_t names_len;
+    size_t names_capacity;
+    int workers;         // 메타데이터 병렬 조회 스레드 수 (0이면 전역 기본값)
+};
+
+// 병렬 stat 설정: 이 개수 이상의 엔트리를 조회할 때만 워커 풀을 사용
+#define DIRSCAN_MAX_WORKERS    64
+#define DIRSCAN_PARALLEL_MIN   64
+
+void dirscan_set_workers(int workers);
+int dirscan_get_workers(void);
+
+int dir_listing_open(struct dir_listing *l, const char *path, int flags);
+int dir_listing_fetch(struct dir_listing *l, size_t begin, size_t end, unsigned need);
+int dir_listing_fetch_indices(struct dir_listing *l, const uint32_t *indices, size_t n,
+                              unsigned need);
+int dir_listing_scan(struct dir_listing *l, const char *path, int flags, unsigned need);
+void dir_listing_free(struct dir_listing *l);
+
+static inline const char *dir_entry_name(const struct dir_listing *l, const struct dir_entry *e) {
+    return l->names + e->name_off;
+}
+
+// 정렬 순서 배열(엔트리 인덱스)에 대한 부분 정렬/선택
+typedef int (*dir_entry_cmp_fn)(const struct dir_listing *l, const struct dir_entry *a,
+                                const struct dir_entry *b, void *ctx);
+
+void dir_order_select(const struct dir_listing *l, uint32_t *order, size_t begin, size_t nth,
+                      size_t end, dir_entry_cmp_fn cmp, void *ctx);
+void dir_order_sort(const struct dir_listing *l, uint32_t *order, size_t begin, size_t end,
+                    dir_entry_cmp_fn cmp, void *ctx);
+
+int dir_entry_is_dir(const struct dir_entry *e);
+int dir_entry_is_reg(const struct dir_entry *e);
+void dir_entry_to_stat(const struct dir_entry *e, struct stat *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DIRSCAN_H
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef DU_H
+#define DU_H
+
+#include "config.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 병렬 디스크 사용량 집계. 하드 링크는 (dev, inode) 기준으로 한 번만 셈.
+// 디렉토리별 직속 항목 합계는 (dev, inode)로 캐시하고 디렉토리 mtime이 바뀌면 무효화하므로,
+// 다시 집계할 때 바뀌지 않은 디렉토리는 readdir/stat 없이 fstat 한 번으로 끝남.
+// (디렉토리 mtime은 항목 추가/삭제/이름 변경 때만 바뀌므로, 파일 내용만 커진 경우는
+//  DU_NO_CACHE로 다시 집계해야 반영됨)
+#define DU_MAX_WORKERS  16
+
+// du_options.flags
+#define DU_NO_CACHE     0x01   // 캐시를 읽지 않고 모두 다시 읽음 (결과는 캐시에 저장)
+
+struct du_options {
+    int max_depth;    // 결과에 넣을 최대 깊이 (루트가 0, 음수면 전부)
+    int workers;      // 0 이하면 CPU 수
+    int flags;
+};
+
+// 디렉토리 하나의 재귀 합계
+struct du_entry {
+    char *path;
+    int depth;
+    unsigned long long bytes;    // 겉보기 크기 (st_size 합)
+    unsigned long long blocks;   // 실제 디스크 사용량 (st_blocks * 512 합)
+    unsigned long long files;    // 디렉토리가 아닌 항목 수
+    unsigned long long dirs;     // 하위 디렉토리 수 (자신 제외)
+};
+
+struct du_result {
+    struct du_entry *entries;    // 하위 디렉토리가 상위보다 먼저 오는 경로 순서
+    size_t count;
+    unsigned long long errors;
+    unsigned long long cached_dirs;   // 캐시로 처리한 디렉토리 수
+    unsigned long long scanned_dirs;  // 실제로 읽은 디렉토리 수
+    char error[MAX_PATH_SIZE * 2];    // 첫 번째 오류 메시지
+};
+
+// 루트를 열 수 없으면 -1 (errno 설정, count = 0). 하위 항목을 읽지 못해도 -1이지만
+// 그때는 읽은 만큼의 결과(count > 0)와 errors/error가 남아 있음 (합계는 모자란 값).
+// 어느 경우든 du_result_free로 정리
+int du_scan(const char *path, const struct du_options *opts, struct du_result *out);
+void du_result_free(struct du_result *result);
+void du_cache_clear(void);
+
+// "1.5K", "23M" 같은 사람이 읽기 쉬운 크기 (buf는 16바이트 이상)
+void du_format_size(unsigned long long bytes, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DU_H
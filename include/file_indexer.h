@@ -0,0 +1,68 @@
+#ifndef FILE_INDEXER_H
+#define FILE_INDEXER_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class QSocketNotifier;
+struct file_index;
+
+// BASE_DIR 아래 파일 이름의 트라이그램 색인을 백그라운드에서 만들고 inotify로 최신 상태를 유지.
+// 색인 갱신(크롤링, 이벤트 반영)은 한 스레드에서 순서대로 처리하고, 검색은 별도 스레드에서
+// 결과를 묶음 단위로 resultsReady로 흘려보냄
+class FileIndexer : public QObject {
+    Q_OBJECT
+public:
+    static const int RESULT_BATCH = 256;       // 한 번에 보내는 결과 수
+    static const int BATCH_INTERVAL_MS = 30;   // 묶음이 덜 찼어도 이 간격마다 보냄
+
+    explicit FileIndexer(const QString &root, QObject *parent = nullptr);
+    ~FileIndexer() override;
+
+    void start();
+    // 이전 검색은 취소됨. 반환한 번호로 결과 시그널을 구분
+    qulonglong search(const QString &pattern, const QString &scope, int limit);
+    void cancelSearch();
+
+    bool isIndexing() const { return indexing.load(); }
+    bool watchLimitReached() const { return watchesExhausted.load(); }
+    qulonglong indexedCount() const;
+
+signals:
+    void resultsReady(qulonglong generation, const QStringList &paths);
+    void searchFinished(qulonglong generation, qulonglong total, bool truncated, double elapsedMs);
+    void indexStateChanged();
+
+private:
+    struct Event {
+        int wd;
+        uint32_t mask;
+        QByteArray name;
+    };
+
+    void readEvents();
+    void applyEvents(const std::vector<Event> &events);   // 갱신 스레드에서 실행
+    void crawl(uint32_t dir);                             // 갱신 스레드에서 실행
+    void rebuild();                                       // 갱신 스레드에서 실행
+    static int addWatch(void *ctx, uint32_t id, const char *path);
+
+    struct file_index *index = nullptr;
+    int inotifyFd = -1;
+    QSocketNotifier *notifier = nullptr;
+    QHash<int, uint32_t> watches;           // 감시 번호 -> 디렉토리 id (갱신 스레드 전용)
+
+    QThreadPool writer;
+    QThreadPool searcher;
+    std::atomic<qulonglong> searchGeneration{0};
+    std::atomic<bool> indexing{false};
+    std::atomic<bool> watchesExhausted{false};
+    int stopping = 0;                       // 소멸 중이면 1 (크롤링 중단)
+};
+
+#endif // FILE_INDEXER_H
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef FILEINDEX_H
+#define FILEINDEX_H
+
+#include "config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 파일 이름 트라이그램 색인. 각 항목은 (부모 id, 이름)으로 저장하고 전체 경로는 필요할 때 만듦.
+// 이름의 소문자 트라이그램마다 id 목록(오름차순)을 두어, 부분 문자열/글롭 검색 때
+// 가장 짧은 목록들의 교집합만 실제 이름과 비교함. 3글자 미만 검색어는 전체를 순회.
+// 모든 함수는 내부 rwlock으로 보호되므로 검색과 갱신을 서로 다른 스레드에서 호출해도 됨
+#define FILE_INDEX_NONE   UINT32_MAX
+#define FILE_INDEX_ROOT   0u
+
+struct file_index;
+
+struct file_index_stats {
+    size_t live;        // 살아 있는 항목 수 (루트 제외)
+    size_t dead;        // 삭제 표시만 된 항목 수 (file_index_clear로 정리)
+    size_t trigrams;    // 서로 다른 트라이그램 수
+    size_t memory;      // 대략적인 메모리 사용량 (바이트)
+};
+
+// 디렉토리를 읽기 직전에 호출 (inotify 감시 추가용). 0이 아니면 그 디렉토리는 건너뜀
+typedef int (*file_index_dir_fn)(void *ctx, uint32_t id, const char *path);
+// 검색 결과 하나. 0이 아니면 검색 중단
+typedef int (*file_index_hit_fn)(void *ctx, uint32_t id, const char *path, int is_dir);
+
+struct file_index *file_index_create(const char *root);
+void file_index_free(struct file_index *idx);
+void file_index_clear(struct file_index *idx);   // 루트만 남기고 모두 제거
+
+// 이미 있으면 기존 id 반환. 실패 시 FILE_INDEX_NONE
+uint32_t file_index_add(struct file_index *idx, uint32_t parent, const char *name, int is_dir);
+// 디렉토리면 하위 항목도 함께 사라진 것으로 취급
+void file_index_remove(struct file_index *idx, uint32_t parent, const char *name);
+uint32_t file_index_lookup(struct file_index *idx, uint32_t parent, const char *name);
+uint32_t file_index_lookup_path(struct file_index *idx, const char *path);
+int file_index_is_live(struct file_index *idx, uint32_t id);
+int file_index_path(struct file_index *idx, uint32_t id, char *buf, size_t size);
+void file_index_get_stats(struct file_index *idx, struct file_index_stats *out);
+
+// dir 아래를 모두 읽어서 추가. cancel이 0이 아니게 되면 -1 (errno = ECANCELED)
+int file_index_crawl(struct file_index *idx, uint32_t dir, file_index_dir_fn on_dir,
+                     void *ctx, const int *cancel);
+
+// pattern에 *, ?, [ 가 있으면 이름 전체에 대한 글롭, 없으면 부분 문자열 (대소문자 무시).
+// scope 디렉토리 아래의 항목만 내보내고, limit(0이면 무제한)개에서 멈춤. 내보낸 개수를 반환
+size_t file_index_query(struct file_index *idx, const char *pattern, uint32_t scope,
+                        size_t limit, file_index_hit_fn fn, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FILEINDEX_H
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef GREP_H
+#define GREP_H
+
+#include "config.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 병렬 내용 검색. 호출한 스레드가 트리를 훑어 파일을 큐에 넣고 워커들이 나눠서 검색함.
+// 작은 파일은 한 번에 read, 큰 파일은 mmap. 고정 문자열은 드문 바이트를 기준으로
+// memchr(SSE2)로 후보를 찾고, 긴 패턴은 Boyer-Moore-Horspool, 정규식은 POSIX regex 사용
+#define GREP_MAX_WORKERS        16
+#define GREP_DEFAULT_MAX_SIZE   (64ULL << 20)   // 이보다 큰 파일은 건너뜀
+#define GREP_BINARY_PROBE       8192            // 앞부분에 NUL이 있으면 바이너리로 보고 건너뜀
+
+// grep_options.flags
+#define GREP_IGNORE_CASE    0x01
+#define GREP_REGEX          0x02   // 확장 정규식 (REG_EXTENDED)
+#define GREP_BINARY         0x04   // 바이너리 파일도 검색
+
+struct grep_options {
+    int flags;
+    int workers;                        // 0 이하면 CPU 수
+    unsigned long long max_file_size;   // 0이면 GREP_DEFAULT_MAX_SIZE
+    unsigned long long max_matches;     // 0이면 무제한
+};
+
+struct grep_stats {
+    unsigned long long files_searched;
+    unsigned long long files_matched;
+    unsigned long long matches;
+    unsigned long long bytes_searched;
+    unsigned long long skipped_binary;
+    unsigned long long skipped_large;
+    unsigned long long errors;
+    int truncated;                      // max_matches에 걸려 멈춤
+    char error[MAX_PATH_SIZE * 2];      // 첫 번째 오류 메시지 (정규식 오류 포함)
+};
+
+// 일치한 줄 하나 (text는 개행 제외, NUL 종료 아님). 한 파일의 결과는 연속으로 전달되며
+// 여러 워커에서 호출되지만 동시에 호출되지는 않음. 0이 아니면 검색 중단
+typedef int (*grep_hit_fn)(void *ctx, const char *path, unsigned long line,
+                           const char *text, size_t len);
+
+// paths의 각 파일/디렉토리(재귀)를 검색. 정규식 오류나 취소면 -1
+// (errno = EINVAL/ECANCELED, 정규식 오류 메시지는 stats->error)
+int grep_run(const char *const *paths, size_t n, const char *pattern,
+             const struct grep_options *opts, grep_hit_fn fn, void *ctx,
+             const int *cancel, struct grep_stats *stats);
+
+// 파이프 같은 스트림 fd를 끝까지 읽으며 줄 단위로 검색 (워커 없이 호출한 스레드에서).
+// 결과의 path에는 label이 들어감. max_matches에 걸리면 남은 입력은 읽지 않음
+int grep_fd(int fd, const char *label, const char *pattern,
+            const struct grep_options *opts, grep_hit_fn fn, void *ctx,
+            const int *cancel, struct grep_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GREP_H
@@ -0,0 +1,62 @@
+#ifndef GREP_PANEL_H
+#define GREP_PANEL_H
+
+#include <QWidget>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <memory>
+
+class QCheckBox;
+class QLabel;
+class QLineEdit;
+class QListWidget;
+class QPushButton;
+
+// 현재 디렉토리 아래 파일 내용을 grep 엔진으로 검색하는 도킹 패널.
+// 검색은 워커 스레드에서 돌고, 결과는 묶음 단위로 목록에 덧붙여짐
+class GrepPanel : public QWidget {
+    Q_OBJECT
+public:
+    static const int MAX_RESULTS = 20000;      // 목록에 넣는 최대 줄 수
+    static const int MAX_LINE_CHARS = 300;     // 한 줄에서 보여줄 최대 글자 수
+    static const int RESULT_BATCH = 256;
+    static const int BATCH_INTERVAL_MS = 50;
+
+    explicit GrepPanel(QWidget *parent = nullptr);
+    ~GrepPanel() override;
+
+    struct Hit {
+        QString path;
+        qulonglong line;      // 1부터
+        QString text;
+    };
+
+    void setDirectory(const QString &path);
+
+signals:
+    void openRequested(const QString &path, qulonglong line);
+
+private:
+    void startSearch();
+    void stopSearch();
+    void appendHits(qulonglong generation, const QVector<Hit> &hits);
+    void finishSearch(qulonglong generation, int rc, const QString &summary);
+
+    QLabel *dirLabel;
+    QLineEdit *patternEdit;
+    QCheckBox *ignoreCase;
+    QCheckBox *regex;
+    QPushButton *searchButton;
+    QPushButton *stopButton;
+    QListWidget *results;
+    QLabel *statusLabel;
+
+    QString directory;
+    QString searchRoot;                        // 진행 중인 검색의 시작 디렉토리 (상대 경로 표시용)
+    QThreadPool pool;
+    qulonglong generation = 0;
+    std::shared_ptr<int> cancelFlag;           // 진행 중인 검색의 취소 플래그
+};
+
+#endif // GREP_PANEL_H
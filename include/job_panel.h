@@ -0,0 +1,64 @@
+#ifndef JOB_PANEL_H
+#define JOB_PANEL_H
+
+#include <QWidget>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+class QLabel;
+class QPushButton;
+class QStackedWidget;
+class QTableWidget;
+
+// 외부 프로그램을 posix_spawn으로 띄워 여러 개를 동시에 돌리는 작업 패널.
+// stdout/stderr 파이프는 QSocketNotifier로 이벤트 루프에서 읽어 작업마다 콘솔에 덧붙이고,
+// 종료는 타이머에서 기다리지 않고 거둬들이므로 UI가 멈추지 않음
+class JobPanel : public QWidget {
+    Q_OBJECT
+public:
+    static const int MAX_CONSOLE_LINES = 10000;   // 콘솔마다 남겨 두는 최대 줄 수
+    static const int READ_CHUNK = 64 * 1024;
+    static const int MAX_READ_PER_EVENT = 1024 * 1024;   // 한 번 깨어날 때 읽는 최대 바이트
+    static const int REFRESH_INTERVAL_MS = 500;   // 종료 확인과 실행 시간 갱신 간격
+
+    enum Column { Command, Pid, Status, Runtime, ExitCode, ColumnCount };
+
+    explicit JobPanel(QWidget *parent = nullptr);
+    ~JobPanel() override;
+
+    // 띄우지 못하면 false와 error에 이유. 성공하면 새 작업이 선택됨
+    bool start(const QString &program, const QStringList &arguments, const QString &directory,
+               QString *error);
+    int runningCount() const;
+
+signals:
+    void jobFinished(const QString &command, const QString &result);
+
+private slots:
+    // Qt 5.15부터 activated가 두 가지로 겹쳐 있어 이름으로 연결함
+    void readOutput(int fd);
+
+private:
+    struct Job;
+
+    void drain(Job *job, bool error);
+    void closeStream(Job *job, bool error);
+    void reap();
+    void updateRow(int row);
+    void terminateSelected();
+    void clearFinished();
+    int selectedRow() const;
+
+    QTableWidget *jobTable;
+    QStackedWidget *consoles;
+    QPushButton *stopButton;
+    QPushButton *clearButton;
+    QLabel *statusLabel;
+    QTimer refreshTimer;
+    std::vector<std::unique_ptr<Job>> jobs;      // 표의 행 순서와 같음
+};
+
+#endif // JOB_PANEL_H
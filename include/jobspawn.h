@@ -0,0 +1,38 @@
+#pragma once
+#ifndef JOBSPAWN_H
+#define JOBSPAWN_H
+
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// posix_spawn으로 외부 프로그램을 띄우고 stdout/stderr를 파이프로 받음.
+// 호출한 스레드는 기다리지 않으며, 종료는 job_poll로 확인하고 거둬들임.
+// 자식은 자신의 프로세스 그룹을 만들므로 kill(-pid, sig)로 자손까지 한 번에 보낼 수 있음
+struct job_process {
+    pid_t pid;
+    int out_fd;     // 자식 stdout의 읽기 끝 (비차단, close-on-exec)
+    int err_fd;     // 자식 stderr의 읽기 끝
+};
+
+// program에 '/'가 없으면 PATH에서 찾음. cwd가 NULL이 아니면 그 디렉토리에서 실행하고,
+// stdin은 /dev/null. 실패하면 -1 (errno 설정, 만든 fd는 모두 닫음)
+int job_spawn(const char *program, char *const argv[], const char *cwd, struct job_process *job);
+
+// 자식의 stdin/stdout/stderr로 쓸 fd를 직접 지정해서 띄움 (쉘 파이프라인용).
+// fds[i]가 -1이면 그대로 물려받고 JOB_FD_NULL이면 /dev/null. new_group이 0이면 호출한 쪽의
+// 프로세스 그룹에 남아 터미널의 Ctrl-C를 함께 받음. 실패하면 -1 (errno 설정, fds는 닫지 않음)
+#define JOB_FD_NULL (-2)
+int job_spawn_fds(const char *program, char *const argv[], const char *cwd, const int fds[3],
+                  int new_group, pid_t *pid);
+
+// 기다리지 않고 종료 확인. 끝났으면 1 (*status에 waitpid 상태), 아직이면 0, 오류면 -1
+int job_poll(pid_t pid, int *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOBSPAWN_H
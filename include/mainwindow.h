@@ -44,6 +44,9 @@ class MainWindowUI;
 class MainWindowFileActions;
 class MainWindowProcessActions;
 class MainWindowTestActions;
+class DirStatsTracker;
+class GrepPanel;
+class JobPanel;
 
 class MainWindow : public QMainWindow
 {
@@ -79,6 +82,7 @@ public slots:
     void showContextMenu(const QPoint &pos);
     void showFileDetails(const QString &fileName);
     void handleRmdir();
+    void handleDu();
     void handleMmapTest();
     void handleExecuteProgram();
 
@@ -90,6 +94,11 @@ private:
     std::string currentPath;
     QModelIndexList selectedIndexes;
     bool moveOperation = false;  // 이동 작업 여부를 나타내는 플래그
+    DirStatsTracker *dirStats = nullptr;  // 상태바용 현재 디렉토리 통계 (증분 갱신)
+    GrepPanel *grepPanel = nullptr;       // 현재 디렉토리 아래 내용 검색
+    QDockWidget *grepDock = nullptr;
+    JobPanel *jobPanel = nullptr;         // 실행한 외부 프로그램과 출력
+    QDockWidget *jobDock = nullptr;
 
     // Actions
     QAction *newFolderAction;
@@ -99,6 +108,8 @@ private:
     QAction *renameAction;
     QAction *chmodAction;
     QAction *lsAction;
+    QAction *duAction;
+    QAction *grepAction;
     QAction *mkdirAction;
     QAction *rmAction;
     QAction *cpAction;
@@ -110,6 +121,7 @@ private:
     QAction *rmdirAction;
     QAction *mmapTestAction;
     QAction *execProgramAction;
+    QAction *jobsAction;
     QAction *backAction;
     QStack<QString> directoryHistory;
 }; 
@@ -13,6 +13,7 @@ void MainWindow::handleRename();
 void MainWindow::handleLn();
 void MainWindow::handleCat();
 void MainWindow::handleRmdir();
+void MainWindow::handleDu();
 
 // 프로세스 관련 액션 처리
 void MainWindow::handlePs();
@@ -2,6 +2,7 @@
 #define MAINWINDOW_FILE_ACTIONS_H
 
 #include <QMainWindow>
+#include <QAbstractItemModel>
 #include <QObject>
 
 class MainWindow;  // Forward declaration
@@ -20,7 +21,9 @@ public:
     static void handleRename(MainWindow* window);
     static void handleLn(MainWindow* window);
     static void handleCat(MainWindow* window);
+    static void openFileViewer(MainWindow* window, const QString &filePath, qulonglong line = 0);
     static void handleRmdir(MainWindow* window);
+    static void handleDu(MainWindow* window);
 
     // 파일 유틸리티 함수들
     static void createNewFolder(MainWindow* window);
@@ -34,8 +37,7 @@ public:
     static void showFileDetails(MainWindow* window, const QString &fileName);
 
 private:
-    static void copyDirectory(const QString &sourcePath, const QString &destPath);
-    static bool removeDirectory(const QString &dirPath);
+    static void startRemoveJob(MainWindow* window, const QModelIndexList &selected);
 };
 
 #endif // MAINWINDOW_FILE_ACTIONS_H 
\ No newline at end of file
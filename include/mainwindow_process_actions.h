@@ -11,7 +11,6 @@ public:
     explicit MainWindowProcessActions(QObject *parent = nullptr);
     static void handlePs(MainWindow* window);
     static void handleKill(MainWindow* window, const QString &pid);
-    static void refreshProcessList(MainWindow* window, QTableWidget *processTable);
 };
 
 #endif // MAINWINDOW_PROCESS_ACTIONS_H 
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef MAPGUARD_H
+#define MAPGUARD_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 파일을 mmap한 뒤 다른 프로세스가 파일을 줄이면(로그 회전, truncate) 잘린 페이지에
+// 접근하는 순간 SIGBUS로 프로세스 전체가 죽음. 등록한 매핑 안에서 난 SIGBUS는
+// 그 페이지부터 매핑 끝까지를 0으로 찬 익명 페이지로 덮고 돌아가므로, 읽던 코드는
+// 0을 읽고 계속 진행함. 호출한 쪽은 map_guard_remove의 결과나 fstat으로 파일이 줄었음을
+// 알아채고 다시 매핑하면 됨
+#define MAP_GUARD_SLOTS     64      // 동시에 보호할 수 있는 매핑 수
+
+// 매핑을 보호 목록에 넣음. 슬롯 번호, 빈 슬롯이 없으면 -1 (ENOSPC)
+int map_guard_add(const void *addr, size_t len);
+// 보호를 풂 (munmap 전에 부름). 등록 뒤 잘린 페이지를 덮은 적이 있으면 1, 아니면 0
+int map_guard_remove(int slot);
+// 잘린 페이지를 덮은 적이 있으면 1 (표시는 지움). 보호는 유지됨
+int map_guard_take_fault(int slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAPGUARD_H
@@ -0,0 +1,50 @@
+#ifndef MAPPED_TEXT_VIEW_H
+#define MAPPED_TEXT_VIEW_H
+
+#include <QAbstractScrollArea>
+#include <QString>
+#include "mapview.h"
+
+// mmap한 파일에서 화면에 보이는 줄만 그리는 읽기 전용 뷰.
+// 세로 스크롤바는 줄 번호가 아니라 바이트 오프셋을 나타내므로 줄 색인 없이 바로 열림
+class MappedTextView : public QAbstractScrollArea {
+    Q_OBJECT
+public:
+    explicit MappedTextView(QWidget *parent = nullptr);
+    ~MappedTextView() override;
+
+    bool openFile(const QString &path, QString *error = nullptr);
+    void scrollToOffset(qulonglong offset);
+    void scrollToLine(qulonglong line);  // 0부터 시작
+
+    qulonglong fileSize() const { return file.size; }
+    qulonglong topOffset() const { return top; }
+
+signals:
+    void positionChanged(qulonglong offset, qulonglong size, qlonglong line);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    void scrollLines(int delta);
+    void setTop(size_t offset);
+    void syncScrollBars();
+    void updateLastTop();
+    void refreshFile();
+    int visibleLines() const;
+    QString lineText(size_t offset) const;
+
+    struct mapped_file file;
+    bool opened = false;
+    size_t top = 0;           // 화면 첫 줄의 시작 오프셋
+    size_t lastTop = 0;       // 마지막 줄이 화면 아래에 닿는 top (이보다 아래로는 스크롤 안 함)
+    bool syncing = false;     // 스크롤바를 코드에서 맞추는 중이면 valueChanged 무시
+    qulonglong scale = 1;     // 스크롤바 값 하나가 나타내는 바이트 수 (int 범위 맞춤)
+    int maxLineWidth = 0;     // 지금까지 그린 줄 중 가장 넓은 폭 (가로 스크롤 범위)
+};
+
+#endif // MAPPED_TEXT_VIEW_H
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef MAPVIEW_H
+#define MAPVIEW_H
+
+#include "config.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 줄 색인은 이 줄 수마다 시작 오프셋 하나만 기록 (희소 색인)
+#define MAPPED_LINE_STRIDE  1024
+
+// mmap으로 연 읽기 전용 파일과, 필요한 만큼만 만들어 가는 줄 색인.
+// 파일 크기와 상관없이 열기는 상수 시간이고, 화면에 그릴 부분만 페이지 폴트로 읽힘.
+// 연 뒤 파일이 잘려도 SIGBUS로 죽지 않도록 매핑을 map_guard에 등록해 둠
+struct mapped_file {
+    int fd;
+    const char *data;         // 빈 파일이면 NULL
+    size_t size;              // 매핑한 크기 (mapped_file_refresh 전까지는 연 시점의 크기)
+    int guard;                // map_guard 슬롯 (-1이면 보호 없음)
+
+    size_t *checkpoints;      // checkpoints[k] = (k * STRIDE)번째 줄의 시작 오프셋
+    size_t ncheckpoints;
+    size_t checkpoints_capacity;
+    size_t scanned_lines;     // 색인이 확인한 줄 수
+    size_t scanned_offset;    // scanned_lines번째 줄의 시작 오프셋
+    int complete;             // 파일 끝까지 색인했으면 1
+    int capped;               // 메모리가 부족해 체크포인트를 더 기록하지 않음
+};
+
+int mapped_file_open(struct mapped_file *mf, const char *path);
+void mapped_file_close(struct mapped_file *mf);
+// 파일 크기가 바뀌었거나 잘린 페이지를 읽은 적이 있으면 다시 매핑하고 1 (data/size가 바뀜,
+// 줄었으면 색인도 처음부터), 그대로면 0, 오류면 -1. 로그 회전 등에 대비해 그리기 전에 부름
+int mapped_file_refresh(struct mapped_file *mf);
+
+// 오프셋 기준 줄 이동 (색인 없이 memchr/memrchr로 주변만 봄)
+size_t mapped_file_line_start(const struct mapped_file *mf, size_t offset);
+size_t mapped_file_next_line(const struct mapped_file *mf, size_t offset);
+size_t mapped_file_prev_line(const struct mapped_file *mf, size_t offset);
+size_t mapped_file_line_length(const struct mapped_file *mf, size_t offset);  // '\n' 제외
+
+// 줄 번호(0부터) -> 오프셋. 필요한 곳까지만 색인을 늘림. 범위를 넘으면 파일 크기
+size_t mapped_file_line_offset(struct mapped_file *mf, size_t line);
+// 오프셋 -> 줄 번호. 색인이 아직 그 위치까지 닿지 않았으면 -1 (색인을 늘리지 않음)
+int mapped_file_line_at(const struct mapped_file *mf, size_t offset, size_t *line);
+// 전체 줄 수. 파일 끝까지 색인을 만듦
+size_t mapped_file_line_count(struct mapped_file *mf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAPVIEW_H
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef PIDSIG_H
+#define PIDSIG_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <regex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// pidfd로 시그널 보내기. 목록을 읽은 뒤 프로세스가 끝나고 pid가 재사용돼도
+// pidfd를 연 다음 /proc/<pid>/stat의 시작 시각을 다시 비교하므로 다른 프로세스에 보내지 않음.
+// pidfd는 프로세스가 끝나면 읽기 가능해지므로 poll/이벤트 루프로 종료를 확인할 수 있음.
+// pidfd를 지원하지 않는 커널(5.3 미만)에서는 kill()과 /proc/<pid>/stat 확인으로 대신함
+#define PID_TARGET_PENDING  0   // 아직 열지 않음
+#define PID_TARGET_ALIVE    1   // 열었음 (시그널을 보냈으면 종료 대기 중)
+#define PID_TARGET_EXITED   2
+#define PID_TARGET_FAILED   3   // 열기/보내기 실패 (error에 errno)
+
+struct pid_target {
+    pid_t pid;
+    unsigned long long starttime;   // 목록을 읽을 때의 시작 시각 (0이면 확인하지 않음)
+    int pidfd;                      // -1이면 pidfd 없이 kill()로 보냄
+    int state;
+    int error;
+};
+
+void pid_target_init(struct pid_target *t, pid_t pid, unsigned long long starttime);
+
+// pidfd를 열고 시작 시각을 확인. 이미 끝났거나 다른 프로세스면 -1 (errno = ESRCH)
+int pid_target_open(struct pid_target *t);
+// 열려 있지 않으면 먼저 엶. 실패하면 -1 (t->state = FAILED, errno 설정)
+int pid_target_signal(struct pid_target *t, int sig);
+// 기다리지 않고 종료 여부만 확인 (끝났으면 1, 상태를 EXITED로 바꿈)
+int pid_target_poll(struct pid_target *t);
+void pid_target_close(struct pid_target *t);
+
+// 모든 대상에 시그널을 보내고 보낸 수를 반환 (실패한 대상은 FAILED)
+size_t pid_batch_signal(struct pid_target *targets, size_t n, int sig);
+// ALIVE인 대상이 모두 끝나거나 timeout_ms가 지날 때까지 기다림 (음수면 무한).
+// 아직 살아 있는 수를 반환
+size_t pid_batch_wait(struct pid_target *targets, size_t n, int timeout_ms);
+void pid_batch_close(struct pid_target *targets, size_t n);
+
+// "9", "KILL", "SIGKILL", "sigterm" -> 시그널 번호. 모르면 -1
+int signal_parse(const char *text);
+// 시그널 번호 -> "TERM" 같은 이름 (모르면 NULL)
+const char *signal_name(int sig);
+
+// pgrep 형식 패턴 (확장 정규식)
+#define PROC_MATCH_FULL     0x01   // comm 대신 cmdline 전체와 비교 (-f)
+#define PROC_MATCH_EXACT    0x02   // 전체가 일치해야 함 (-x)
+#define PROC_MATCH_ICASE    0x04   // 대소문자 무시 (-i)
+
+struct proc_pattern {
+    regex_t re;
+    int flags;
+};
+
+// 실패하면 -1, err에 regerror 메시지
+int proc_pattern_compile(struct proc_pattern *p, const char *pattern, int flags,
+                         char *err, size_t errsize);
+// comm과 cmdline 중 flags에 맞는 쪽을 비교. cmdline이 NULL이면 comm만 사용
+int proc_pattern_match(const struct proc_pattern *p, const char *comm, const char *cmdline);
+void proc_pattern_free(struct proc_pattern *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PIDSIG_H
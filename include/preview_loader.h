@@ -0,0 +1,67 @@
+#ifndef PREVIEW_LOADER_H
+#define PREVIEW_LOADER_H
+
+#include <QObject>
+#include <QCache>
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+
+// 미리보기 캐시 키: 같은 파일이라도 수정되면 다른 키가 됨
+struct PreviewKey {
+    quint64 dev;
+    quint64 ino;
+    qint64 mtimeSec;
+    qint64 mtimeNsec;
+
+    bool operator==(const PreviewKey &other) const {
+        return dev == other.dev && ino == other.ino &&
+               mtimeSec == other.mtimeSec && mtimeNsec == other.mtimeNsec;
+    }
+};
+
+inline uint qHash(const PreviewKey &key, uint seed = 0)
+{
+    return ::qHash(key.ino, seed) ^ ::qHash(key.dev, seed) ^ ::qHash(key.mtimeNsec, seed);
+}
+
+// 미리보기 생성(stat, 파일 앞부분 읽기, 디렉토리 목록)을 워커 스레드에서 처리.
+// 새 요청이 오면 이전 요청은 세대 번호로 버려지고, 결과는 LRU 캐시에 남음
+class PreviewLoader : public QObject {
+    Q_OBJECT
+public:
+    static const int CACHE_ENTRIES = 256;
+    static const int PREVIEW_BYTES = 4096;
+    static const int MAX_DIR_ENTRIES = 1000;
+
+    explicit PreviewLoader(QObject *parent = nullptr);
+    ~PreviewLoader() override;
+
+    // 이전 요청은 모두 무효화됨. 결과는 previewReady로 전달
+    void request(const QString &path);
+    void cancel();
+    qulonglong currentGeneration() const { return generation.load(); }
+
+signals:
+    void previewReady(qulonglong generation, const QString &text, qint64 size,
+                      const QDateTime &modified);
+
+private:
+    struct Entry {
+        QString text;
+        qint64 size;
+        QDateTime modified;
+    };
+
+    void run(qulonglong gen, const QString &path);
+    bool stale(qulonglong gen) const { return gen != generation.load(); }
+
+    QThreadPool pool;
+    std::atomic<qulonglong> generation{0};
+    QMutex cacheLock;
+    QCache<PreviewKey, Entry> cache;
+};
+
+#endif // PREVIEW_LOADER_H
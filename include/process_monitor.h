@@ -0,0 +1,80 @@
+#ifndef PROCESS_MONITOR_H
+#define PROCESS_MONITOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+#include "procscan.h"
+
+// top처럼 프로세스 목록을 주기적으로 워커 스레드에서 다시 읽음.
+// 이전 표본의 utime+stime과 비교해 CPU%를 계산하고, cmdline은 새로 나타난 프로세스만 읽음
+class ProcessMonitor : public QObject {
+    Q_OBJECT
+public:
+    static const int DEFAULT_INTERVAL_MS = 1000;
+
+    // 스캔 한 번의 결과. 열 단위로 저장하므로 정렬/필터는 필요한 배열 하나만 훑고,
+    // 행 하나는 cmdline을 빼면 60바이트 남짓 (행 i의 값은 각 배열의 i번째)
+    struct Sample {
+        QVector<pid_t> pid;
+        QVector<pid_t> ppid;
+        QVector<uid_t> uid;
+        QVector<char> state;
+        QVector<int> tty;
+        QVector<float> cpu;                // 직전 표본 이후 CPU 사용률 (코어 하나가 100%)
+        QVector<quint32> rss;              // KB 단위
+        QVector<quint64> vsz;              // KB 단위 (sanitizer 등은 수 TB까지 잡음)
+        QVector<quint64> cpuTicks;         // utime + stime
+        QVector<quint64> starttime;        // pid 재사용 구분
+        QVector<quint32> commandOffset;    // commands 안에서 NUL 종료 cmdline의 위치
+        QByteArray commands;
+
+        struct proc_scan_metrics metrics;
+        double totalCpu = 0;               // 모든 프로세스의 CPU% 합
+        double intervalMs = 0;             // 직전 표본과의 간격 (첫 표본이면 0)
+
+        int size() const { return pid.size(); }
+        const char *command(int row) const { return commands.constData() + commandOffset[row]; }
+    };
+
+    explicit ProcessMonitor(QObject *parent = nullptr);
+    ~ProcessMonitor() override;
+
+    void start(int intervalMs = DEFAULT_INTERVAL_MS);
+    void stop();
+    void refresh();               // 바로 한 번 스캔 (진행 중이면 무시)
+    bool isRunning() const { return timer.isActive(); }
+
+    std::shared_ptr<const Sample> latest() const { return current; }
+
+signals:
+    void sampleReady();
+    void scanFailed(const QString &message);
+
+private:
+    struct History {
+        unsigned long long starttime;   // pid 재사용 구분
+        unsigned long long ticks;       // utime + stime
+        QByteArray cmdline;
+    };
+
+    void scan();                  // 워커 스레드에서 실행
+
+    QTimer timer;
+    QThreadPool pool;
+    bool busy = false;            // 스캔이 진행 중이면 다음 틱은 건너뜀
+    std::shared_ptr<const Sample> current;
+
+    // 아래는 워커 스레드 전용 (풀의 스레드가 하나라 순서대로 접근)
+    struct proc_scanner *scanner = nullptr;
+    struct proc_info *buffer = nullptr;
+    size_t capacity = 0;
+    QHash<pid_t, History> history;
+    qint64 lastScanNs = 0;
+};
+
+#endif // PROCESS_MONITOR_H
@@ -0,0 +1,103 @@
+#ifndef PROCESS_TABLE_MODEL_H
+#define PROCESS_TABLE_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "process_monitor.h"
+#include "proctree.h"
+
+// ProcessMonitor 표본(열 단위 배열)을 그대로 보여주는 표 모델. 셀마다 객체를 만들지 않고
+// data()에서 배열 값을 바로 꺼내며, 정렬은 표시 순서(order) 배열만 열 값으로 다시 정렬함.
+// 새 표본이 와도 pid와 시작 시각으로 선택/현재 항목을 옮겨 주므로 스크롤과 선택이 유지됨
+class ProcessTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { Pid, User, Cpu, Rss, State, Tty, Time, Command, ColumnCount };
+
+    explicit ProcessTableModel(QObject *parent = nullptr);
+
+    void setSample(std::shared_ptr<const ProcessMonitor::Sample> sample);
+    const ProcessMonitor::Sample *sample() const { return current.get(); }
+    int sampleRow(int row) const { return order[row]; }      // 표시 행 -> 표본 행
+    pid_t pidAt(int row) const { return current->pid[order[row]]; }
+    QString userName(uid_t uid) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder direction = Qt::AscendingOrder) override;
+
+private:
+    void relayout(std::shared_ptr<const ProcessMonitor::Sample> next);
+    void sortRows();
+
+    std::shared_ptr<const ProcessMonitor::Sample> current;
+    QVector<int> order;                       // 표시 순서 (표본 행 번호)
+    int sortColumn = Cpu;
+    Qt::SortOrder sortOrder = Qt::DescendingOrder;
+    mutable QHash<uid_t, QString> users;      // uid -> 사용자 이름 캐시
+};
+
+// pid/사용자/상태/최소 RSS/명령 부분 문자열로 거르는 프록시. 배열을 직접 읽어서 거르고,
+// 정렬은 원본 모델에 넘겨서 프록시는 원본 순서를 그대로 따름
+class ProcessFilterProxy : public QSortFilterProxyModel {
+    Q_OBJECT
+public:
+    explicit ProcessFilterProxy(QObject *parent = nullptr);
+
+    void setPidFilter(pid_t pid);                 // 0이면 모두
+    void setUserFilter(const QString &user);      // 빈 문자열이면 모두
+    void setStateFilter(char state);              // 0이면 모두
+    void setMinRss(quint32 kb);
+    void setCommandFilter(const QString &text);   // 대소문자 무시 부분 문자열
+
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    pid_t pid = 0;
+    bool userSet = false;
+    uid_t uid = 0;                                // 사용자 필터는 설정할 때 uid로 바꿔 둠
+    char state = 0;
+    quint32 minRss = 0;
+    QByteArray command;                           // 명령 검색어 (strcasestr로 비교)
+};
+
+// 같은 표본을 PPID 연결로 만든 트리로 보여주는 모델. 트리는 표본마다 O(n)에 다시 만들고
+// CPU%/RSS/VSZ는 하위 트리 합계로 표시. 펼침/선택 상태는 pid와 시작 시각으로 옮겨 유지됨
+class ProcessTreeModel : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    enum Column { Command, Pid, Count, Cpu, Rss, Vsz, ColumnCount };
+
+    explicit ProcessTreeModel(QObject *parent = nullptr);
+    ~ProcessTreeModel() override;
+
+    void setSample(std::shared_ptr<const ProcessMonitor::Sample> sample);
+    const ProcessMonitor::Sample *sample() const { return current.get(); }
+    int sampleRow(const QModelIndex &index) const { return static_cast<int>(index.internalId()); }
+    QVector<int> subtreeRows(const QModelIndex &index) const;   // 전위 순서, 자신 포함
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    std::shared_ptr<const ProcessMonitor::Sample> current;
+    struct proc_tree tree = {};
+    QVector<double> cpuSum;
+    QVector<double> rssSum;                   // KB
+    QVector<double> vszSum;                   // KB
+};
+
+#endif // PROCESS_TABLE_MODEL_H
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef PROCSCAN_H
+#define PROCSCAN_H
+
+#include "config.h"
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// /proc 스캐너. 열어 둔 /proc 디렉토리 fd 기준으로 openat하고, 프로세스마다
+// stat 한 번(소유자는 같은 fd의 fstat)과 필요하면 cmdline 한 번만 read로 읽음.
+// stat은 comm에 공백이나 ')'가 들어 있어도 되도록 마지막 ')' 뒤부터 직접 파싱
+#define PROC_COMM_SIZE  64
+
+// proc_scan flags
+#define PROC_SCAN_ALL       0x01   // 다른 사용자의 프로세스도 포함
+#define PROC_SCAN_CMDLINE   0x02   // cmdline도 읽음 (없으면 comm만)
+
+// 프로세스 정보를 위한 구조체
+struct proc_info {
+    pid_t pid;
+    pid_t ppid;
+    pid_t pgrp;
+    pid_t sid;
+    uid_t uid;
+    gid_t gid;
+    int tty_nr;                      // 제어 터미널 장치 번호 (없으면 0)
+    char state;
+    int nice;
+    int num_threads;
+    unsigned long long utime;        // 클럭 틱 단위
+    unsigned long long stime;
+    unsigned long long starttime;    // 부팅 후 시작 시각 (클럭 틱)
+    unsigned long vsz;               // KB 단위
+    unsigned long rss;               // KB 단위
+    char comm[PROC_COMM_SIZE];
+    char cmdline[MAX_CMD_SIZE];      // 인자는 공백으로 구분, 커널 스레드는 [comm]
+                                     // (PROC_SCAN_CMDLINE이 없으면 comm)
+};
+
+// 마지막 스캔의 측정값
+struct proc_scan_metrics {
+    unsigned long entries;           // 읽은 /proc 디렉토리 항목 수
+    unsigned long procs;             // 결과에 넣은 프로세스 수
+    unsigned long filtered;          // 소유자가 달라 뺀 프로세스 수
+    unsigned long vanished;          // 읽는 도중 종료된 프로세스 수
+    unsigned long syscalls;          // open/read/fstat/close 호출 수 (readdir 제외)
+    unsigned long long bytes_read;
+    double elapsed_ms;
+};
+
+struct proc_scanner;
+
+// 실패하면 NULL (errno 설정). 한 스캐너를 여러 스레드에서 동시에 쓰면 안 됨
+struct proc_scanner *proc_scanner_create(void);
+void proc_scanner_free(struct proc_scanner *s);
+
+// 현재 프로세스 목록을 *procs에 채움. *procs/*capacity는 다음 스캔에서 다시 쓸 수 있도록
+// 필요할 때만 늘림 (처음엔 NULL/0, 다 쓰면 free). 실패하면 -1 (errno 설정)
+int proc_scan(struct proc_scanner *s, int flags, struct proc_info **procs, size_t *count,
+              size_t *capacity, struct proc_scan_metrics *metrics);
+
+// pid의 cmdline을 buf에 읽음 (인자는 공백으로 구분, 비어 있으면 [comm]).
+// 계속 갱신하는 쪽에서 새로 나타난 프로세스만 읽을 때 사용. 프로세스가 없으면 -1
+int proc_read_cmdline(struct proc_scanner *s, pid_t pid, const char *comm, char *buf, size_t size);
+
+// stat 한 줄을 파싱 (pid, comm, 그리고 proc_info의 stat 필드). 형식이 틀리면 -1
+int proc_parse_stat(const char *buf, size_t len, struct proc_info *p, unsigned long page_kb);
+
+// tty_nr을 "pts/3", "tty1" 같은 이름으로 (없으면 "?"). buf는 16바이트 이상
+void proc_format_tty(int tty_nr, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROCSCAN_H
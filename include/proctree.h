@@ -0,0 +1,43 @@
+#pragma once
+#ifndef PROCTREE_H
+#define PROCTREE_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// pid/ppid 배열로 프로세스 트리를 O(n)에 만듦. 노드 번호는 입력 배열의 인덱스.
+// 부모가 목록에 없으면(다른 사용자라 빠졌거나 이미 종료) 루트가 되고, 스냅샷 도중 pid가
+// 재사용돼 생긴 순환은 끊어서 루트로 만듦. 깊이 우선(전위) 순서에서 한 노드의 하위 트리는
+// preorder[preorder_pos[i] .. preorder_pos[i] + subtree_size[i]) 구간으로 연속됨
+#define PROC_TREE_NONE  ((size_t)-1)
+
+struct proc_tree {
+    size_t count;
+    size_t *parent;          // 부모 노드 (루트면 PROC_TREE_NONE)
+    size_t *child_start;     // 노드 i의 자식은 children[child_start[i] .. child_start[i + 1]) (count + 1개)
+    size_t *children;        // 자식 목록 (입력 순서 유지)
+    size_t *roots;
+    size_t nroots;
+    size_t *position;        // 부모의 자식 목록(루트면 roots) 안에서의 위치
+    size_t *preorder;        // 전위 순서
+    size_t *preorder_pos;    // preorder 안에서 노드의 위치
+    size_t *subtree_size;    // 자신을 포함한 하위 트리 노드 수
+    int *depth;              // 루트가 0
+};
+
+// 실패하면 -1 (errno = ENOMEM). 성공/실패 모두 proc_tree_free로 정리
+int proc_tree_build(const pid_t *pids, const pid_t *ppids, size_t n, struct proc_tree *tree);
+void proc_tree_free(struct proc_tree *tree);
+
+// 노드별 값을 하위 트리 합계로 (sums[i] = 하위 트리 values 합). values와 sums는 같아도 됨
+void proc_tree_sum(const struct proc_tree *tree, const double *values, double *sums);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROCTREE_H
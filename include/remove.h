@@ -0,0 +1,41 @@
+#pragma once
+#ifndef REMOVE_H
+#define REMOVE_H
+
+#include "config.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 디렉토리 fd 기준(openat/unlinkat)으로 트리를 지우는 병렬 삭제 엔진.
+// 경로 길이 제한이 없고, d_type으로 유형을 판별하며, 하위 디렉토리를 워커들이 나눠 처리함
+#define REMOVE_MAX_WORKERS  16
+
+struct remove_job;
+
+struct remove_progress {
+    unsigned long long files_removed;
+    unsigned long long dirs_removed;
+    unsigned long long errors;
+    int finished;
+};
+
+// paths의 각 항목(파일 또는 디렉토리 트리)을 삭제. workers가 0 이하면 CPU 수 사용
+struct remove_job *remove_job_start(const char *const *paths, size_t n, int workers);
+void remove_job_progress(struct remove_job *job, struct remove_progress *out);
+void remove_job_cancel(struct remove_job *job);
+int remove_job_wait(struct remove_job *job);            // 오류나 취소가 있었으면 -1
+const char *remove_job_error(struct remove_job *job);   // 첫 번째 오류 메시지, 없으면 NULL
+void remove_job_free(struct remove_job *job);           // remove_job_wait 후에 호출
+
+// 동기 삭제: 시작부터 대기까지 한 번에. error가 NULL이 아니면 첫 오류 메시지를 복사
+int remove_tree(const char *path, int workers, struct remove_progress *out,
+                char *error, size_t error_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REMOVE_H
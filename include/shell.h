@@ -0,0 +1,97 @@
+#pragma once
+#ifndef SHELL_H
+#define SHELL_H
+
+#include "config.h"
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 터미널 쉘: 한 줄을 `|`로 이은 단계들과 `<`, `>`, `>>` 리디렉션으로 나누어 실행.
+// 단계 사이는 pipe2로 바로 이어서 중간 파일 없이 흐르고, 외부 프로그램은 posix_spawn으로,
+// 결과를 출력하는 빌트인(ls, cat, ps 등)은 스레드에서 파이프/파일을 출력 스트림으로 삼아 실행
+#define SHELL_LINE_SIZE     1024
+#define SHELL_MAX_STAGES    16
+#define SHELL_MAX_ARGS      64
+
+#define SHELL_EXIT          (-1)    // exit/quit: 쉘 루프를 끝냄
+#define SHELL_NOT_BATCH     (-2)    // shell_batch_main: 배치로 실행할 인자가 없음
+#define SHELL_SYNTAX_ERROR  2       // 구문 오류의 종료 상태
+#define SHELL_NOT_FOUND     127     // 실행할 수 없는 명령의 종료 상태
+
+extern char current_dir[MAX_PATH_SIZE];
+extern volatile sig_atomic_t interrupted;
+
+struct shell_stage {
+    char *argv[SHELL_MAX_ARGS + 1];     // NULL로 끝남
+    int argc;
+};
+
+struct shell_pipeline {
+    struct shell_stage stages[SHELL_MAX_STAGES];
+    int count;
+    const char *input;                  // < 파일 (첫 단계의 stdin)
+    const char *output;                 // > / >> 파일 (마지막 단계의 stdout)
+    int append;
+    char text[SHELL_LINE_SIZE * 2];     // 따옴표를 벗긴 토큰들 (각각 NUL로 끝남)
+};
+
+typedef int (*shell_builtin_fn)(int argc, char *const argv[]);
+
+// 빌트인 flags
+#define SHELL_BUILTIN_STREAM    0x01    // 결과를 shell_output()으로 내므로 파이프라인/리디렉션 가능
+#define SHELL_BUILTIN_STDIN     0x02    // 파일 인자가 없으면 앞 단계(또는 <)의 입력을 읽음
+
+struct shell_builtin {
+    const char *name;
+    shell_builtin_fn fn;
+    int flags;
+};
+
+// 빌트인 표의 칸 수 (2의 거듭제곱). 이름마다 칸이 하나로 정해지는 완전 해시 표
+#define SHELL_BUILTIN_SLOTS 32
+
+// 이름에 맞는 빌트인 (없으면 NULL). 해시 한 번과 strcmp 한 번
+const struct shell_builtin *shell_find_builtin(const char *name);
+
+// 한 줄을 파싱. 작은따옴표/큰따옴표 안은 공백과 연산자도 그대로 인자가 됨.
+// 빈 줄이면 count = 0. 구문 오류면 -1, err에 이유
+int shell_parse(const char *line, struct shell_pipeline *pl, char *err, size_t errsize);
+
+// 모든 단계를 띄우고 끝날 때까지 기다림. 마지막 단계의 종료 상태를 반환
+int shell_run_pipeline(const struct shell_pipeline *pl);
+
+// 파싱과 실행. exit/quit이면 SHELL_EXIT
+int shell_execute(const char *line);
+
+// 배치 실행 flags
+#define SHELL_BATCH_TIMING      0x01    // 명령마다 걸린 시간을 stderr로 출력
+#define SHELL_BATCH_STOP_ERROR  0x02    // 실패한 명령이 있으면 거기서 멈춤
+
+struct shell_batch_stats {
+    unsigned long commands;     // 실행한 명령 수 (빈 줄과 주석 제외)
+    unsigned long failed;       // 종료 상태가 0이 아니었던 명령 수
+    double elapsed_ms;
+};
+
+// in에서 한 줄씩 읽어 대화 없이 이어서 실행. '#'으로 시작하는 줄은 주석.
+// 오류 메시지에는 name:줄번호를 붙임. 마지막 명령의 종료 상태를 반환
+int shell_run_batch(FILE *in, const char *name, int flags, struct shell_batch_stats *stats);
+
+// 명령줄 인자로 배치 실행: [-t] [-s] [-e] (-c "명령" | 스크립트.fsh | -).
+// -t는 명령별 시간, -s는 끝난 뒤 처리량(명령/s) 요약 (-t도 요약을 냄), -e는 첫 실패에서 멈춤. 스크립트 경로는 BASE_DIR로
+// 옮기기 전의 작업 디렉토리 기준. 배치 인자가 없으면 아무것도 하지 않고 SHELL_NOT_BATCH
+int shell_batch_main(int argc, char **argv);
+
+void handle_sigint(int signo);
+void run_terminal(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHELL_H
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef SHMRING_H
+#define SHMRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 공유 메모리 링 버퍼 채널. 파일을 MAP_SHARED로 매핑하므로 fork한 자식이나
+// 같은 파일을 shm_ring_open한 다른 프로세스와 메시지를 주고받을 수 있음.
+// 고정 크기 슬롯마다 순번(seq)을 두는 방식이라 생산자가 여럿이어도(MPSC) 잠금이 없고,
+// head/tail과 대기 카운터는 각각 다른 캐시 라인에 있어 생산자와 소비자가 서로 밀어내지 않음.
+// 비었거나 가득 찼을 때만 futex로 잠들고, 상대가 잠들어 있을 때만 깨우는 시스템 콜을 부름
+#define SHM_RING_CACHELINE  64
+#define SHM_RING_SPIN       256     // 잠들기 전에 돌며 다시 시도하는 횟수 (CPU가 둘 이상일 때)
+
+// shm_ring_create flags
+#define SHM_RING_MPSC       0x01    // 생산자가 여럿 (tail을 CAS로 차지). 없으면 SPSC
+
+struct shm_ring_shared;
+
+struct shm_ring {
+    struct shm_ring_shared *shared;     // 매핑의 앞부분 (헤더)
+    unsigned char *slots;
+    size_t map_size;
+    uint32_t mask;                      // capacity - 1
+    uint32_t slot_size;
+    uint32_t msg_max;                   // 메시지 하나의 최대 바이트
+    int flags;
+};
+
+struct shm_ring_stats {
+    uint32_t capacity;
+    uint32_t msg_max;
+    uint64_t sent;
+    uint64_t received;
+    uint64_t producer_sleeps;           // 가득 차서 futex로 잠든 횟수
+    uint64_t consumer_sleeps;           // 비어서 futex로 잠든 횟수
+};
+
+// path를 만들거나 덮어쓰고 링을 초기화해서 매핑. capacity는 2의 거듭제곱으로 올림
+int shm_ring_create(struct shm_ring *ring, const char *path, uint32_t capacity,
+                    uint32_t msg_max, int flags);
+// 다른 프로세스가 만든 링을 매핑
+int shm_ring_open(struct shm_ring *ring, const char *path);
+void shm_ring_close(struct shm_ring *ring);
+
+// 기다리지 않음. 가득 찼으면 -1 (EAGAIN), 메시지가 너무 크면 -1 (EMSGSIZE)
+int shm_ring_try_send(struct shm_ring *ring, const void *msg, size_t len);
+// 자리가 날 때까지 기다림. timeout_ms가 음수면 무한히, 시간이 지나면 -1 (ETIMEDOUT)
+int shm_ring_send(struct shm_ring *ring, const void *msg, size_t len, int timeout_ms);
+
+// 소비자는 하나. 받은 바이트 수, 비었으면 -1 (EAGAIN).
+// buf가 작으면 메시지는 잘려서 복사되고 소비됨
+ssize_t shm_ring_try_recv(struct shm_ring *ring, void *buf, size_t size);
+ssize_t shm_ring_recv(struct shm_ring *ring, void *buf, size_t size, int timeout_ms);
+
+void shm_ring_get_stats(const struct shm_ring *ring, struct shm_ring_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHMRING_H
@@ -0,0 +1,62 @@
+#ifndef SIGNAL_BATCH_H
+#define SIGNAL_BATCH_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <vector>
+#include "pidsig.h"
+
+// 여러 프로세스에 pidfd로 시그널을 보내고 종료를 이벤트 루프에서 지켜봄.
+// pidfd는 프로세스가 끝나면 읽기 가능해지므로 타이머마다 모든 pidfd를 poll 한 번으로
+// 기다리지 않고 확인하고, 정해진 시간 안에 끝나지 않으면 SIGKILL로 올림.
+// start()는 바로 반환하므로 UI가 멈추지 않음
+class SignalBatch : public QObject {
+    Q_OBJECT
+public:
+    static const int DEFAULT_WAIT_MS = 5000;   // 종료를 기다리는 최대 시간
+    static const int KILL_WAIT_MS = 2000;      // SIGKILL로 올린 뒤 기다리는 시간
+    static const int POLL_INTERVAL_MS = 100;
+
+    struct Target {
+        pid_t pid;
+        quint64 starttime;                     // 목록을 읽을 때의 시작 시각 (pid 재사용 확인)
+    };
+
+    explicit SignalBatch(const QVector<Target> &targets, QObject *parent = nullptr);
+    ~SignalBatch() override;
+
+    // waitForExit이 거짓이면 보내고 바로 끝남 (SIGSTOP, SIGCONT 등).
+    // escalateMs > 0이면 그때까지 끝나지 않은 프로세스에 SIGKILL
+    void start(int sig, bool waitForExit, int escalateMs = 0);
+
+    int total() const { return static_cast<int>(targets.size()); }
+    int exitedCount() const;
+    int failedCount() const;
+    int aliveCount() const;
+    bool escalated() const { return killSent; }
+    QString summary() const;
+
+signals:
+    void progress();
+    void finished();
+
+private:
+    void poll();
+    void escalate();
+    void finish();
+    void checkDone();
+
+    std::vector<struct pid_target> targets;
+    QTimer pollTimer;
+    QTimer escalateTimer;
+    QTimer deadline;
+    int sentSignal = 0;
+    bool waiting = false;             // 종료를 지켜보는 중 (start의 waitForExit)
+    bool killSent = false;
+    bool done = false;
+    QString firstError;
+};
+
+#endif // SIGNAL_BATCH_H
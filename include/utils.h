@@ -6,6 +6,13 @@
 #include <time.h>
 #include <signal.h>
 #include <sys/stat.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct file_info;
 
 // 유틸리티 함수 선언
 void print_permissions(struct stat *file_stat);
@@ -17,4 +24,46 @@ void print_user_group(uid_t uid, gid_t gid);
 void print_all_times(const struct stat *st);
 mode_t parse_mode_str(const char *mode_str, mode_t current_mode);
 
+// 출력 대신 버퍼에 포맷하는 함수들 (GUI 등 stdout을 쓰지 않는 호출자용)
+void format_permissions(const struct stat *file_stat, char *buf);
+size_t format_time(const time_t *time, char *buf, size_t size);
+
+// uid/gid 이름 캐시 (/etc/passwd, /etc/group이 바뀌면 자동 무효화)
+#define ID_NAME_MAX 64
+void uid_to_name(uid_t uid, char *out);
+void gid_to_name(gid_t gid, char *out);
+
+// 하루 단위 캐시를 사용하는 "YYYY-MM-DD HH:MM:SS" 포맷 (buf는 20바이트 이상)
+size_t format_time_cached(time_t t, char *buf);
+
+// 출력 버퍼: 모아서 한 번의 write로 내보냄 (fd < 0이면 메모리에만 누적)
+struct out_buf {
+    int fd;
+    char *data;
+    size_t len;
+    size_t cap;
+    int error;
+};
+
+void out_buf_init(struct out_buf *ob, int fd);
+void out_buf_append(struct out_buf *ob, const char *data, size_t len);
+int out_buf_flush(struct out_buf *ob);
+int out_buf_flush_if_full(struct out_buf *ob);
+void out_buf_free(struct out_buf *ob);
+
+void ls_format_entry(struct out_buf *ob, int dirfd, const struct file_info *fi,
+                     int show_all_times);
+
+// dirfd 아래의 names[0]/names[1]/.../names[n-1] 디렉토리를 열어 fd를 반환 (실패하면 -1).
+// 어느 단계든 심볼릭 링크면 따라가지 않고 실패함. openat2(RESOLVE_NO_SYMLINKS)로 PATH_MAX에
+// 들어가는 만큼씩 한 번에 열고, openat2가 없는 커널에서는 한 단계씩 O_NOFOLLOW로 엶
+int open_dir_chain(int dirfd, const char *const *names, size_t n);
+
+// NUL 또는 0x7f 초과 바이트가 하나라도 있으면 1 (미리보기의 바이너리 판별, SIMD/SWAR)
+int buffer_looks_binary(const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // UTILS_H 
\ No newline at end of file
@@ -1,5 +1,12 @@
 #include "../include/commands.h"
 #include "../include/utils.h"
+#include "../include/dirscan.h"
+#include "../include/copy.h"
+#include "../include/remove.h"
+#include "../include/du.h"
+#include "../include/grep.h"
+#include "../include/pidsig.h"
+#include "../include/shmring.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,114 +23,223 @@
 #include <ctype.h>
 #include <signal.h>
 
-volatile sig_atomic_t data_ready = 0;
+// 파이프라인/리디렉션 단계를 실행하는 스레드만 다른 스트림을 씀
+static __thread FILE *output_stream;
 
-void handle_usr1(int signo) {
-    (void)signo;  // 경고를 방지하기 위해 unused parameter를 void로 캐스팅
-    data_ready = 1;
+FILE *shell_output(void) {
+    return output_stream ? output_stream : stdout;
+}
+
+void shell_set_output(FILE *out) {
+    output_stream = out;
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1e6;
 }
 
 void call_help(void) {
-    printf("사용 가능한 명령어:\n");
-    printf("  ls       - 디렉토리 내용 표시\n");
-    printf("  cd       - 디렉토리 변경\n");
-    printf("  mkdir    - 디렉토리 생성\n");
-    printf("  rmdir    - 디렉토리 삭제\n");
-    printf("  rename   - 파일 또는 디렉토리 이름 변경\n");
-    printf("  ln       - 링크 생성\n");
-    printf("  rm       - 파일 삭제\n");
-    printf("  chmod    - 파일 권한 변경\n");
-    printf("  cat      - 파일 내용 표시\n");
-    printf("  cp       - 파 사\n");
-    printf("  ps       - 프로세스 상태 표시\n");
-    printf("  kill     - 프로세스에 시그널 전송\n");
-    printf("  exit     - 쉘 종료\n");
+    FILE *out = shell_output();
+    fprintf(out, "사용 가능한 명령어:\n");
+    fprintf(out, "  ls       - 디렉토리 내용 표시 (-t -S -r -T, -j N: 병렬 stat 스레드 수)\n");
+    fprintf(out, "  cd       - 디렉토리 변경\n");
+    fprintf(out, "  mkdir    - 디렉토리 생성\n");
+    fprintf(out, "  rmdir    - 디렉토리 삭제\n");
+    fprintf(out, "  rename   - 파일 또는 디렉토리 이름 변경\n");
+    fprintf(out, "  ln       - 링크 생성\n");
+    fprintf(out, "  rm       - 파일 삭제\n");
+    fprintf(out, "  chmod    - 파일 권한 변경\n");
+    fprintf(out, "  cat      - 파일 내용 표시\n");
+    fprintf(out, "  cp       - 파일 복사\n");
+    fprintf(out, "  ps       - 프로세스 상태 표시 (ps [-a] [-l] [-v] [--tree])\n");
+    fprintf(out, "  kill     - 프로세스에 시그널 전송 (kill PID [시그널])\n");
+    fprintf(out, "  pkill    - 패턴과 일치하는 프로세스에 시그널 (pkill [-시그널] [-f] [-x] [-i] [-n] [-w 초] 패턴)\n");
+    fprintf(out, "  statbench - 워커 수별 디렉토리 메타데이터 조회 시간 측정\n");
+    fprintf(out, "  cpbench  - 복사 엔진 처리량 측정 (cpbench [MB])\n");
+    fprintf(out, "  ls_bench - ls 한 줄 포맷 속도를 예전 printf 방식과 비교 (ls_bench [항목 수])\n");
+    fprintf(out, "  mmap_test - 공유 메모리 링 처리량/지연 측정 (mmap_test 파일 [메시지 수] [생산자 수])\n");
+    fprintf(out, "  du       - 디렉토리별 디스크 사용량 (du [-s] [-d N] [-b] [-h] [-f] [-j N] [경로])\n");
+    fprintf(out, "  grep     - 파일 내용 검색 (grep [-i] [-E] [-a] [-m N] [-j N] 패턴 [경로], 경로가 없으면 파이프 입력)\n");
+    fprintf(out, "  exit     - 쉘 종료\n");
+    fprintf(out, "명령은 | 로 잇고 < > >> 로 리디렉션할 수 있습니다 (ls, cat, ps, grep, du, help, mmap_test)\n");
 }
 
-int compare_by_name(const void *a, const void *b) {
-    return strcmp(((struct file_info *)a)->name, ((struct file_info *)b)->name);
+// 동일한 키는 이름순으로 정렬해 페이지 간 순서가 항상 같도록 함
+static int compare_by_name(const struct dir_listing *l, const struct dir_entry *a,
+                           const struct dir_entry *b, void *ctx) {
+    int reverse = *(const int *)ctx;
+    int r = strcmp(dir_entry_name(l, a), dir_entry_name(l, b));
+    return reverse ? -r : r;
 }
 
-int compare_by_time(const void *a, const void *b) {
-    return ((struct file_info *)b)->st.st_mtime - ((struct file_info *)a)->st.st_mtime;
+static int compare_by_time(const struct dir_listing *l, const struct dir_entry *a,
+                           const struct dir_entry *b, void *ctx) {
+    int reverse = *(const int *)ctx;
+    int r = (a->mtime < b->mtime) - (a->mtime > b->mtime);
+    if (r == 0) r = strcmp(dir_entry_name(l, a), dir_entry_name(l, b));
+    return reverse ? -r : r;
 }
 
-int compare_by_size(const void *a, const void *b) {
-    return ((struct file_info *)b)->st.st_size - ((struct file_info *)a)->st.st_size;
+static int compare_by_size(const struct dir_listing *l, const struct dir_entry *a,
+                           const struct dir_entry *b, void *ctx) {
+    int reverse = *(const int *)ctx;
+    int r = (a->size < b->size) - (a->size > b->size);
+    if (r == 0) r = strcmp(dir_entry_name(l, a), dir_entry_name(l, b));
+    return reverse ? -r : r;
 }
 
+int ls_pager_open(struct ls_pager *p, const char *current_dir, const struct ls_options *opts) {
+    memset(p, 0, sizeof(*p));
+    p->opts = *opts;
+    snprintf(p->dir, sizeof(p->dir), "%s", current_dir);
 
-void call_ls(const char *current_dir, const struct ls_options *opts) {
-    DIR *d = opendir(current_dir);
-    if (!d) {
-        perror(current_dir);
-        return;
+    // 페이지로 내보낼 때 필요한 필드
+    p->need = DIRSCAN_NEED_TYPE | DIRSCAN_NEED_SIZE | DIRSCAN_NEED_MTIME | DIRSCAN_NEED_OWNER;
+    if (opts->show_all_times)
+        p->need |= DIRSCAN_NEED_TIMES;
+
+    if (dir_listing_open(&p->listing, current_dir, 0) == -1)
+        return -1;
+    p->listing.workers = opts->stat_workers;
+
+    p->order = malloc((p->listing.count ? p->listing.count : 1) * sizeof(*p->order));
+    if (!p->order) {
+        dir_listing_free(&p->listing);
+        errno = ENOMEM;
+        return -1;
     }
 
-    struct file_info *files = NULL;
-    int count = 0;
-    struct dirent *ent;
+    // 시간/크기 정렬은 모든 엔트리의 해당 필드만 먼저 가져옴. 이름 정렬은 stat 없이 진행
+    unsigned sort_need = 0;
+    if (opts->sort_by_time) {
+        p->cmp = compare_by_time;
+        sort_need = DIRSCAN_NEED_MTIME;
+    } else if (opts->sort_by_size) {
+        p->cmp = compare_by_size;
+        sort_need = DIRSCAN_NEED_SIZE;
+    } else {
+        p->cmp = compare_by_name;
+    }
+    if (sort_need)
+        dir_listing_fetch(&p->listing, 0, p->listing.count, sort_need);
 
-    // 파일 정보 수집
-    while ((ent = readdir(d))) {
-        files = realloc(files, (count + 1) * sizeof(struct file_info));
-        char path[MAX_PATH_SIZE];
-        snprintf(path, sizeof(path), "%s/%s", current_dir, ent->d_name);
-        
-        if (lstat(path, &files[count].st) == -1)
+    for (size_t i = 0; i < p->listing.count; i++) {
+        // stat에 실패한 엔트리는 건너뜀
+        if (sort_need && p->listing.entries[i].error)
             continue;
-            
-        strcpy(files[count].name, ent->d_name);
-        count++;
-    }
-
-    // 정렬
-    if (opts->sort_by_time)
-        qsort(files, count, sizeof(struct file_info), compare_by_time);
-    else if (opts->sort_by_size)
-        qsort(files, count, sizeof(struct file_info), compare_by_size);
-    else
-        qsort(files, count, sizeof(struct file_info), compare_by_name);
-
-    if (opts->reverse_sort) {
-        // 정렬 결과 뒤집기
-        for (int i = 0; i < count/2; i++) {
-            struct file_info temp = files[i];
-            files[i] = files[count-1-i];
-            files[count-1-i] = temp;
-        }
+        p->order[p->total++] = (uint32_t)i;
     }
+    return 0;
+}
 
-    // 출력
-    for (int i = 0; i < count; i++) {
-        print_permissions(&files[i].st);
-        printf(" %ld", (long)files[i].st.st_nlink);
-        print_user_group(files[i].st.st_uid, files[i].st.st_gid);
-        printf(" %ld", (long)files[i].st.st_size);
-        
-        if (opts->show_all_times)
-            print_all_times(&files[i].st);
-        else
-            print_time(&files[i].st.st_mtime);
-
-        printf(" %s", files[i].name);
-        
-        // 심볼릭 링크인 경우 링크 내용 표시
-        if (S_ISLNK(files[i].st.st_mode)) {
-            char link_path[MAX_PATH_SIZE];
-            char abs_path[MAX_PATH_SIZE];
-            snprintf(abs_path, sizeof(abs_path), "%s/%s", current_dir, files[i].name);
-            ssize_t len = readlink(abs_path, link_path, sizeof(link_path) - 1);
-            if (len != -1) {
-                link_path[len] = '\0';
-                printf(" -> %s", link_path);
-            }
+// [0, k) 구간이 정렬된 상태가 되도록 확장 (top-K 선택 후 앞부분만 정렬)
+static void ls_pager_ensure_sorted(struct ls_pager *p, size_t k) {
+    if (k <= p->sorted) return;
+
+    // 다음 페이지 요청마다 전체 선택을 반복하지 않도록 정렬 구간을 기하급수적으로 늘림
+    size_t target = p->sorted * 2;
+    if (target < k) target = k;
+    if (target > p->total) target = p->total;
+
+    int reverse = p->opts.reverse_sort;
+    if (target < p->total)
+        dir_order_select(&p->listing, p->order, p->sorted, target, p->total, p->cmp, &reverse);
+    dir_order_sort(&p->listing, p->order, p->sorted, target, p->cmp, &reverse);
+    p->sorted = target;
+}
+
+size_t ls_pager_next(struct ls_pager *p, struct file_info *out, size_t max) {
+    size_t filled = 0;
+
+    while (filled < max && p->pos < p->total) {
+        size_t want = p->pos + (max - filled);
+        if (want > p->total) want = p->total;
+        ls_pager_ensure_sorted(p, want);
+
+        // 페이지에 해당하는 엔트리의 메타데이터를 한꺼번에 (병렬로) 가져옴
+        dir_listing_fetch_indices(&p->listing, p->order + p->pos, want - p->pos, p->need);
+
+        // 목록을 읽은 뒤 사라져 stat에 실패한 엔트리는 순서 배열에서 빼서 pos/total에 세지 않음
+        size_t kept = p->pos;
+        for (size_t k = p->pos; k < want; k++) {
+            struct dir_entry *e = &p->listing.entries[p->order[k]];
+            if (e->error)
+                continue;
+            p->order[kept++] = p->order[k];
+            memcpy(out[filled].name, dir_entry_name(&p->listing, e), e->name_len + 1);
+            dir_entry_to_stat(e, &out[filled].st);
+            filled++;
         }
-        printf("\n");
+        if (kept < want) {
+            memmove(p->order + kept, p->order + want, (p->total - want) * sizeof(*p->order));
+            p->sorted -= want - kept;
+            p->total -= want - kept;
+        }
+        p->pos = kept;
     }
+    return filled;
+}
 
-    free(files);
-    closedir(d);
+void ls_pager_close(struct ls_pager *p) {
+    dir_listing_free(&p->listing);
+    free(p->order);
+    p->order = NULL;
+}
+
+int ls_collect(const char *current_dir, const struct ls_options *opts,
+               struct file_info **out, size_t *out_count) {
+    *out = NULL;
+    *out_count = 0;
+
+    struct ls_pager pager;
+    if (ls_pager_open(&pager, current_dir, opts) == -1)
+        return -1;
+
+    struct file_info *files = malloc((pager.total ? pager.total : 1) * sizeof(struct file_info));
+    if (!files) {
+        ls_pager_close(&pager);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    *out_count = ls_pager_next(&pager, files, pager.total);
+    *out = files;
+    ls_pager_close(&pager);
+    return 0;
+}
+
+void call_ls(const char *current_dir, const struct ls_options *opts) {
+    struct ls_pager pager;
+    if (ls_pager_open(&pager, current_dir, opts) == -1) {
+        perror(current_dir);
+        return;
+    }
+
+    // 페이지 단위로 정렬/출력하여 큰 디렉토리에서도 첫 화면이 바로 나오도록 함
+    struct file_info *page = malloc(LS_PAGE_SIZE * sizeof(struct file_info));
+    if (!page) {
+        perror("malloc");
+        ls_pager_close(&pager);
+        return;
+    }
+
+    // 한 줄씩 printf하지 않고 큰 버퍼에 포맷한 뒤 write 한 번으로 내보냄
+    FILE *out = shell_output();
+    struct out_buf ob;
+    out_buf_init(&ob, fileno(out));
+    fflush(out);
+
+    size_t n;
+    while ((n = ls_pager_next(&pager, page, LS_PAGE_SIZE)) > 0) {
+        for (size_t i = 0; i < n; i++)
+            ls_format_entry(&ob, pager.listing.dirfd, &page[i], opts->show_all_times);
+        out_buf_flush_if_full(&ob);
+    }
+    out_buf_flush(&ob);
+    out_buf_free(&ob);
+
+    free(page);
+    ls_pager_close(&pager);
 }
 
 void call_cd(const char *current_dir, const char *path, char *new_dir) {
@@ -230,7 +346,16 @@ void call_rm(const char *current_dir, const char *path, int recursive) {
             printf("rm: %s: 디렉토리니다. -r 옵션을 사용하세요\n", path);
             return;
         }
-        remove_directory_recursive(abs_path);
+        struct remove_progress progress = { 0, 0, 0, 0 };
+        char error[MAX_PATH_SIZE * 2] = "";
+        if (remove_tree(abs_path, 0, &progress, error, sizeof(error)) == -1) {
+            if (error[0])
+                printf("rm: %s\n", error);
+            else
+                perror("rm");
+            if (progress.errors > 1)
+                printf("rm: 그 외 %llu개 항목을 삭제하지 못했습니다\n", progress.errors - 1);
+        }
     } else {
         if (unlink(abs_path) == -1) {
             perror(abs_path);
@@ -261,27 +386,44 @@ int call_chmod(const char *current_dir, const char *path, const char *mode) {
     return 0;
 }
 
-void call_cat(const char *current_dir, const char *path) {
+int cat_read(const char *current_dir, const char *path, data_sink_fn sink, void *ctx) {
     char abs_path[MAX_PATH_SIZE];
     get_absolute_path(current_dir, path, abs_path);
 
-    if (!is_within_base_dir(abs_path)) {
-        printf("오류: %s 외부의 파일을 읽을 수 없습니다\n", BASE_DIR);
-        return;
+    if (!is_within_base_dir(abs_path))
+        return FSOPS_ERR_OUTSIDE_BASE;
+
+    int fd = open(abs_path, O_RDONLY);
+    if (fd == -1) return -1;
+
+    char buffer[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) != 0) {
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            int saved = errno;
+            close(fd);
+            errno = saved;
+            return -1;
+        }
+        if (sink(ctx, buffer, (size_t)n) != 0) break;
     }
 
-    FILE *fp = fopen(abs_path, "r");
-    if (!fp) {
-        perror(abs_path);
-        return;
-    }
+    close(fd);
+    return 0;
+}
 
-    char buffer[1024];
-    while (fgets(buffer, sizeof(buffer), fp)) {
-        printf("%s", buffer);
-    }
+static int stream_sink(void *ctx, const char *data, size_t len) {
+    return fwrite(data, 1, len, (FILE *)ctx) == len ? 0 : -1;
+}
 
-    fclose(fp);
+void call_cat(const char *current_dir, const char *path) {
+    int ret = cat_read(current_dir, path, stream_sink, shell_output());
+    if (ret == FSOPS_ERR_OUTSIDE_BASE) {
+        printf("오류: %s 외부의 파일을 읽을 수 없습니다\n", BASE_DIR);
+    } else if (ret == -1) {
+        perror(path);
+    }
 }
 
 void call_cp(const char *current_dir, const char *path, const char *target) {
@@ -294,17 +436,20 @@ void call_cp(const char *current_dir, const char *path, const char *target) {
         return;
     }
 
-    FILE *src = fopen(abs_path, "r");
-    if (!src) {
-        perror(abs_path);
-        return;
+    if (copy_file(abs_path, abs_target, NULL) == -1) {
+        perror("cp");
     }
+}
 
-    FILE *dst = fopen(abs_target, "w");
+// 벤치마크 기준선: 예전 call_cp와 같은 1KB stdio 복사
+static int copy_legacy_stdio(const char *src_path, const char *dst_path) {
+    FILE *src = fopen(src_path, "r");
+    if (!src) return -1;
+
+    FILE *dst = fopen(dst_path, "w");
     if (!dst) {
-        perror(abs_target);
         fclose(src);
-        return;
+        return -1;
     }
 
     char buffer[1024];
@@ -314,246 +459,842 @@ void call_cp(const char *current_dir, const char *path, const char *target) {
     }
 
     fclose(src);
-    fclose(dst);
+    return fclose(dst);
 }
 
-void call_ps(const char *options) {
-    if (!ENABLE_PS) {
-        printf("PS 명령어가 비활성화되어 있습니다\n");
+void call_cp_bench(const char *current_dir, const char *size_mb_str) {
+    long size_mb = size_mb_str ? atol(size_mb_str) : 256;
+    if (size_mb <= 0) size_mb = 256;
+
+    char src_path[MAX_PATH_SIZE], legacy_path[MAX_PATH_SIZE], engine_path[MAX_PATH_SIZE];
+    get_absolute_path(current_dir, ".cpbench.src", src_path);
+    get_absolute_path(current_dir, ".cpbench.legacy", legacy_path);
+    get_absolute_path(current_dir, ".cpbench.engine", engine_path);
+
+    // 원본 파일 생성
+    int fd = open(src_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        perror(src_path);
         return;
     }
-
-    struct ps_options ps_opts = {0, 0};
-    
-    // 옵션 파싱
-    if (options) {
-        char *opt_copy = strdup(options);
-        char *token = strtok(opt_copy, " ");
-        while (token) {
-            if (strcmp(token, "-a") == 0) {
-                ps_opts.show_all = 1;
-            } else if (strcmp(token, "-l") == 0) {
-                ps_opts.long_format = 1;
-            }
-            token = strtok(NULL, " ");
+    char *block = malloc(COPY_BUF_SIZE);
+    if (!block) {
+        close(fd);
+        unlink(src_path);
+        return;
+    }
+    for (size_t i = 0; i < COPY_BUF_SIZE; i++)
+        block[i] = (char)(i * 131 + 7);
+    for (long i = 0; i < size_mb; i++) {
+        if (write(fd, block, COPY_BUF_SIZE) != COPY_BUF_SIZE) {
+            perror("write");
+            break;
         }
-        free(opt_copy);
+    }
+    free(block);
+    fsync(fd);
+    close(fd);
+
+    struct timespec start, end;
+    printf("cp 벤치마크: %ldMB 파일\n", size_mb);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int legacy_ret = copy_legacy_stdio(src_path, legacy_path);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double legacy_ms = elapsed_ms(&start, &end);
+    if (legacy_ret == 0)
+        printf("  %-16s %10.1f ms %10.1f MB/s\n", "stdio 1KB", legacy_ms,
+               size_mb / (legacy_ms / 1000.0));
+
+    struct copy_stats stats = {0};
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int engine_ret = copy_file(src_path, engine_path, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double engine_ms = elapsed_ms(&start, &end);
+    if (engine_ret == 0) {
+        printf("  %-16s %10.1f ms %10.1f MB/s\n", copy_method_name(stats.method), engine_ms,
+               size_mb / (engine_ms / 1000.0));
+        if (legacy_ret == 0 && engine_ms > 0)
+            printf("  속도 향상: %.1fx\n", legacy_ms / engine_ms);
+    } else {
+        perror("copy_file");
     }
 
-    DIR *dir = opendir("/proc");
-    if (!dir) {
-        perror("opendir");
+    unlink(src_path);
+    unlink(legacy_path);
+    unlink(engine_path);
+}
+
+// 벤치마크 기준선: 예전 call_ls가 한 줄마다 하던 snprintf + getpwuid/getgrgid + strftime
+static void format_ls_entry_stdio(char *buf, size_t size, const struct file_info *fi,
+                                  int show_all_times) {
+    char perms[11];
+    char mtime[26], atime[26], ctime_buf[26];
+    struct passwd *pw = getpwuid(fi->st.st_uid);
+    struct group *gr = getgrgid(fi->st.st_gid);
+
+    format_permissions(&fi->st, perms);
+    format_time(&fi->st.st_mtime, mtime, sizeof(mtime));
+    if (show_all_times) {
+        format_time(&fi->st.st_atime, atime, sizeof(atime));
+        format_time(&fi->st.st_ctime, ctime_buf, sizeof(ctime_buf));
+        snprintf(buf, size, "%s %ld %s %s %ld\n  Access:  %s\n  Modify:  %s\n  Change:  %s\n %s\n",
+                 perms, (long)fi->st.st_nlink,
+                 pw ? pw->pw_name : "unknown", gr ? gr->gr_name : "unknown",
+                 (long)fi->st.st_size, atime, mtime, ctime_buf, fi->name);
+    } else {
+        snprintf(buf, size, "%s %ld %s %s %ld %s %s\n",
+                 perms, (long)fi->st.st_nlink,
+                 pw ? pw->pw_name : "unknown", gr ? gr->gr_name : "unknown",
+                 (long)fi->st.st_size, mtime, fi->name);
+    }
+}
+
+// 메모리에 만든 항목만 포맷하므로 getdents/statx 시간은 빠지고 포맷 단계만 잼.
+// 소유자는 현재 사용자, root, 없는 id를 섞고 시각은 여러 날에 걸치게 해 캐시 미스도 포함
+void call_ls_bench(const char *count_str) {
+    long count = count_str ? atol(count_str) : LS_BENCH_DEFAULT_ENTRIES;
+    if (count <= 0) count = LS_BENCH_DEFAULT_ENTRIES;
+
+    struct file_info *files = malloc((size_t)count * sizeof(*files));
+    if (!files) {
+        perror("malloc");
         return;
     }
+    time_t now = time(NULL);
+    uid_t owners[3] = { getuid(), 0, 54321 };
+    gid_t groups[3] = { getgid(), 0, 54321 };
+    for (long i = 0; i < count; i++) {
+        struct file_info *fi = &files[i];
+        memset(&fi->st, 0, sizeof(fi->st));
+        snprintf(fi->name, sizeof(fi->name), "file_%06ld.dat", i);
+        fi->st.st_mode = i % 10 == 0 ? (S_IFDIR | 0755) : (S_IFREG | 0644);
+        fi->st.st_nlink = i % 10 == 0 ? 2 : 1;
+        fi->st.st_uid = owners[i % 3];
+        fi->st.st_gid = groups[i % 3];
+        fi->st.st_size = (off_t)i * 4099;
+        fi->st.st_mtime = now - i * 37;
+        fi->st.st_atime = now - i * 11;
+        fi->st.st_ctime = now - i * 53;
+    }
 
-    // 헤더 출력
-    if (ps_opts.long_format) {
-        printf("  PID   PPID  PGRP   UID   GID    VSZ    RSS STATE CMD\n");
-    } else {
-        printf("  PID   TTY          TIME CMD\n");
-    }
-
-    struct dirent *entry;
-    while ((entry = readdir(dir))) {
-        if (!isdigit(*entry->d_name)) continue;
-
-        // 프로세스 ID가 아닌 경우 건너뛰기
-        pid_t pid = atoi(entry->d_name);
-        if (pid == 0) continue;
-
-        char stat_path[MAX_PATH_SIZE];
-        snprintf(stat_path, sizeof(stat_path), "/proc/%s/stat", entry->d_name);
-        
-        FILE *f = fopen(stat_path, "r");
-        if (!f) continue;
-
-        // stat 파일 파싱
-        char state;
-        int ppid, pgrp;
-        unsigned long vsize, rss;
-        char comm[MAX_CMD_SIZE];
-        
-        fscanf(f, "%*d %s %c %d %d", comm, &state, &ppid, &pgrp);
-        fclose(f);
-
-        // 프로세스 소유자 정보 얻기
-        char proc_path[MAX_PATH_SIZE];
-        snprintf(proc_path, sizeof(proc_path), "/proc/%s", entry->d_name);
-        struct stat st;
-        if (stat(proc_path, &st) == -1) continue;
-
-        // -a 옵션이 없으면 자신의 프로세스만 표시
-        if (!ps_opts.show_all && st.st_uid != getuid()) continue;
-
-        // cmdline 읽기
-        char cmdline[MAX_CMD_SIZE] = {0};
-        snprintf(proc_path, sizeof(proc_path), "/proc/%s/cmdline", entry->d_name);
-        f = fopen(proc_path, "r");
-        if (f) {
-            size_t n = fread(cmdline, 1, sizeof(cmdline)-1, f);
-            fclose(f);
-            if (n > 0) {
-                cmdline[n] = '\0';
-                for (size_t i = 0; i < n; i++) {
-                    if (cmdline[i] == '\0') cmdline[i] = ' ';
-                }
-            }
+    int null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    FILE *null_file = null_fd == -1 ? NULL : fdopen(dup(null_fd), "w");
+    if (!null_file) {
+        perror("/dev/null");
+        if (null_fd != -1) close(null_fd);
+        free(files);
+        return;
+    }
+
+    printf("ls 포맷 벤치마크: 항목 %ld개 (디렉토리 조회 제외)\n", count);
+    printf("MODE  METHOD              TIME(ms)  ns/ENTRY  SPEEDUP  OUTPUT\n");
+
+    char line[MAX_PATH_SIZE * 4];
+    struct timespec start, end;
+    for (int all_times = 0; all_times <= 1; all_times++) {
+        // 기준선: 예전처럼 한 줄씩 fputs하고 페이지마다 fflush
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < count; i++) {
+            format_ls_entry_stdio(line, sizeof(line), &files[i], all_times);
+            fputs(line, null_file);
+            if ((i + 1) % LS_PAGE_SIZE == 0) fflush(null_file);
         }
-        if (cmdline[0] == '\0') {
-            strncpy(cmdline, comm, sizeof(cmdline)-1);
+        fflush(null_file);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double legacy_ms = elapsed_ms(&start, &end);
+
+        struct out_buf ob;
+        out_buf_init(&ob, null_fd);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < count; i++) {
+            ls_format_entry(&ob, -1, &files[i], all_times);
+            out_buf_flush_if_full(&ob);
         }
+        out_buf_flush(&ob);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double engine_ms = elapsed_ms(&start, &end);
+        out_buf_free(&ob);
+
+        // 두 방식의 출력이 바이트 단위로 같은지 앞부분을 메모리에서 비교
+        long sample = count < LS_BENCH_VERIFY_ENTRIES ? count : LS_BENCH_VERIFY_ENTRIES;
+        struct out_buf expect, actual;
+        out_buf_init(&expect, -1);
+        out_buf_init(&actual, -1);
+        for (long i = 0; i < sample; i++) {
+            format_ls_entry_stdio(line, sizeof(line), &files[i], all_times);
+            out_buf_append(&expect, line, strlen(line));
+            ls_format_entry(&actual, -1, &files[i], all_times);
+        }
+        int same = !expect.error && !actual.error && expect.len == actual.len &&
+                   memcmp(expect.data, actual.data, expect.len) == 0;
+        out_buf_free(&expect);
+        out_buf_free(&actual);
+
+        const char *mode = all_times ? "-T" : "-l";
+        printf("%-4s  %-16s %11.1f %9.1f  %6.2fx\n", mode, "snprintf/stdio", legacy_ms,
+               legacy_ms * 1e6 / count, 1.0);
+        printf("%-4s  %-16s %11.1f %9.1f  %6.2fx  %s\n", mode, "ls_format_entry", engine_ms,
+               engine_ms * 1e6 / count, engine_ms > 0 ? legacy_ms / engine_ms : 0.0,
+               same ? "일치" : "불일치");
+    }
 
-        // 메모리 정보 읽기
-        snprintf(proc_path, sizeof(proc_path), "/proc/%s/statm", entry->d_name);
-        f = fopen(proc_path, "r");
-        if (f) {
-            fscanf(f, "%lu %lu", &vsize, &rss);
-            fclose(f);
+    fclose(null_file);
+    close(null_fd);
+    free(files);
+}
+
+void parse_ps_options(const char *options, struct ps_options *opts) {
+    opts->long_format = 0;
+    opts->show_all = 0;
+    opts->show_metrics = 0;
+    opts->tree = 0;
+    if (!options) return;
+
+    char *opt_copy = strdup(options);
+    if (!opt_copy) return;
+    char *saveptr;
+    char *token = strtok_r(opt_copy, " ", &saveptr);
+    while (token) {
+        if (strcmp(token, "-a") == 0) {
+            opts->show_all = 1;
+        } else if (strcmp(token, "-l") == 0) {
+            opts->long_format = 1;
+        } else if (strcmp(token, "-v") == 0) {
+            opts->show_metrics = 1;
+        } else if (strcmp(token, "--tree") == 0) {
+            opts->tree = 1;
         }
+        token = strtok_r(NULL, " ", &saveptr);
+    }
+    free(opt_copy);
+}
 
-        // 결과 출력
-        if (ps_opts.long_format) {
-            printf("%5d %5d %5d %5d %5d %6lu %6lu %c %s\n",
-                pid, ppid, pgrp, st.st_uid, st.st_gid,
-                vsize * 4, rss * 4, state, cmdline);
+int ps_collect(const struct ps_options *opts, struct proc_info **out, size_t *out_count,
+               struct proc_scan_metrics *metrics) {
+    *out = NULL;
+    *out_count = 0;
+
+    struct proc_scanner *scanner = proc_scanner_create();
+    if (!scanner) return -1;
+
+    size_t capacity = 0;
+    int flags = PROC_SCAN_CMDLINE | (opts->show_all ? PROC_SCAN_ALL : 0);
+    int ret = proc_scan(scanner, flags, out, out_count, &capacity, metrics);
+    int err = errno;
+    proc_scanner_free(scanner);
+    if (ret == -1) {
+        free(*out);
+        *out = NULL;
+        *out_count = 0;
+        errno = err;
+    }
+    return ret;
+}
+
+// 누적 CPU 시간 (클럭 틱)을 HH:MM:SS로
+static void format_cpu_time(unsigned long long ticks, char *buf, size_t size) {
+    static long clock_ticks;
+    if (clock_ticks <= 0) {
+        clock_ticks = sysconf(_SC_CLK_TCK);
+        if (clock_ticks <= 0) clock_ticks = 100;
+    }
+    unsigned long long seconds = ticks / (unsigned long long)clock_ticks;
+    snprintf(buf, size, "%02llu:%02llu:%02llu", seconds / 3600, seconds / 60 % 60, seconds % 60);
+}
+
+static void print_ps_list(FILE *out, const struct ps_options *opts, const struct proc_info *procs,
+                          size_t count) {
+    // 헤더 출력
+    if (opts->long_format) {
+        fprintf(out, "  PID   PPID  PGRP   UID   GID    VSZ    RSS STATE CMD\n");
+    } else {
+        fprintf(out, "  PID TTY          TIME CMD\n");
+    }
+
+    // 결과 출력
+    for (size_t i = 0; i < count; i++) {
+        const struct proc_info *p = &procs[i];
+        if (opts->long_format) {
+            fprintf(out, "%5d %5d %5d %5d %5d %6lu %6lu %c %s\n",
+                p->pid, p->ppid, p->pgrp, p->uid, p->gid,
+                p->vsz, p->rss, p->state, p->cmdline);
         } else {
-            printf("%5d ?        00:00:00 %s\n", pid, cmdline);
+            char tty[16], cpu_time[32];
+            proc_format_tty(p->tty_nr, tty, sizeof(tty));
+            format_cpu_time(p->utime + p->stime, cpu_time, sizeof(cpu_time));
+            fprintf(out, "%5d %-8s %8s %s\n", p->pid, tty, cpu_time, p->cmdline);
         }
     }
-    closedir(dir);
+}
+
+// ps --tree: 전위 순서로 출력하고 RSS/VSZ/CPU 시간은 하위 트리 합계로 보여줌
+static int print_ps_tree(FILE *out, const struct proc_info *procs, size_t count) {
+    pid_t *pids = malloc((count ? count : 1) * sizeof(*pids));
+    pid_t *ppids = malloc((count ? count : 1) * sizeof(*ppids));
+    double *sums = malloc((count ? count : 1) * 3 * sizeof(*sums));
+    if (!pids || !ppids || !sums) {
+        free(pids);
+        free(ppids);
+        free(sums);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        pids[i] = procs[i].pid;
+        ppids[i] = procs[i].ppid;
+    }
+    struct proc_tree tree;
+    int ret = proc_tree_build(pids, ppids, count, &tree);
+    free(pids);
+    free(ppids);
+    if (ret == -1) {
+        proc_tree_free(&tree);
+        free(sums);
+        return -1;
+    }
+
+    // 합계 세 가지를 한 배열에 이어서 계산
+    double *rss = sums, *vsz = sums + count, *ticks = sums + 2 * count;
+    for (size_t i = 0; i < count; i++) {
+        rss[i] = (double)procs[i].rss;
+        vsz[i] = (double)procs[i].vsz;
+        ticks[i] = (double)(procs[i].utime + procs[i].stime);
+    }
+    proc_tree_sum(&tree, rss, rss);
+    proc_tree_sum(&tree, vsz, vsz);
+    proc_tree_sum(&tree, ticks, ticks);
+
+    fprintf(out, "  PID  NPROC   RSS(합)   VSZ(합)   TIME(합) CMD\n");
+    for (size_t k = 0; k < count; k++) {
+        size_t i = tree.preorder[k];
+        char rss_text[16], vsz_text[16], cpu_time[32];
+        du_format_size((unsigned long long)rss[i] * 1024, rss_text);
+        du_format_size((unsigned long long)vsz[i] * 1024, vsz_text);
+        format_cpu_time((unsigned long long)ticks[i], cpu_time, sizeof(cpu_time));
+
+        fprintf(out, "%5d %6zu %9s %9s %10s ", procs[i].pid, tree.subtree_size[i], rss_text, vsz_text, cpu_time);
+        for (int d = 1; d < tree.depth[i]; d++)
+            fputs("    ", out);
+        if (tree.depth[i] > 0)
+            fputs(" \\_ ", out);
+        fprintf(out, "%s\n", procs[i].cmdline);
+    }
+
+    proc_tree_free(&tree);
+    free(sums);
+    return 0;
+}
+
+void call_ps(const char *options) {
+    if (!ENABLE_PS) {
+        printf("PS 명령어가 비활성화되어 있습니다\n");
+        return;
+    }
+
+    struct ps_options ps_opts;
+    parse_ps_options(options, &ps_opts);
+
+    struct proc_info *procs;
+    size_t count;
+    struct proc_scan_metrics metrics;
+    if (ps_collect(&ps_opts, &procs, &count, &metrics) == -1) {
+        perror("ps");
+        return;
+    }
+
+    FILE *out = shell_output();
+    if (ps_opts.tree) {
+        if (print_ps_tree(out, procs, count) == -1)
+            perror("ps");
+    } else {
+        print_ps_list(out, &ps_opts, procs, count);
+    }
+    free(procs);
+
+    if (ps_opts.show_metrics) {
+        fprintf(out, "프로세스 %lu개 (항목 %lu개, 다른 사용자 %lu개, 도중 종료 %lu개)\n",
+                metrics.procs, metrics.entries, metrics.filtered, metrics.vanished);
+        fprintf(out, "시스템 콜 %lu번, %llu바이트 읽음, %.2f ms\n",
+                metrics.syscalls, metrics.bytes_read, metrics.elapsed_ms);
+    }
 }
 
 int call_kill(const char *pid_str, const char *sig_str) {
     pid_t pid = atoi(pid_str);
-    int sig = sig_str ? atoi(sig_str) : SIGTERM;
-    
-    if (kill(pid, sig) == -1) {
+    int sig = sig_str ? signal_parse(sig_str) : SIGTERM;
+    if (sig == -1) {
+        printf("kill: 알 수 없는 시그널: %s\n", sig_str);
+        return -1;
+    }
+
+    struct pid_target target;
+    pid_target_init(&target, pid, 0);
+    int rc = pid_target_signal(&target, sig);
+    if (rc == -1)
         perror("kill");
+    pid_target_close(&target);
+    return rc;
+}
+
+int call_pkill(const char *pattern, const struct pkill_options *opts) {
+    char error[256];
+    struct proc_pattern re;
+    if (proc_pattern_compile(&re, pattern, opts->match_flags, error, sizeof(error)) == -1) {
+        printf("pkill: 잘못된 패턴: %s\n", error);
+        return -1;
+    }
+
+    // pgrep처럼 다른 사용자의 프로세스도 찾고, 권한이 없으면 보낼 때 실패로 보고
+    struct proc_scanner *scanner = proc_scanner_create();
+    struct proc_info *procs = NULL;
+    size_t count = 0, capacity = 0;
+    if (!scanner || proc_scan(scanner, PROC_SCAN_ALL | PROC_SCAN_CMDLINE, &procs, &count,
+                              &capacity, NULL) == -1) {
+        perror("pkill");
+        proc_scanner_free(scanner);
+        proc_pattern_free(&re);
+        return -1;
+    }
+    proc_scanner_free(scanner);
+
+    struct pid_target *targets = malloc((count ? count : 1) * sizeof(*targets));
+    if (!targets) {
+        perror("pkill");
+        free(procs);
+        proc_pattern_free(&re);
+        return -1;
+    }
+    size_t matched = 0;
+    pid_t self = getpid();
+    for (size_t i = 0; i < count; i++) {
+        if (procs[i].pid == self) continue;
+        if (!proc_pattern_match(&re, procs[i].comm, procs[i].cmdline)) continue;
+        if (opts->list_only)
+            printf("%d %s\n", (int)procs[i].pid, procs[i].cmdline);
+        pid_target_init(&targets[matched++], procs[i].pid, procs[i].starttime);
+    }
+    free(procs);
+    proc_pattern_free(&re);
+
+    if (matched == 0) {
+        printf("pkill: 일치하는 프로세스가 없습니다\n");
+        free(targets);
         return -1;
     }
+    if (opts->list_only) {
+        free(targets);
+        return 0;
+    }
+
+    const char *name = signal_name(opts->sig);
+    size_t sent = pid_batch_signal(targets, matched, opts->sig);
+    size_t gone = 0;
+    for (size_t i = 0; i < matched; i++) {
+        // ESRCH: 목록을 읽은 뒤 끝났거나 pid가 다른 프로세스에 재사용됨
+        if (targets[i].state == PID_TARGET_EXITED || targets[i].error == ESRCH)
+            gone++;
+        else if (targets[i].state == PID_TARGET_FAILED)
+            printf("pkill: PID %d: %s\n", (int)targets[i].pid, strerror(targets[i].error));
+    }
+    printf("프로세스 %zu개에 SIG%s 보냄", sent, name ? name : "?");
+    if (gone) printf(", %zu개는 이미 종료됨", gone);
+    if (sent + gone < matched) printf(", %zu개 실패", matched - sent - gone);
+    printf("\n");
+
+    // -w: 종료를 기다리고, 시간 안에 끝나지 않으면 SIGKILL로 올림
+    if (opts->wait_sec > 0 && sent > 0) {
+        size_t alive = pid_batch_wait(targets, matched, opts->wait_sec * 1000);
+        printf("%zu개 종료됨", sent - alive);
+        if (alive && opts->sig != SIGKILL) {
+            for (size_t i = 0; i < matched; i++) {
+                if (targets[i].state == PID_TARGET_ALIVE)
+                    pid_target_signal(&targets[i], SIGKILL);
+            }
+            printf(", %zu개가 %d초 안에 끝나지 않아 SIGKILL 보냄", alive, opts->wait_sec);
+            alive = pid_batch_wait(targets, matched, PKILL_KILL_WAIT_MS);
+        }
+        printf("\n");
+        if (alive)
+            printf("pkill: %zu개는 아직 종료되지 않았습니다\n", alive);
+    }
+
+    pid_batch_close(targets, matched);
+    free(targets);
+    return 0;
+}
+
+// 지연 히스토그램: 16 미만은 그대로, 그 위는 2의 거듭제곱 구간마다 16칸 (오차 약 6%).
+// 메시지 수와 상관없이 크기가 고정이라 수백만 개를 저장하거나 정렬하지 않아도 됨
+#define LAT_BUCKETS (61 * 16)
+
+static unsigned lat_bucket(uint64_t v) {
+    if (v < 16) return (unsigned)v;
+    unsigned msb = 63 - (unsigned)__builtin_clzll(v);
+    return (msb - 3) * 16 + (unsigned)((v >> (msb - 4)) & 15);
+}
+
+static uint64_t lat_bucket_value(unsigned idx) {
+    if (idx < 16) return idx;
+    unsigned msb = idx / 16 + 3;
+    return (uint64_t)(16 + idx % 16) << (msb - 4);
+}
+
+static uint64_t lat_percentile(const uint64_t *hist, uint64_t total, double q) {
+    uint64_t target = (uint64_t)(q * (double)total + 0.999999);
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < LAT_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= target && seen > 0) return lat_bucket_value(i);
+    }
     return 0;
 }
 
-void execute_program(const char *program_name, char **args) {
-    pid_t pid = fork();
-    
-    if (pid < 0) {
-        perror("fork");
-    } else if (pid == 0) {
-        execvp(program_name, args);
-        perror("execvp");
-        exit(1);
-    } else {
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+struct bench_msg {
+    uint64_t sent_ns;       // CLOCK_MONOTONIC (프로세스 사이에서도 같은 시계)
+    uint64_t seq;           // 생산자별 순번
+    uint32_t producer;
+};
+
+// fork한 생산자: 시작 신호(파이프가 닫힘)를 기다렸다가 count개를 보내고 끝남
+static void bench_producer(struct shm_ring *ring, int start_fd, uint32_t id,
+                           unsigned long count, uint32_t msg_size) {
+    unsigned char buf[MMAP_TEST_MAX_MSG_SIZE];
+    memset(buf, 0xab, msg_size);
+    char c;
+    while (read(start_fd, &c, 1) == -1 && errno == EINTR)
+        ;
+    close(start_fd);
+
+    struct bench_msg m = { 0, 0, id };
+    for (unsigned long i = 0; i < count; i++) {
+        m.seq = i;
+        m.sent_ns = now_ns();
+        memcpy(buf, &m, sizeof(m));
+        // 부모가 사라졌으면 오래 기다리지 않고 끝냄
+        if (shm_ring_send(ring, buf, msg_size, 5000) == -1) _exit(1);
+    }
+    _exit(0);
+}
+
+void mmap_test_default_options(struct mmap_test_options *opts) {
+    opts->messages = MMAP_TEST_DEFAULT_MESSAGES;
+    opts->producers = 1;
+    opts->capacity = MMAP_TEST_DEFAULT_CAPACITY;
+    opts->msg_size = MMAP_TEST_DEFAULT_MSG_SIZE;
+}
+
+int mmap_test_run(const char *filename, const struct mmap_test_options *opts,
+                  struct mmap_test_result *result) {
+    memset(result, 0, sizeof(*result));
+    if (opts->messages == 0 || opts->producers < 1 || opts->producers > MMAP_TEST_MAX_PRODUCERS ||
+        opts->msg_size < sizeof(struct bench_msg) || opts->msg_size > MMAP_TEST_MAX_MSG_SIZE) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    struct shm_ring ring;
+    if (shm_ring_create(&ring, filename, opts->capacity, opts->msg_size,
+                        opts->producers > 1 ? SHM_RING_MPSC : 0) == -1)
+        return -1;
+
+    uint64_t *hist = calloc(LAT_BUCKETS, sizeof(*hist));
+    int start_pipe[2];
+    if (!hist || pipe(start_pipe) == -1) {
+        int saved = hist ? errno : ENOMEM;
+        free(hist);
+        shm_ring_close(&ring);
+        errno = saved;
+        return -1;
+    }
+
+    // 다른 스레드가 띄우는 프로그램이 쓰기 끝을 물려받으면 생산자들이 출발하지 못함
+    fcntl(start_pipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(start_pipe[1], F_SETFD, FD_CLOEXEC);
+
+    result->parent_pid = getpid();
+    result->producers = opts->producers;
+    result->capacity = ring.mask + 1;
+    result->msg_size = opts->msg_size;
+
+    pid_t pids[MMAP_TEST_MAX_PRODUCERS];
+    int started = 0, saved = 0;
+    for (int i = 0; i < opts->producers; i++) {
+        unsigned long count = opts->messages / (unsigned long)opts->producers +
+                              ((unsigned long)i < opts->messages % (unsigned long)opts->producers);
+        pid_t pid = fork();
+        if (pid == -1) {
+            saved = errno;
+            break;
+        }
+        if (pid == 0) {
+            close(start_pipe[1]);
+            bench_producer(&ring, start_pipe[0], (uint32_t)i, count, opts->msg_size);
+        }
+        pids[started++] = pid;
+    }
+    close(start_pipe[0]);
+
+    if (started < opts->producers) {
+        for (int i = 0; i < started; i++) kill(pids[i], SIGKILL);
+        close(start_pipe[1]);
+        for (int i = 0; i < started; i++) waitpid(pids[i], NULL, 0);
+        free(hist);
+        shm_ring_close(&ring);
+        errno = saved;
+        return -1;
+    }
+
+    uint64_t next_seq[MMAP_TEST_MAX_PRODUCERS] = { 0 };
+    unsigned char buf[MMAP_TEST_MAX_MSG_SIZE];
+    int alive = started;
+    uint64_t start = now_ns(), end = start;
+    close(start_pipe[1]);   // 생산자들이 동시에 출발
+
+    while (result->messages < opts->messages) {
+        ssize_t n = shm_ring_recv(&ring, buf, sizeof(buf), 1000);
+        if (n == -1) {
+            // 생산자가 모두 끝난 뒤에도 한 번 더 비어 있었으면 더 올 메시지가 없음
+            if (errno != ETIMEDOUT || alive == 0) break;
+            for (int i = 0; i < started; i++) {
+                if (pids[i] > 0 && waitpid(pids[i], NULL, WNOHANG) == pids[i]) {
+                    pids[i] = -1;
+                    alive--;
+                }
+            }
+            continue;
+        }
+        end = now_ns();
+
+        struct bench_msg m;
+        memcpy(&m, buf, sizeof(m));
+        uint64_t latency = end > m.sent_ns ? end - m.sent_ns : 0;
+        hist[lat_bucket(latency)]++;
+        if (latency > result->max_ns) result->max_ns = latency;
+        if (m.producer >= (uint32_t)started || m.seq != next_seq[m.producer])
+            result->out_of_order++;
+        else
+            next_seq[m.producer]++;
+        result->messages++;
+    }
+    saved = errno;
+
+    int failed = 0;
+    for (int i = 0; i < started; i++) {
         int status;
-        waitpid(pid, &status, 0);
+        if (pids[i] <= 0) continue;
+        if (result->messages < opts->messages) kill(pids[i], SIGKILL);
+        if (waitpid(pids[i], &status, 0) == pids[i] && (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+            failed = 1;
+    }
+
+    struct shm_ring_stats stats;
+    shm_ring_get_stats(&ring, &stats);
+    result->producer_sleeps = stats.producer_sleeps;
+    result->consumer_sleeps = stats.consumer_sleeps;
+    result->elapsed_ms = (double)(end - start) / 1e6;
+    if (result->elapsed_ms > 0) {
+        result->msgs_per_sec = result->messages / (result->elapsed_ms / 1000.0);
+        result->mb_per_sec = result->msgs_per_sec * opts->msg_size / (1024.0 * 1024.0);
+    }
+    result->p50_ns = lat_percentile(hist, result->messages, 0.50);
+    result->p99_ns = lat_percentile(hist, result->messages, 0.99);
+    result->p999_ns = lat_percentile(hist, result->messages, 0.999);
+
+    free(hist);
+    shm_ring_close(&ring);
+    if (result->messages < opts->messages) {
+        errno = failed || saved == ETIMEDOUT ? EPIPE : saved;
+        return -1;
     }
+    return 0;
 }
 
-void call_mmap_test(const char *filename) {
-    int fd = open(filename, O_RDWR | O_CREAT, 0644);
-    if (fd == -1) {
-        perror("open");
+static void format_latency(uint64_t ns, char *buf, size_t size) {
+    if (ns < 1000) snprintf(buf, size, "%lu ns", (unsigned long)ns);
+    else if (ns < 1000000) snprintf(buf, size, "%.1f us", ns / 1e3);
+    else snprintf(buf, size, "%.2f ms", ns / 1e6);
+}
+
+void call_mmap_test(const char *filename, const struct mmap_test_options *opts) {
+    FILE *out = shell_output();
+    struct mmap_test_result result;
+    if (mmap_test_run(filename, opts, &result) == -1) {
+        perror("mmap_test");
         return;
     }
-    
-    if (ftruncate(fd, SHARED_SIZE) == -1) {
-        perror("ftruncate");
-        close(fd);
+
+    char p50[32], p99[32], p999[32], max[32];
+    format_latency(result.p50_ns, p50, sizeof(p50));
+    format_latency(result.p99_ns, p99, sizeof(p99));
+    format_latency(result.p999_ns, p999, sizeof(p999));
+    format_latency(result.max_ns, max, sizeof(max));
+
+    fprintf(out, "링 버퍼: 슬롯 %u개 × %u바이트, 생산자 %d개 (%s), 소비자 PID %d\n",
+            result.capacity, result.msg_size, result.producers,
+            result.producers > 1 ? "MPSC" : "SPSC", result.parent_pid);
+    fprintf(out, "메시지 %lu개, %.1f ms, %.0f msg/s (%.1f MB/s)\n",
+            result.messages, result.elapsed_ms, result.msgs_per_sec, result.mb_per_sec);
+    fprintf(out, "지연 p50 %s, p99 %s, p999 %s, 최대 %s\n", p50, p99, p999, max);
+    fprintf(out, "futex 대기: 생산자 %lu번, 소비자 %lu번, 순서 어긋남 %lu개\n",
+            (unsigned long)result.producer_sleeps, (unsigned long)result.consumer_sleeps,
+            result.out_of_order);
+}
+
+void call_stat_bench(const char *current_dir, const char *path) {
+    char abs_path[MAX_PATH_SIZE];
+    get_absolute_path(current_dir, path ? path : ".", abs_path);
+
+    if (!is_within_base_dir(abs_path)) {
+        printf("오류: %s 외부의 디렉토리에 접근할 수 없습니다\n", BASE_DIR);
         return;
     }
 
-    char *shared_memory = mmap(NULL, SHARED_SIZE, 
-                             PROT_READ | PROT_WRITE, 
-                             MAP_SHARED, fd, 0);
-    if (shared_memory == MAP_FAILED) {
-        perror("mmap");
-        close(fd);
-        return;
+    printf("%s: 워커 수별 메타데이터 조회 시간\n", abs_path);
+    printf("WORKERS  ENTRIES      TIME(ms)  SPEEDUP\n");
+
+    double base_ms = 0;
+    for (int workers = 1; workers <= 16; workers *= 2) {
+        struct dir_listing listing;
+        if (dir_listing_open(&listing, abs_path, DIRSCAN_SKIP_DOTS) == -1) {
+            perror(abs_path);
+            return;
+        }
+        listing.workers = workers;
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        dir_listing_fetch(&listing, 0, listing.count, DIRSCAN_NEED_ALL);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double ms = elapsed_ms(&start, &end);
+        if (workers == 1) base_ms = ms;
+        printf("%7d %8zu %13.2f %7.2fx\n", workers, listing.count, ms,
+               ms > 0 ? base_ms / ms : 0.0);
+        dir_listing_free(&listing);
     }
+}
 
-    struct sigaction sa;
-    sa.sa_handler = handle_usr1;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
-    if (sigaction(SIGUSR1, &sa, NULL) == -1) {
-        perror("sigaction");
-        munmap(shared_memory, SHARED_SIZE);
-        close(fd);
+void call_du(const char *current_dir, const char *path, const struct du_options *opts,
+             int apparent, int human) {
+    char abs_path[MAX_PATH_SIZE];
+    get_absolute_path(current_dir, path ? path : ".", abs_path);
+
+    if (!is_within_base_dir(abs_path)) {
+        printf("오류: %s 외부의 디렉토리는 집계할 수 없습니다\n", BASE_DIR);
         return;
     }
 
-    pid_t pid = fork();
-    if (pid < 0) {
-        perror("fork");
-        munmap(shared_memory, SHARED_SIZE);
-        close(fd);
+    struct du_result result;
+    if (du_scan(abs_path, opts, &result) == -1 && result.count == 0) {
+        perror(abs_path);
+        du_result_free(&result);
         return;
-    } else if (pid == 0) {  // 자식 프로세스
-        // 시그널 핸들러 재설정
-        struct sigaction sa;
-        sa.sa_handler = handle_usr1;
-        sigemptyset(&sa.sa_mask);
-        sa.sa_flags = 0;
-        sigaction(SIGUSR1, &sa, NULL);
-        
-        printf("자식 프로세스 시작 (PID: %d)\n", getpid());
-        data_ready = 0;
-        while (!data_ready) {
-            pause();
-        }
-        printf("자식: 읽은 메시지 - %s\n", shared_memory);
-        
-        strcpy(shared_memory, "자식이 응답합니다");
-        kill(getppid(), SIGUSR1);
-        
-        munmap(shared_memory, SHARED_SIZE);
-        close(fd);
-        exit(0);
-    } else {  // 부모 프로세스
-        printf("부모 프로세스 시작 (PID: %d)\n", getpid());
-        usleep(100000);  // 0.1초 대기
-        strcpy(shared_memory, "부모가 보낸 메시지");
-        kill(pid, SIGUSR1);
-        
-        data_ready = 0;
-        while (!data_ready) {
-            pause();
-        }
-        printf("부모: 읽은 응답 - %s\n", shared_memory);
-        
-        wait(NULL);
-        munmap(shared_memory, SHARED_SIZE);
-        close(fd);
     }
+
+    // 결과 경로의 루트 부분을 사용자가 입력한 경로로 바꿔서 출력
+    FILE *out = shell_output();
+    const char *shown = path ? path : ".";
+    size_t root_len = strlen(result.entries[result.count - 1].path);
+    for (size_t i = 0; i < result.count; i++) {
+        const struct du_entry *e = &result.entries[i];
+        unsigned long long size = apparent ? e->bytes : e->blocks;
+        char buf[32];
+        if (human)
+            du_format_size(size, buf);
+        else
+            snprintf(buf, sizeof(buf), "%llu", apparent ? size : (size + 1023) / 1024);
+        fprintf(out, "%s\t%s%s\n", buf, shown, e->path + root_len);
+    }
+
+    if (result.errors) {
+        printf("du: %s\n", result.error);
+        if (result.errors > 1)
+            printf("du: 그 외 %llu개 항목을 읽지 못했습니다\n", result.errors - 1);
+        printf("du: 일부 항목이 빠져 합계가 실제보다 작습니다\n");
+    }
+    du_result_free(&result);
 }
 
-void remove_directory_recursive(const char *path) {
-    DIR *d = opendir(path);
-    if (!d) return;
+// 결과 경로의 검색 시작 부분을 사용자가 입력한 경로로 바꿔서 출력
+struct grep_print_ctx {
+    size_t root_len;
+    const char *shown;
+    FILE *out;           // 결과는 워커 스레드에서 오므로 호출한 스레드의 스트림을 넘겨 둠
+};
+
+static int print_grep_hit(void *ctx, const char *path, unsigned long line,
+                          const char *text, size_t len) {
+    const struct grep_print_ctx *print = ctx;
+    fprintf(print->out, "%s%s:%lu:%.*s\n", print->shown, path + print->root_len, line, (int)len, text);
+    return 0;
+}
 
-    struct dirent *ent;
-    while ((ent = readdir(d))) {
-        // "." 와 ".." 디렉토리는 건너뜀
-        if (!strcmp(ent->d_name, ".") || !strcmp(ent->d_name, ".."))
-            continue;
+static int print_grep_line(void *ctx, const char *path, unsigned long line,
+                           const char *text, size_t len) {
+    (void)path; (void)line;
+    fprintf((FILE *)ctx, "%.*s\n", (int)len, text);
+    return 0;
+}
+
+static void report_grep_stats(const struct grep_stats *stats, const struct grep_options *opts) {
+    if (stats->truncated)
+        printf("grep: 최대 %llu개까지만 표시했습니다\n", opts->max_matches);
+    if (stats->skipped_binary || stats->skipped_large)
+        printf("grep: 바이너리 파일 %llu개, 큰 파일 %llu개를 건너뛰었습니다\n",
+               stats->skipped_binary, stats->skipped_large);
+    if (stats->errors) {
+        printf("grep: %s\n", stats->error);
+        if (stats->errors > 1)
+            printf("grep: 그 외 %llu개 파일을 읽지 못했습니다\n", stats->errors - 1);
+    }
+}
 
-        char full_path[MAX_PATH_SIZE];
-        snprintf(full_path, sizeof(full_path), "%s/%s", path, ent->d_name);
+void call_grep(const char *current_dir, const char *pattern, const char *path,
+               const struct grep_options *opts) {
+    char abs_path[MAX_PATH_SIZE];
+    get_absolute_path(current_dir, path ? path : ".", abs_path);
 
-        struct stat st;
-        if (lstat(full_path, &st) == -1)
-            continue;
+    if (!is_within_base_dir(abs_path)) {
+        printf("오류: %s 외부의 파일은 검색할 수 없습니다\n", BASE_DIR);
+        return;
+    }
 
-        if (S_ISDIR(st.st_mode)) {
-            // 디렉토인 경우 재적으로 삭제
-            remove_directory_recursive(full_path);
-        } else {
-            // 파일인 경우 삭제
-            unlink(full_path);
-        }
+    struct grep_print_ctx print = { strlen(abs_path), path ? path : ".", shell_output() };
+    const char *paths[] = { abs_path };
+    struct grep_stats stats;
+    if (grep_run(paths, 1, pattern, opts, print_grep_hit, &print, NULL, &stats) == -1) {
+        if (stats.error[0])
+            printf("grep: %s\n", stats.error);
+        else
+            perror("grep");
+        return;
+    }
+    report_grep_stats(&stats, opts);
+}
+
+int call_grep_fd(int fd, const char *pattern, const struct grep_options *opts) {
+    struct grep_stats stats;
+    if (grep_fd(fd, "(표준 입력)", pattern, opts, print_grep_line, shell_output(), NULL, &stats) == -1) {
+        if (stats.error[0])
+            printf("grep: %s\n", stats.error);
+        else
+            perror("grep");
+        return -1;
     }
-    closedir(d);
-    rmdir(path);  // 빈 디렉토리 삭제
+    report_grep_stats(&stats, opts);
+    return stats.matches > 0 ? 0 : 1;
+}
+
+int remove_directory_recursive(const char *path) {
+    return remove_tree(path, 0, NULL, NULL, 0);
 }
 
 mode_t parse_mode_str(const char *mode_str, mode_t current_mode) {
@@ -0,0 +1,822 @@
+#define _GNU_SOURCE
+#include "../include/copy.h"
+#include "../include/dirscan.h"
+#include "../include/remove.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+
+// 한 번의 시스템 호출로 넘길 최대 크기
+#define COPY_CHUNK  (8 * 1024 * 1024)
+
+// 이 오류들은 "이 방식은 지원하지 않음"을 뜻하므로 다음 방식으로 넘어감
+static int is_unsupported(int err) {
+    return err == EXDEV || err == ENOSYS || err == EOPNOTSUPP ||
+           err == EINVAL || err == ENOTSUP || err == EBADF || err == ETXTBSY;
+}
+
+static void add_progress(struct copy_stats *stats, ssize_t n) {
+    stats->bytes += (unsigned long long)n;
+    if (stats->progress)
+        __atomic_add_fetch(stats->progress, (unsigned long long)n, __ATOMIC_RELAXED);
+}
+
+static int is_canceled(const struct copy_stats *stats) {
+    if (stats->cancel && __atomic_load_n(stats->cancel, __ATOMIC_RELAXED)) {
+        errno = ECANCELED;
+        return 1;
+    }
+    return 0;
+}
+
+// 반환값: 1 = 끝까지 복사, 0 = 이 방식 사용 불가 (오프셋은 복사한 만큼 진행됨), -1 = 오류
+static int try_copy_file_range(int in_fd, int out_fd, struct copy_stats *stats) {
+    int copied_any = 0;
+    for (;;) {
+        if (is_canceled(stats)) return -1;
+        ssize_t n = copy_file_range(in_fd, NULL, out_fd, NULL, COPY_CHUNK, 0);
+        if (n > 0) {
+            add_progress(stats, n);
+            copied_any = 1;
+            continue;
+        }
+        if (n == 0) {
+            // 일부 커널은 procfs 등 특수 파일에서 바로 0을 반환하므로 다른 방식으로 재확인
+            return copied_any ? 1 : 0;
+        }
+        if (errno == EINTR) continue;
+        return is_unsupported(errno) ? 0 : -1;
+    }
+}
+
+static int try_sendfile(int in_fd, int out_fd, struct copy_stats *stats) {
+    int copied_any = 0;
+    for (;;) {
+        if (is_canceled(stats)) return -1;
+        ssize_t n = sendfile(out_fd, in_fd, NULL, COPY_CHUNK);
+        if (n > 0) {
+            add_progress(stats, n);
+            copied_any = 1;
+            continue;
+        }
+        if (n == 0)
+            return copied_any ? 1 : 0;
+        if (errno == EINTR) continue;
+        return is_unsupported(errno) ? 0 : -1;
+    }
+}
+
+static int copy_with_buffer(int in_fd, int out_fd, struct copy_stats *stats) {
+    void *buf;
+    if (posix_memalign(&buf, COPY_BUF_ALIGN, COPY_BUF_SIZE) != 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (;;) {
+        if (is_canceled(stats)) goto fail;
+        ssize_t n = read(in_fd, buf, COPY_BUF_SIZE);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            goto fail;
+        }
+
+        // 짧은 쓰기 처리
+        ssize_t off = 0;
+        while (off < n) {
+            ssize_t w = write(out_fd, (char *)buf + off, (size_t)(n - off));
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                goto fail;
+            }
+            off += w;
+        }
+        add_progress(stats, n);
+    }
+
+    free(buf);
+    return 0;
+
+fail: {
+        int saved = errno;
+        free(buf);
+        errno = saved;
+        return -1;
+    }
+}
+
+// copy_file_range -> sendfile -> 버퍼 순서로 시도. 파일 오프셋을 공유하므로
+// 앞 방식이 중간에 실패해도 다음 방식이 이어서 복사함
+int copy_fd(int in_fd, int out_fd, struct copy_stats *stats) {
+    struct copy_stats local = {0};
+    if (!stats) stats = &local;
+    stats->bytes = 0;
+    stats->method = COPY_METHOD_NONE;
+
+    int r = try_copy_file_range(in_fd, out_fd, stats);
+    if (r != 0) {
+        stats->method = COPY_METHOD_RANGE;
+        return r == 1 ? 0 : -1;
+    }
+
+    r = try_sendfile(in_fd, out_fd, stats);
+    if (r != 0) {
+        stats->method = COPY_METHOD_SENDFILE;
+        return r == 1 ? 0 : -1;
+    }
+
+    stats->method = COPY_METHOD_BUFFER;
+    return copy_with_buffer(in_fd, out_fd, stats);
+}
+
+int copy_file(const char *src, const char *dst, struct copy_stats *stats) {
+    int in_fd = open(src, O_RDONLY | O_CLOEXEC);
+    if (in_fd == -1) return -1;
+
+    struct stat src_st, dst_st;
+    if (fstat(in_fd, &src_st) == -1) goto fail_in;
+
+    // 원본과 대상이 같은 파일이면 O_TRUNC가 원본을 지우므로 거부
+    if (stat(dst, &dst_st) == 0 && dst_st.st_dev == src_st.st_dev &&
+        dst_st.st_ino == src_st.st_ino) {
+        errno = EINVAL;
+        goto fail_in;
+    }
+
+    int out_fd = open(dst, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, src_st.st_mode & 0777);
+    if (out_fd == -1) goto fail_in;
+
+    if (copy_fd(in_fd, out_fd, stats) == -1) {
+        int saved = errno;
+        close(out_fd);
+        close(in_fd);
+        errno = saved;
+        return -1;
+    }
+
+    close(in_fd);
+    return close(out_fd);
+
+fail_in: {
+        int saved = errno;
+        close(in_fd);
+        errno = saved;
+        return -1;
+    }
+}
+
+const char *copy_method_name(enum copy_method method) {
+    switch (method) {
+    case COPY_METHOD_RANGE:    return "copy_file_range";
+    case COPY_METHOD_SENDFILE: return "sendfile";
+    case COPY_METHOD_BUFFER:   return "read/write";
+    default:                   return "none";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 병렬 트리 복사: 탐색 스레드 하나가 디렉토리를 만들고 파일 작업을 워커별 덱에
+// 나눠 넣으면, 워커는 자기 덱의 뒤에서 꺼내고 비면 다른 워커 덱의 앞에서 훔쳐 감
+// ---------------------------------------------------------------------------
+
+// 이동 작업에서 최상위 항목별 처리 상태
+enum root_state {
+    ROOT_PENDING = 0,
+    ROOT_RENAMED,       // 같은 장치: rename 한 번으로 끝남
+    ROOT_COPYING,       // 다른 장치: 복사 후 검증, 원본 삭제 또는 롤백 필요
+    ROOT_FAILED
+};
+
+struct copy_task {
+    char *src;
+    char *dst;
+    size_t root;        // 이 파일이 속한 최상위 항목 번호
+};
+
+struct task_deque {
+    pthread_mutex_t lock;
+    struct copy_task *items;    // 원형 버퍼
+    size_t head;
+    size_t count;
+    size_t capacity;
+};
+
+struct copy_job {
+    char **sources;
+    char **targets;
+    size_t nroots;
+    int flags;                  // COPY_JOB_*
+    enum root_state *root_state;
+    unsigned *root_errors;      // 최상위 항목별 오류 수 (롤백 판단용)
+
+    int nworkers;
+    int ndeques;
+    struct task_deque *deques;
+    pthread_t walker;
+    pthread_t *workers;
+    size_t next_deque;          // 탐색 스레드의 라운드 로빈 위치
+
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+    size_t pending;             // 덱에 남아 있는 작업 수 (idle_lock으로 보호)
+    int walk_done;
+    int cancel;
+    int running_workers;
+
+    unsigned long long files_total;
+    unsigned long long files_done;
+    unsigned long long bytes_total;
+    unsigned long long bytes_done;
+    unsigned long long errors;
+    int finished;
+
+    pthread_mutex_t error_lock;
+    char error[MAX_PATH_SIZE * 2];
+};
+
+static void job_record_error(struct copy_job *job, size_t root, const char *path, int err) {
+    __atomic_add_fetch(&job->errors, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&job->root_errors[root], 1, __ATOMIC_RELAXED);
+    if (err == ECANCELED) return;
+    pthread_mutex_lock(&job->error_lock);
+    if (job->error[0] == '\0')
+        snprintf(job->error, sizeof(job->error), "%s: %s", path, strerror(err));
+    pthread_mutex_unlock(&job->error_lock);
+}
+
+static int job_canceled(const struct copy_job *job) {
+    return __atomic_load_n(&job->cancel, __ATOMIC_RELAXED);
+}
+
+static char *join_path(const char *dir, const char *name) {
+    size_t dlen = strlen(dir), nlen = strlen(name);
+    char *p = malloc(dlen + nlen + 2);
+    if (!p) return NULL;
+    memcpy(p, dir, dlen);
+    p[dlen] = '/';
+    memcpy(p + dlen + 1, name, nlen + 1);
+    return p;
+}
+
+static int deque_push_back(struct task_deque *d, struct copy_task task) {
+    pthread_mutex_lock(&d->lock);
+    if (d->count == d->capacity) {
+        size_t new_capacity = d->capacity ? d->capacity * 2 : 64;
+        struct copy_task *grown = malloc(new_capacity * sizeof(*grown));
+        if (!grown) {
+            pthread_mutex_unlock(&d->lock);
+            return -1;
+        }
+        for (size_t i = 0; i < d->count; i++)
+            grown[i] = d->items[(d->head + i) % d->capacity];
+        free(d->items);
+        d->items = grown;
+        d->head = 0;
+        d->capacity = new_capacity;
+    }
+    d->items[(d->head + d->count) % d->capacity] = task;
+    d->count++;
+    pthread_mutex_unlock(&d->lock);
+    return 0;
+}
+
+// 자기 덱은 뒤에서 (최근 작업), 훔칠 때는 앞에서 (오래된 작업) 꺼냄
+static int deque_pop(struct task_deque *d, struct copy_task *task, int from_front) {
+    pthread_mutex_lock(&d->lock);
+    if (d->count == 0) {
+        pthread_mutex_unlock(&d->lock);
+        return 0;
+    }
+    if (from_front) {
+        *task = d->items[d->head];
+        d->head = (d->head + 1) % d->capacity;
+    } else {
+        *task = d->items[(d->head + d->count - 1) % d->capacity];
+    }
+    d->count--;
+    pthread_mutex_unlock(&d->lock);
+    return 1;
+}
+
+static void job_push_task(struct copy_job *job, size_t root, char *src, char *dst, off_t size) {
+    struct copy_task task = { src, dst, root };
+    struct task_deque *d = &job->deques[job->next_deque];
+    job->next_deque = (job->next_deque + 1) % (size_t)job->nworkers;
+
+    // 덱에 넣는 순간 워커가 훔쳐 가서 pending--를 할 수 있으므로 먼저 늘려 둠
+    pthread_mutex_lock(&job->idle_lock);
+    job->pending++;
+    pthread_mutex_unlock(&job->idle_lock);
+
+    if (deque_push_back(d, task) == -1) {
+        pthread_mutex_lock(&job->idle_lock);
+        job->pending--;
+        pthread_mutex_unlock(&job->idle_lock);
+        job_record_error(job, root, src, ENOMEM);
+        free(src);
+        free(dst);
+        return;
+    }
+    __atomic_add_fetch(&job->files_total, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&job->bytes_total, (unsigned long long)size, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&job->idle_lock);
+    pthread_cond_signal(&job->idle_cond);
+    pthread_mutex_unlock(&job->idle_lock);
+}
+
+static void copy_symlink(struct copy_job *job, size_t root, const char *src, const char *dst) {
+    char target[4096];
+    ssize_t len = readlink(src, target, sizeof(target) - 1);
+    if (len == -1) {
+        job_record_error(job, root, src, errno);
+        return;
+    }
+    target[len] = '\0';
+    if (symlink(target, dst) == -1 && errno != EEXIST)
+        job_record_error(job, root, dst, errno);
+}
+
+// 디렉토리를 만들고 하위 항목을 작업으로 분배 (재귀 대신 명시적 스택 사용)
+static void walk_tree(struct copy_job *job, size_t root, const char *src_root, const char *dst_root) {
+    size_t stack_len = 0, stack_cap = 16;
+    char **stack = malloc(stack_cap * 2 * sizeof(char *));
+    if (!stack) {
+        job_record_error(job, root, src_root, ENOMEM);
+        return;
+    }
+    stack[0] = strdup(src_root);
+    stack[1] = strdup(dst_root);
+    stack_len = 1;
+
+    while (stack_len > 0 && !job_canceled(job)) {
+        stack_len--;
+        char *src = stack[stack_len * 2];
+        char *dst = stack[stack_len * 2 + 1];
+        if (!src || !dst) {
+            job_record_error(job, root, src_root, ENOMEM);
+            free(src);
+            free(dst);
+            continue;
+        }
+
+        struct stat st;
+        if (stat(src, &st) == -1) {
+            job_record_error(job, root, src, errno);
+        } else if (mkdir(dst, (st.st_mode & 0777) | S_IRWXU) == -1 && errno != EEXIST) {
+            job_record_error(job, root, dst, errno);
+        } else {
+            struct dir_listing listing;
+            if (dir_listing_open(&listing, src, DIRSCAN_SKIP_DOTS) == -1) {
+                job_record_error(job, root, src, errno);
+            } else {
+                // 크기는 진행률 합계용: 디렉토리 단위로 한 번에 (병렬) 조회
+                dir_listing_fetch(&listing, 0, listing.count, DIRSCAN_NEED_TYPE | DIRSCAN_NEED_SIZE);
+                for (size_t i = 0; i < listing.count && !job_canceled(job); i++) {
+                    struct dir_entry *e = &listing.entries[i];
+                    const char *name = dir_entry_name(&listing, e);
+                    if (e->error) {
+                        job_record_error(job, root, name, e->error);
+                        continue;
+                    }
+
+                    char *child_src = join_path(src, name);
+                    char *child_dst = join_path(dst, name);
+                    if (!child_src || !child_dst) {
+                        job_record_error(job, root, name, ENOMEM);
+                        free(child_src);
+                        free(child_dst);
+                        continue;
+                    }
+
+                    if (dir_entry_is_dir(e)) {
+                        if (stack_len == stack_cap) {
+                            char **grown = realloc(stack, stack_cap * 4 * sizeof(char *));
+                            if (!grown) {
+                                job_record_error(job, root, child_src, ENOMEM);
+                                free(child_src);
+                                free(child_dst);
+                                continue;
+                            }
+                            stack = grown;
+                            stack_cap *= 2;
+                        }
+                        stack[stack_len * 2] = child_src;
+                        stack[stack_len * 2 + 1] = child_dst;
+                        stack_len++;
+                    } else if (e->d_type == DT_LNK || S_ISLNK(e->mode)) {
+                        copy_symlink(job, root, child_src, child_dst);
+                        free(child_src);
+                        free(child_dst);
+                    } else {
+                        job_push_task(job, root, child_src, child_dst, e->size);
+                    }
+                }
+                dir_listing_free(&listing);
+            }
+        }
+        free(src);
+        free(dst);
+    }
+
+    // 취소로 남은 스택 정리
+    while (stack_len > 0) {
+        stack_len--;
+        free(stack[stack_len * 2]);
+        free(stack[stack_len * 2 + 1]);
+    }
+    free(stack);
+}
+
+// 대상이 원본 트리 안에 있으면 끝없이 복사하게 되므로 거부. 문자열 비교로는 "..", 심볼릭 링크,
+// 상대/절대 경로 차이를 놓치므로, 대상 경로에서 이미 있는 가장 가까운 디렉토리부터 ".."를 따라
+// 루트까지 올라가며 원본 디렉토리와 같은 (st_dev, st_ino)가 나오는지 확인
+static int is_inside(const char *path, const struct stat *dir_st) {
+    if (path[0] == '\0') return 0;
+    char *probe = strdup(path);
+    if (!probe) return 0;
+
+    int fd;
+    while ((fd = open(probe, O_PATH | O_DIRECTORY | O_CLOEXEC)) == -1) {
+        char *slash = strrchr(probe, '/');
+        if (!slash) {
+            if (strcmp(probe, ".") == 0) break;
+            strcpy(probe, ".");
+        } else if (slash == probe) {
+            if (probe[1] == '\0') break;
+            probe[1] = '\0';
+        } else {
+            *slash = '\0';
+        }
+    }
+    free(probe);
+
+    int inside = 0;
+    struct stat st;
+    while (fd != -1 && fstat(fd, &st) == 0) {
+        if (st.st_dev == dir_st->st_dev && st.st_ino == dir_st->st_ino) {
+            inside = 1;
+            break;
+        }
+        int parent = openat(fd, "..", O_PATH | O_DIRECTORY | O_CLOEXEC);
+        close(fd);
+        fd = parent;
+
+        // 루트의 ".."는 자기 자신
+        struct stat parent_st;
+        if (fd != -1 && fstat(fd, &parent_st) == 0 &&
+            parent_st.st_dev == st.st_dev && parent_st.st_ino == st.st_ino)
+            break;
+    }
+    if (fd != -1) close(fd);
+    return inside;
+}
+
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+
+// 대상이 이미 있으면 EEXIST로 실패하는 rename
+static int rename_noreplace(const char *src, const char *dst) {
+#ifdef SYS_renameat2
+    if (syscall(SYS_renameat2, AT_FDCWD, src, AT_FDCWD, dst, RENAME_NOREPLACE) == 0)
+        return 0;
+    if (errno != ENOSYS && errno != EINVAL)
+        return -1;
+#endif
+    // renameat2나 RENAME_NOREPLACE를 지원하지 않는 경우: 확인 후 rename
+    struct stat st;
+    if (lstat(dst, &st) == 0) {
+        errno = EEXIST;
+        return -1;
+    }
+    return rename(src, dst);
+}
+
+// 이동 작업의 최상위 항목 처리: 같은 장치면 rename으로 끝내고, 다른 장치면 복사로 넘김
+static int walker_try_rename(struct copy_job *job, size_t root) {
+    const char *src = job->sources[root];
+    const char *dst = job->targets[root];
+
+    if (rename_noreplace(src, dst) == 0) {
+        job->root_state[root] = ROOT_RENAMED;
+        __atomic_add_fetch(&job->files_total, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&job->files_done, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    if (errno != EXDEV) {
+        job_record_error(job, root, errno == EEXIST ? dst : src, errno);
+        job->root_state[root] = ROOT_FAILED;
+        return 1;
+    }
+
+    // 복사 결과물은 전부 이 작업이 만든 것이어야 롤백할 수 있음
+    struct stat st;
+    if (lstat(dst, &st) == 0) {
+        job_record_error(job, root, dst, EEXIST);
+        job->root_state[root] = ROOT_FAILED;
+        return 1;
+    }
+    job->root_state[root] = ROOT_COPYING;
+    return 0;
+}
+
+static void *walker_main(void *arg) {
+    struct copy_job *job = arg;
+
+    for (size_t root = 0; root < job->nroots && !job_canceled(job); root++) {
+        struct stat st;
+        if (lstat(job->sources[root], &st) == -1) {
+            job_record_error(job, root, job->sources[root], errno);
+            job->root_state[root] = ROOT_FAILED;
+            continue;
+        }
+        if ((job->flags & COPY_JOB_MOVE) && walker_try_rename(job, root))
+            continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            if (is_inside(job->targets[root], &st)) {
+                job_record_error(job, root, job->targets[root], EINVAL);
+                continue;
+            }
+            walk_tree(job, root, job->sources[root], job->targets[root]);
+        } else if (S_ISLNK(st.st_mode)) {
+            copy_symlink(job, root, job->sources[root], job->targets[root]);
+        } else {
+            char *src = strdup(job->sources[root]);
+            char *dst = strdup(job->targets[root]);
+            if (!src || !dst) {
+                job_record_error(job, root, job->sources[root], ENOMEM);
+                free(src);
+                free(dst);
+                continue;
+            }
+            job_push_task(job, root, src, dst, st.st_size);
+        }
+    }
+
+    pthread_mutex_lock(&job->idle_lock);
+    job->walk_done = 1;
+    pthread_cond_broadcast(&job->idle_cond);
+    pthread_mutex_unlock(&job->idle_lock);
+    return NULL;
+}
+
+static int job_take_task(struct copy_job *job, int id, struct copy_task *task) {
+    if (deque_pop(&job->deques[id], task, 0))
+        return 1;
+    for (int i = 1; i < job->nworkers; i++) {
+        if (deque_pop(&job->deques[(id + i) % job->nworkers], task, 1))
+            return 1;
+    }
+    return 0;
+}
+
+// 이동 중인 파일 검증: 원본이 복사 도중 바뀌지 않았고 대상 크기가 같아야 함
+static int verify_copy(const struct stat *before, const char *src, const char *dst,
+                       unsigned long long copied) {
+    struct stat after, target;
+    if (lstat(src, &after) == -1 || stat(dst, &target) == -1)
+        return -1;
+    if (after.st_size != before->st_size || after.st_mtim.tv_sec != before->st_mtim.tv_sec ||
+        after.st_mtim.tv_nsec != before->st_mtim.tv_nsec ||
+        target.st_size != before->st_size || copied != (unsigned long long)before->st_size) {
+        errno = EIO;
+        return -1;
+    }
+
+    // 이동이므로 시간 정보도 원본과 같게 맞춤
+    struct timespec times[2] = { before->st_atim, before->st_mtim };
+    utimensat(AT_FDCWD, dst, times, 0);
+    return 0;
+}
+
+static void run_task(struct copy_job *job, struct copy_task *task) {
+    size_t root = task->root;
+    int move = job->flags & COPY_JOB_MOVE;
+    struct stat before;
+    if (move && lstat(task->src, &before) == -1) {
+        job_record_error(job, root, task->src, errno);
+        return;
+    }
+
+    struct copy_stats stats = {0};
+    stats.progress = &job->bytes_done;
+    stats.cancel = &job->cancel;
+    if (copy_file(task->src, task->dst, &stats) == -1 ||
+        (move && verify_copy(&before, task->src, task->dst, stats.bytes) == -1)) {
+        int err = errno;
+        job_record_error(job, root, task->src, err);
+        // 중간에 멈춘 파일은 남기지 않음
+        if (err == ECANCELED)
+            unlink(task->dst);
+        return;
+    }
+    __atomic_add_fetch(&job->files_done, 1, __ATOMIC_RELAXED);
+}
+
+// 모든 워커가 끝난 뒤 이동 작업 마무리: 성공한 항목은 원본 삭제, 실패/취소는 대상 삭제
+static void finish_move(struct copy_job *job) {
+    int canceled = job_canceled(job);
+    for (size_t root = 0; root < job->nroots; root++) {
+        if (job->root_state[root] != ROOT_COPYING)
+            continue;
+        if (canceled || job->root_errors[root] > 0) {
+            remove_tree(job->targets[root], 0, NULL, NULL, 0);
+            job->root_state[root] = ROOT_FAILED;
+        } else if (remove_tree(job->sources[root], 0, NULL, NULL, 0) == -1) {
+            // 대상은 완전하므로 원본 일부가 남는 것만 보고
+            job_record_error(job, root, job->sources[root], errno);
+        }
+    }
+}
+
+struct worker_arg {
+    struct copy_job *job;
+    int id;
+};
+
+static void *worker_main(void *arg) {
+    struct copy_job *job = ((struct worker_arg *)arg)->job;
+    int id = ((struct worker_arg *)arg)->id;
+    free(arg);
+
+    for (;;) {
+        struct copy_task task;
+        if (job_take_task(job, id, &task)) {
+            pthread_mutex_lock(&job->idle_lock);
+            job->pending--;
+            pthread_mutex_unlock(&job->idle_lock);
+
+            if (!job_canceled(job))
+                run_task(job, &task);
+            free(task.src);
+            free(task.dst);
+            continue;
+        }
+
+        pthread_mutex_lock(&job->idle_lock);
+        while (job->pending == 0 && !job->walk_done)
+            pthread_cond_wait(&job->idle_cond, &job->idle_lock);
+        int done = job->pending == 0 && job->walk_done;
+        pthread_mutex_unlock(&job->idle_lock);
+        if (done) break;
+    }
+
+    pthread_mutex_lock(&job->idle_lock);
+    int last = --job->running_workers == 0;
+    pthread_mutex_unlock(&job->idle_lock);
+
+    if (last) {
+        if (job->flags & COPY_JOB_MOVE)
+            finish_move(job);
+        __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+struct copy_job *copy_job_start(const char *const *sources, const char *const *targets,
+                                size_t n, int workers, int flags) {
+    if (workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (workers > COPY_MAX_WORKERS) workers = COPY_MAX_WORKERS;
+
+    struct copy_job *job = calloc(1, sizeof(*job));
+    if (!job) return NULL;
+    job->nroots = n;
+    job->flags = flags;
+    job->nworkers = workers;
+    job->sources = calloc(n ? n : 1, sizeof(char *));
+    job->targets = calloc(n ? n : 1, sizeof(char *));
+    job->root_state = calloc(n ? n : 1, sizeof(*job->root_state));
+    job->root_errors = calloc(n ? n : 1, sizeof(*job->root_errors));
+    job->deques = calloc((size_t)workers, sizeof(*job->deques));
+    job->workers = calloc((size_t)workers, sizeof(pthread_t));
+    if (!job->sources || !job->targets || !job->root_state || !job->root_errors ||
+        !job->deques || !job->workers)
+        goto fail;
+    for (size_t i = 0; i < n; i++) {
+        job->sources[i] = strdup(sources[i]);
+        job->targets[i] = strdup(targets[i]);
+        if (!job->sources[i] || !job->targets[i])
+            goto fail;
+    }
+    for (int i = 0; i < workers; i++)
+        pthread_mutex_init(&job->deques[i].lock, NULL);
+    job->ndeques = workers;
+    pthread_mutex_init(&job->idle_lock, NULL);
+    pthread_cond_init(&job->idle_cond, NULL);
+    pthread_mutex_init(&job->error_lock, NULL);
+
+    job->running_workers = workers;
+    for (int i = 0; i < workers; i++) {
+        struct worker_arg *arg = malloc(sizeof(*arg));
+        if (arg) {
+            arg->job = job;
+            arg->id = i;
+        }
+        if (!arg || pthread_create(&job->workers[i], NULL, worker_main, arg) != 0) {
+            free(arg);
+            // 만들지 못한 워커 수만큼 줄여서 계속 진행
+            pthread_mutex_lock(&job->idle_lock);
+            job->running_workers -= workers - i;
+            pthread_mutex_unlock(&job->idle_lock);
+            job->nworkers = i;
+            break;
+        }
+    }
+    if (job->nworkers == 0) {
+        errno = EAGAIN;
+        goto fail;
+    }
+    if (pthread_create(&job->walker, NULL, walker_main, job) != 0) {
+        // 탐색 스레드 없이 워커들이 끝나도록 함
+        pthread_mutex_lock(&job->idle_lock);
+        job->walk_done = 1;
+        pthread_cond_broadcast(&job->idle_cond);
+        pthread_mutex_unlock(&job->idle_lock);
+        for (int i = 0; i < job->nworkers; i++)
+            pthread_join(job->workers[i], NULL);
+        errno = EAGAIN;
+        goto fail;
+    }
+    return job;
+
+fail:
+    copy_job_free(job);
+    return NULL;
+}
+
+void copy_job_progress(struct copy_job *job, struct copy_progress *out) {
+    out->files_total = __atomic_load_n(&job->files_total, __ATOMIC_RELAXED);
+    out->files_done = __atomic_load_n(&job->files_done, __ATOMIC_RELAXED);
+    out->bytes_total = __atomic_load_n(&job->bytes_total, __ATOMIC_RELAXED);
+    out->bytes_done = __atomic_load_n(&job->bytes_done, __ATOMIC_RELAXED);
+    out->errors = __atomic_load_n(&job->errors, __ATOMIC_RELAXED);
+    out->finished = __atomic_load_n(&job->finished, __ATOMIC_ACQUIRE);
+}
+
+void copy_job_cancel(struct copy_job *job) {
+    __atomic_store_n(&job->cancel, 1, __ATOMIC_RELAXED);
+}
+
+int copy_job_wait(struct copy_job *job) {
+    pthread_join(job->walker, NULL);
+    for (int i = 0; i < job->nworkers; i++)
+        pthread_join(job->workers[i], NULL);
+    job->nworkers = 0;
+    __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+
+    if (job_canceled(job)) {
+        errno = ECANCELED;
+        return -1;
+    }
+    return job->errors ? -1 : 0;
+}
+
+const char *copy_job_error(struct copy_job *job) {
+    return job->error[0] ? job->error : NULL;
+}
+
+void copy_job_free(struct copy_job *job) {
+    if (!job) return;
+    if (job->deques) {
+        // 취소 등으로 남은 작업 정리
+        for (int i = 0; i < job->ndeques; i++) {
+            struct copy_task task;
+            while (deque_pop(&job->deques[i], &task, 1)) {
+                free(task.src);
+                free(task.dst);
+            }
+            free(job->deques[i].items);
+            pthread_mutex_destroy(&job->deques[i].lock);
+        }
+    }
+    if (job->ndeques > 0) {
+        pthread_mutex_destroy(&job->idle_lock);
+        pthread_cond_destroy(&job->idle_cond);
+        pthread_mutex_destroy(&job->error_lock);
+    }
+    for (size_t i = 0; job->sources && i < job->nroots; i++) {
+        free(job->sources[i]);
+        free(job->targets[i]);
+    }
+    free(job->sources);
+    free(job->targets);
+    free(job->root_state);
+    free(job->root_errors);
+    free(job->deques);
+    free(job->workers);
+    free(job);
+}
@@ -0,0 +1,263 @@
+#include "../include/dir_stats_tracker.h"
+#include "../include/dirscan.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSocketNotifier>
+#include <functional>
+#include <vector>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+class ScanTask : public QRunnable {
+public:
+    explicit ScanTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+const uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                            IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+
+}  // namespace
+
+DirStatsTracker::DirStatsTracker(QObject *parent) : QObject(parent)
+{
+    pool.setMaxThreadCount(1);
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd != -1) {
+        notifier = new QSocketNotifier(inotifyFd, QSocketNotifier::Read, this);
+        // Qt 5.15부터 activated가 (int)와 (QSocketDescriptor, Type) 두 가지라 하나를 골라야 함
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        connect(notifier, QOverload<QSocketDescriptor, QSocketNotifier::Type>::of(&QSocketNotifier::activated),
+                this, [this]() { readEvents(); });
+#else
+        connect(notifier, &QSocketNotifier::activated, this, [this]() { readEvents(); });
+#endif
+    }
+
+    coalesceTimer.setSingleShot(true);
+    coalesceTimer.setInterval(COALESCE_MS);
+    connect(&coalesceTimer, &QTimer::timeout, this, [this]() { flushPending(); });
+
+    // inotify를 못 쓰거나 이벤트가 넘쳐도 주기적으로 전체 집계해서 맞춤
+    rescanTimer.setInterval(RESCAN_INTERVAL_MS);
+    connect(&rescanTimer, &QTimer::timeout, this, [this]() {
+        if (!scanning) startFullScan();
+    });
+}
+
+DirStatsTracker::~DirStatsTracker()
+{
+    pool.waitForDone();
+    closeDirectory();
+    if (inotifyFd != -1)
+        close(inotifyFd);
+}
+
+void DirStatsTracker::closeDirectory()
+{
+    if (watch != -1) {
+        inotify_rm_watch(inotifyFd, watch);
+        watch = -1;
+    }
+    if (dirFd != -1) {
+        close(dirFd);
+        dirFd = -1;
+    }
+}
+
+void DirStatsTracker::setDirectory(const QString &path)
+{
+    if (path == dirPath && dirFd != -1) return;
+
+    closeDirectory();
+    dirPath = path;
+    entries.clear();
+    files = dirs = 0;
+    bytes = 0;
+    loaded = false;
+    pending.clear();
+    touchedDuringScan.clear();
+
+    QByteArray localPath = path.toLocal8Bit();
+    dirFd = open(localPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (inotifyFd != -1)
+        watch = inotify_add_watch(inotifyFd, localPath.constData(), WATCH_MASK);
+
+    startFullScan();
+    rescanTimer.start();
+}
+
+void DirStatsTracker::startFullScan()
+{
+    qulonglong generation = ++scanGeneration;
+    scanning = true;
+    touchedDuringScan.clear();
+
+    QByteArray localPath = dirPath.toLocal8Bit();
+    pool.start(new ScanTask([this, generation, localPath]() {
+        QHash<QByteArray, Entry> result;
+
+        // 유형은 대부분 d_type으로 판별되므로 크기 조회(stat)는 일반 파일에만 병렬로 수행
+        struct dir_listing listing;
+        if (dir_listing_open(&listing, localPath.constData(), DIRSCAN_SKIP_DOTS) == 0) {
+            dir_listing_fetch(&listing, 0, listing.count, DIRSCAN_NEED_TYPE);
+
+            std::vector<uint32_t> regularFiles;
+            result.reserve(static_cast<int>(listing.count));
+            for (size_t i = 0; i < listing.count; ++i) {
+                const struct dir_entry *e = &listing.entries[i];
+                Entry entry = { Entry::Other, 0 };
+                if (dir_entry_is_reg(e)) {
+                    regularFiles.push_back(static_cast<uint32_t>(i));
+                    entry.kind = Entry::File;
+                } else if (dir_entry_is_dir(e)) {
+                    entry.kind = Entry::Dir;
+                }
+                result.insert(QByteArray(dir_entry_name(&listing, e)), entry);
+            }
+
+            dir_listing_fetch_indices(&listing, regularFiles.data(), regularFiles.size(),
+                                      DIRSCAN_NEED_TYPE | DIRSCAN_NEED_SIZE);
+            for (uint32_t i : regularFiles) {
+                const struct dir_entry *e = &listing.entries[i];
+                QByteArray name(dir_entry_name(&listing, e));
+                if (e->error)
+                    result.remove(name);
+                else
+                    result[name].size = e->size;
+            }
+            dir_listing_free(&listing);
+        }
+
+        // 추적기가 먼저 없어지면 소멸자가 이 작업을 기다리고, 보낸 이벤트는 버려짐
+        QMetaObject::invokeMethod(this, [this, generation, result]() {
+            finishFullScan(generation, result);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void DirStatsTracker::finishFullScan(qulonglong generation, const QHash<QByteArray, Entry> &result)
+{
+    if (generation != scanGeneration) return;  // 그 사이 디렉토리가 바뀜
+
+    entries = result;
+    files = dirs = 0;
+    bytes = 0;
+    for (const Entry &entry : entries)
+        account(entry, 1);
+    loaded = true;
+    scanning = false;
+
+    // 집계 도중 바뀐 이름은 결과에 반영됐는지 알 수 없으므로 다시 stat
+    QSet<QByteArray> touched;
+    touched.swap(touchedDuringScan);
+    for (const QByteArray &name : touched)
+        apply(name);
+
+    emit statsChanged();
+}
+
+void DirStatsTracker::account(const Entry &entry, int sign)
+{
+    if (entry.kind == Entry::File) {
+        files += sign;
+        bytes += sign * entry.size;
+    } else if (entry.kind == Entry::Dir) {
+        dirs += sign;
+    }
+}
+
+// 이름 하나의 이전 기여분을 빼고 현재 상태를 다시 더함
+void DirStatsTracker::apply(const QByteArray &name)
+{
+    if (scanning)
+        touchedDuringScan.insert(name);
+
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        account(it.value(), -1);
+        entries.erase(it);
+    }
+
+    struct stat st;
+    if (dirFd == -1 || fstatat(dirFd, name.constData(), &st, AT_SYMLINK_NOFOLLOW) == -1)
+        return;
+
+    Entry entry = { Entry::Other, 0 };
+    if (S_ISREG(st.st_mode)) {
+        entry.kind = Entry::File;
+        entry.size = st.st_size;
+    } else if (S_ISDIR(st.st_mode)) {
+        entry.kind = Entry::Dir;
+    }
+    entries.insert(name, entry);
+    account(entry, 1);
+}
+
+void DirStatsTracker::touch(const QString &name)
+{
+    if (name.isEmpty() || name.contains('/')) return;
+    apply(name.toLocal8Bit());
+    emit statsChanged();
+}
+
+void DirStatsTracker::touchPath(const QString &path)
+{
+    QFileInfo info(path);
+    if (QDir::cleanPath(info.absolutePath()) == QDir::cleanPath(dirPath))
+        touch(info.fileName());
+}
+
+void DirStatsTracker::readEvents()
+{
+    alignas(struct inotify_event) char buf[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+    bool overflow = false;
+
+    for (;;) {
+        ssize_t len = read(inotifyFd, buf, sizeof(buf));
+        if (len <= 0) break;
+
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflow = true;
+            } else if (event->wd == watch && (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))) {
+                // 보고 있던 디렉토리 자체가 사라짐
+                overflow = true;
+            } else if (event->wd == watch && event->len > 0) {
+                pending.insert(QByteArray(event->name));
+            }
+        }
+    }
+
+    if (overflow) {
+        // 놓친 이벤트가 있으니 전체를 다시 집계
+        pending.clear();
+        startFullScan();
+        return;
+    }
+    if (!pending.isEmpty() && !coalesceTimer.isActive())
+        coalesceTimer.start();
+}
+
+void DirStatsTracker::flushPending()
+{
+    if (pending.isEmpty()) return;
+    QSet<QByteArray> names;
+    names.swap(pending);
+    for (const QByteArray &name : names)
+        apply(name);
+    emit statsChanged();
+}
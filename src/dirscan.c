@@ -0,0 +1,390 @@
+#define _GNU_SOURCE
+#include "../include/dirscan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <pthread.h>
+
+#define DIRSCAN_BUF_SIZE      (256 * 1024)
+#define DIRSCAN_INIT_ENTRIES  256
+#define DIRSCAN_INIT_NAMES    (16 * 1024)
+
+#define DIRSCAN_CHUNK         32     // 워커가 한 번에 가져가는 엔트리 수
+
+// 0이면 아직 정해지지 않음 (FSOPS_STAT_WORKERS 환경 변수 또는 CPU 수로 결정)
+static int default_workers = 0;
+
+// getdents64가 돌려주는 레코드 형식
+struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+static int grow_entries(struct dir_listing *l) {
+    size_t new_capacity = l->capacity ? l->capacity * 2 : DIRSCAN_INIT_ENTRIES;
+    struct dir_entry *grown = realloc(l->entries, new_capacity * sizeof(*grown));
+    if (!grown) return -1;
+    l->entries = grown;
+    l->capacity = new_capacity;
+    return 0;
+}
+
+static int grow_names(struct dir_listing *l, size_t needed) {
+    size_t new_capacity = l->names_capacity ? l->names_capacity : DIRSCAN_INIT_NAMES;
+    while (new_capacity < l->names_len + needed)
+        new_capacity *= 2;
+    char *grown = realloc(l->names, new_capacity);
+    if (!grown) return -1;
+    l->names = grown;
+    l->names_capacity = new_capacity;
+    return 0;
+}
+
+static int append_entry(struct dir_listing *l, const char *name, unsigned char d_type) {
+    size_t len = strlen(name);
+    if (l->count == l->capacity && grow_entries(l) == -1)
+        return -1;
+    if (l->names_len + len + 1 > l->names_capacity && grow_names(l, len + 1) == -1)
+        return -1;
+
+    struct dir_entry *e = &l->entries[l->count++];
+    memset(e, 0, sizeof(*e));
+    e->name_off = (uint32_t)l->names_len;
+    e->name_len = (uint16_t)len;
+    e->d_type = d_type;
+    if (d_type != DT_UNKNOWN)
+        e->fetched = DIRSCAN_NEED_TYPE;
+
+    memcpy(l->names + l->names_len, name, len + 1);
+    l->names_len += len + 1;
+    return 0;
+}
+
+int dir_listing_open(struct dir_listing *l, const char *path, int flags) {
+    memset(l, 0, sizeof(*l));
+    l->dirfd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (l->dirfd == -1) return -1;
+
+    char *buf = malloc(DIRSCAN_BUF_SIZE);
+    if (!buf) {
+        dir_listing_free(l);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    // 큰 버퍼 단위로 엔트리를 한꺼번에 읽음
+    for (;;) {
+        long n = syscall(SYS_getdents64, l->dirfd, buf, DIRSCAN_BUF_SIZE);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            int saved = errno;
+            free(buf);
+            dir_listing_free(l);
+            errno = saved;
+            return -1;
+        }
+
+        for (long pos = 0; pos < n; ) {
+            struct linux_dirent64 *d = (struct linux_dirent64 *)(buf + pos);
+            pos += d->d_reclen;
+
+            if ((flags & DIRSCAN_SKIP_DOTS) && d->d_name[0] == '.' &&
+                (d->d_name[1] == '\0' || (d->d_name[1] == '.' && d->d_name[2] == '\0')))
+                continue;
+
+            if (append_entry(l, d->d_name, d->d_type) == -1) {
+                free(buf);
+                dir_listing_free(l);
+                errno = ENOMEM;
+                return -1;
+            }
+            l->entries[l->count - 1].ino = (ino_t)d->d_ino;
+        }
+    }
+
+    free(buf);
+    return 0;
+}
+
+#ifdef STATX_TYPE
+static unsigned int need_to_statx_mask(unsigned need) {
+    unsigned int mask = 0;
+    if (need & DIRSCAN_NEED_TYPE)  mask |= STATX_TYPE;
+    if (need & DIRSCAN_NEED_SIZE)  mask |= STATX_SIZE;
+    if (need & DIRSCAN_NEED_MTIME) mask |= STATX_MTIME;
+    if (need & DIRSCAN_NEED_TIMES) mask |= STATX_ATIME | STATX_CTIME;
+    if (need & DIRSCAN_NEED_OWNER) mask |= STATX_MODE | STATX_NLINK | STATX_UID | STATX_GID;
+    if (need & DIRSCAN_NEED_INODE) mask |= STATX_INO;
+    return mask;
+}
+#endif
+
+// 엔트리 하나의 메타데이터를 디렉토리 fd 기준으로 가져옴
+static void fetch_entry(const struct dir_listing *l, struct dir_entry *e, unsigned need) {
+    const char *name = dir_entry_name(l, e);
+
+#ifdef STATX_TYPE
+    struct statx stx;
+    if (statx(l->dirfd, name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT,
+              need_to_statx_mask(need) | STATX_TYPE, &stx) == 0) {
+        e->mode = stx.stx_mode;
+        e->nlink = stx.stx_nlink;
+        e->uid = stx.stx_uid;
+        e->gid = stx.stx_gid;
+        e->size = (off_t)stx.stx_size;
+        e->ino = (ino_t)stx.stx_ino;
+        e->atime = (time_t)stx.stx_atime.tv_sec;
+        e->mtime = (time_t)stx.stx_mtime.tv_sec;
+        e->ctime = (time_t)stx.stx_ctime.tv_sec;
+        e->error = 0;
+        e->fetched |= need | DIRSCAN_NEED_TYPE;
+        return;
+    }
+    if (errno != ENOSYS) {
+        e->error = errno;
+        return;
+    }
+#endif
+
+    struct stat st;
+    if (fstatat(l->dirfd, name, &st, AT_SYMLINK_NOFOLLOW) == -1) {
+        e->error = errno;
+        return;
+    }
+    e->mode = st.st_mode;
+    e->nlink = st.st_nlink;
+    e->uid = st.st_uid;
+    e->gid = st.st_gid;
+    e->size = st.st_size;
+    e->ino = st.st_ino;
+    e->atime = st.st_atime;
+    e->mtime = st.st_mtime;
+    e->ctime = st.st_ctime;
+    e->error = 0;
+    e->fetched = DIRSCAN_NEED_ALL;
+}
+
+void dirscan_set_workers(int workers) {
+    if (workers < 1) workers = 1;
+    if (workers > DIRSCAN_MAX_WORKERS) workers = DIRSCAN_MAX_WORKERS;
+    __atomic_store_n(&default_workers, workers, __ATOMIC_RELAXED);
+}
+
+int dirscan_get_workers(void) {
+    int workers = __atomic_load_n(&default_workers, __ATOMIC_RELAXED);
+    if (workers > 0) return workers;
+
+    const char *env = getenv("FSOPS_STAT_WORKERS");
+    if (env && atoi(env) > 0) {
+        workers = atoi(env);
+    } else {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)(cpus < 8 ? cpus : 8) : 1;
+    }
+    dirscan_set_workers(workers);
+    return __atomic_load_n(&default_workers, __ATOMIC_RELAXED);
+}
+
+// 조회 작업 하나: indices가 NULL이면 [begin, begin + n) 구간
+struct fetch_job {
+    struct dir_listing *l;
+    const uint32_t *indices;
+    size_t begin;
+    size_t n;
+    unsigned need;
+    size_t next;         // 다음에 가져갈 위치 (원자적으로 증가)
+};
+
+static void fetch_one(struct fetch_job *job, size_t pos) {
+    size_t idx = job->indices ? job->indices[pos] : job->begin + pos;
+    struct dir_entry *e = &job->l->entries[idx];
+    // 이미 필요한 필드가 있으면 stat 생략 (d_type만으로 유형 판별 가능한 경우 등)
+    if ((e->fetched & job->need) == job->need && !e->error)
+        return;
+    fetch_entry(job->l, e, job->need);
+}
+
+static void *fetch_worker(void *arg) {
+    struct fetch_job *job = arg;
+    for (;;) {
+        size_t start = __atomic_fetch_add(&job->next, DIRSCAN_CHUNK, __ATOMIC_RELAXED);
+        if (start >= job->n) break;
+        size_t stop = start + DIRSCAN_CHUNK < job->n ? start + DIRSCAN_CHUNK : job->n;
+        for (size_t pos = start; pos < stop; pos++)
+            fetch_one(job, pos);
+    }
+    return NULL;
+}
+
+// 결과는 엔트리 슬롯에 바로 기록되므로 스레드 수와 무관하게 순서가 유지됨
+static int run_fetch(struct fetch_job *job) {
+    int workers = job->l->workers > 0 ? job->l->workers : dirscan_get_workers();
+    if (workers > DIRSCAN_MAX_WORKERS) workers = DIRSCAN_MAX_WORKERS;
+    size_t max_useful = (job->n + DIRSCAN_CHUNK - 1) / DIRSCAN_CHUNK;
+    if ((size_t)workers > max_useful) workers = (int)max_useful;
+
+    if (workers <= 1 || job->n < DIRSCAN_PARALLEL_MIN) {
+        for (size_t pos = 0; pos < job->n; pos++)
+            fetch_one(job, pos);
+        return 0;
+    }
+
+    pthread_t threads[DIRSCAN_MAX_WORKERS];
+    int started = 0;
+    // 호출 스레드도 워커로 참여
+    for (int i = 0; i < workers - 1; i++) {
+        if (pthread_create(&threads[started], NULL, fetch_worker, job) != 0)
+            break;
+        started++;
+    }
+    fetch_worker(job);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    return 0;
+}
+
+int dir_listing_fetch(struct dir_listing *l, size_t begin, size_t end, unsigned need) {
+    if (end > l->count) end = l->count;
+    if (begin >= end) return 0;
+
+    struct fetch_job job = { l, NULL, begin, end - begin, need, 0 };
+    return run_fetch(&job);
+}
+
+int dir_listing_fetch_indices(struct dir_listing *l, const uint32_t *indices, size_t n,
+                              unsigned need) {
+    if (n == 0) return 0;
+
+    struct fetch_job job = { l, indices, 0, n, need, 0 };
+    return run_fetch(&job);
+}
+
+int dir_listing_scan(struct dir_listing *l, const char *path, int flags, unsigned need) {
+    if (dir_listing_open(l, path, flags) == -1)
+        return -1;
+    return dir_listing_fetch(l, 0, l->count, need);
+}
+
+void dir_listing_free(struct dir_listing *l) {
+    if (l->dirfd >= 0)
+        close(l->dirfd);
+    free(l->entries);
+    free(l->names);
+    memset(l, 0, sizeof(*l));
+    l->dirfd = -1;
+}
+
+struct order_ctx {
+    const struct dir_listing *l;
+    dir_entry_cmp_fn cmp;
+    void *ctx;
+};
+
+static inline int order_less(const struct order_ctx *c, uint32_t a, uint32_t b) {
+    return c->cmp(c->l, &c->l->entries[a], &c->l->entries[b], c->ctx) < 0;
+}
+
+static int order_qsort_cmp(const void *a, const void *b, void *arg) {
+    const struct order_ctx *c = arg;
+    return c->cmp(c->l, &c->l->entries[*(const uint32_t *)a],
+                  &c->l->entries[*(const uint32_t *)b], c->ctx);
+}
+
+void dir_order_sort(const struct dir_listing *l, uint32_t *order, size_t begin, size_t end,
+                    dir_entry_cmp_fn cmp, void *ctx) {
+    if (end <= begin + 1) return;
+    struct order_ctx c = { l, cmp, ctx };
+    qsort_r(order + begin, end - begin, sizeof(*order), order_qsort_cmp, &c);
+}
+
+// nth 위치에 정렬 시 올 원소를 놓고, 그 앞은 작거나 같고 뒤는 크거나 같게 분할 (quickselect)
+void dir_order_select(const struct dir_listing *l, uint32_t *order, size_t begin, size_t nth,
+                      size_t end, dir_entry_cmp_fn cmp, void *ctx) {
+    struct order_ctx c = { l, cmp, ctx };
+    if (nth < begin || nth >= end) return;
+
+    while (end - begin > 16) {
+        // median-of-3 피벗
+        size_t mid = begin + (end - begin) / 2;
+        size_t last = end - 1;
+        uint32_t tmp;
+        if (order_less(&c, order[mid], order[begin])) { tmp = order[mid]; order[mid] = order[begin]; order[begin] = tmp; }
+        if (order_less(&c, order[last], order[begin])) { tmp = order[last]; order[last] = order[begin]; order[begin] = tmp; }
+        if (order_less(&c, order[last], order[mid])) { tmp = order[last]; order[last] = order[mid]; order[mid] = tmp; }
+        uint32_t pivot = order[mid];
+
+        size_t i = begin, j = last;
+        for (;;) {
+            while (order_less(&c, order[i], pivot)) i++;
+            while (order_less(&c, pivot, order[j])) j--;
+            if (i >= j) break;
+            tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+            i++;
+            j--;
+        }
+        // [begin, j] <= pivot <= [j+1, end)
+        if (nth <= j)
+            end = j + 1;
+        else
+            begin = j + 1;
+    }
+
+    // 작은 구간은 삽입 정렬
+    for (size_t i = begin + 1; i < end; i++) {
+        uint32_t v = order[i];
+        size_t k = i;
+        while (k > begin && order_less(&c, v, order[k - 1])) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = v;
+    }
+}
+
+static mode_t d_type_to_mode(unsigned char d_type) {
+    switch (d_type) {
+    case DT_DIR:  return S_IFDIR;
+    case DT_REG:  return S_IFREG;
+    case DT_LNK:  return S_IFLNK;
+    case DT_FIFO: return S_IFIFO;
+    case DT_CHR:  return S_IFCHR;
+    case DT_BLK:  return S_IFBLK;
+    case DT_SOCK: return S_IFSOCK;
+    default:      return 0;
+    }
+}
+
+static mode_t entry_type(const struct dir_entry *e) {
+    if (e->mode & S_IFMT) return e->mode & S_IFMT;
+    return d_type_to_mode(e->d_type);
+}
+
+int dir_entry_is_dir(const struct dir_entry *e) {
+    return S_ISDIR(entry_type(e));
+}
+
+int dir_entry_is_reg(const struct dir_entry *e) {
+    return S_ISREG(entry_type(e));
+}
+
+void dir_entry_to_stat(const struct dir_entry *e, struct stat *st) {
+    memset(st, 0, sizeof(*st));
+    st->st_mode = e->mode ? e->mode : d_type_to_mode(e->d_type);
+    st->st_nlink = e->nlink;
+    st->st_uid = e->uid;
+    st->st_gid = e->gid;
+    st->st_size = e->size;
+    st->st_ino = e->ino;
+    st->st_atime = e->atime;
+    st->st_mtime = e->mtime;
+    st->st_ctime = e->ctime;
+}
@@ -0,0 +1,759 @@
+#define _GNU_SOURCE
+#include "../include/du.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+// 하위 디렉토리가 남아 있는 동안 열어 둘 디렉토리 fd의 최대 수 (집계 하나 기준,
+// RLIMIT_NOFILE의 1/4도 넘지 않음). 이보다 깊은 트리는 자식이 필요할 때 가까운 조상부터 다시 엶
+#define DU_MAX_OPEN_DIRS  256
+
+// ---------------------------------------------------------------------------
+// 디렉토리별 캐시: 직속 항목 합계, 하위 디렉토리 이름, 하드 링크 목록
+// ---------------------------------------------------------------------------
+
+struct du_link {
+    dev_t dev;
+    ino_t ino;
+    unsigned long long bytes;
+    unsigned long long blocks;
+};
+
+struct du_cache_entry {
+    struct du_cache_entry *next;
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    unsigned long long bytes;    // 직속 일반 항목 합계 (하드 링크 제외)
+    unsigned long long blocks;
+    unsigned long long files;
+    char *names;                 // 하위 디렉토리 이름들 (NUL 구분)
+    size_t names_len;
+    struct du_link *links;       // 링크 수가 2 이상인 직속 파일 (집계 때마다 중복 제거)
+    size_t nlinks;
+};
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct du_cache_entry **cache_buckets;
+static size_t cache_nbuckets;
+static size_t cache_count;
+
+static size_t hash_key(dev_t dev, ino_t ino) {
+    unsigned long long h = (unsigned long long)ino * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h ^ ((unsigned long long)dev << 17) ^ (h >> 29));
+}
+
+static void cache_entry_free(struct du_cache_entry *e) {
+    free(e->names);
+    free(e->links);
+    free(e);
+}
+
+// cache_lock을 잡은 상태에서 호출
+static void cache_grow(void) {
+    size_t new_nbuckets = cache_nbuckets ? cache_nbuckets * 2 : 1024;
+    struct du_cache_entry **buckets = calloc(new_nbuckets, sizeof(*buckets));
+    if (!buckets) return;
+    for (size_t i = 0; i < cache_nbuckets; i++) {
+        struct du_cache_entry *e = cache_buckets[i];
+        while (e) {
+            struct du_cache_entry *next = e->next;
+            size_t b = hash_key(e->dev, e->ino) & (new_nbuckets - 1);
+            e->next = buckets[b];
+            buckets[b] = e;
+            e = next;
+        }
+    }
+    free(cache_buckets);
+    cache_buckets = buckets;
+    cache_nbuckets = new_nbuckets;
+}
+
+// mtime이 같은 항목이 있으면 복사본을 돌려줌 (다른 스레드가 교체해도 안전하도록)
+static struct du_cache_entry *cache_lookup(const struct stat *st) {
+    struct du_cache_entry *copy = NULL;
+    pthread_mutex_lock(&cache_lock);
+    if (cache_nbuckets) {
+        struct du_cache_entry *e = cache_buckets[hash_key(st->st_dev, st->st_ino) & (cache_nbuckets - 1)];
+        for (; e; e = e->next) {
+            if (e->dev != st->st_dev || e->ino != st->st_ino) continue;
+            if (e->mtime.tv_sec != st->st_mtim.tv_sec || e->mtime.tv_nsec != st->st_mtim.tv_nsec)
+                break;
+            copy = malloc(sizeof(*copy));
+            if (!copy) break;
+            *copy = *e;
+            copy->names = e->names_len ? malloc(e->names_len) : NULL;
+            copy->links = e->nlinks ? malloc(e->nlinks * sizeof(*e->links)) : NULL;
+            if ((e->names_len && !copy->names) || (e->nlinks && !copy->links)) {
+                cache_entry_free(copy);
+                copy = NULL;
+                break;
+            }
+            if (e->names_len) memcpy(copy->names, e->names, e->names_len);
+            if (e->nlinks) memcpy(copy->links, e->links, e->nlinks * sizeof(*e->links));
+            break;
+        }
+    }
+    pthread_mutex_unlock(&cache_lock);
+    return copy;
+}
+
+// 소유권을 넘겨받음. 같은 디렉토리의 이전 항목은 교체
+static void cache_store(struct du_cache_entry *entry) {
+    pthread_mutex_lock(&cache_lock);
+    if (cache_count >= cache_nbuckets * 2)
+        cache_grow();
+    if (!cache_nbuckets) {
+        pthread_mutex_unlock(&cache_lock);
+        cache_entry_free(entry);
+        return;
+    }
+    struct du_cache_entry **slot = &cache_buckets[hash_key(entry->dev, entry->ino) & (cache_nbuckets - 1)];
+    for (struct du_cache_entry **p = slot; *p; p = &(*p)->next) {
+        if ((*p)->dev == entry->dev && (*p)->ino == entry->ino) {
+            struct du_cache_entry *old = *p;
+            entry->next = old->next;
+            *p = entry;
+            pthread_mutex_unlock(&cache_lock);
+            cache_entry_free(old);
+            return;
+        }
+    }
+    entry->next = *slot;
+    *slot = entry;
+    cache_count++;
+    pthread_mutex_unlock(&cache_lock);
+}
+
+void du_cache_clear(void) {
+    pthread_mutex_lock(&cache_lock);
+    for (size_t i = 0; i < cache_nbuckets; i++) {
+        struct du_cache_entry *e = cache_buckets[i];
+        while (e) {
+            struct du_cache_entry *next = e->next;
+            cache_entry_free(e);
+            e = next;
+        }
+    }
+    free(cache_buckets);
+    cache_buckets = NULL;
+    cache_nbuckets = 0;
+    cache_count = 0;
+    pthread_mutex_unlock(&cache_lock);
+}
+
+// ---------------------------------------------------------------------------
+// 집계 작업
+// ---------------------------------------------------------------------------
+
+// 디렉토리 하나. 하위 디렉토리가 모두 끝나면 합계를 부모에 더하고 부모 참조를 놓음
+struct du_node {
+    struct du_node *parent;
+    int fd;                      // 열어 둔 디렉토리 fd, 없으면 -1 (자식이 생기기 전에 정해지고 바뀌지 않음)
+    int depth;
+    unsigned refs;               // 처리 중 1 + 끝나지 않은 하위 디렉토리 수
+    unsigned long long bytes;
+    unsigned long long blocks;
+    unsigned long long files;
+    unsigned long long dirs;
+    char name[];
+};
+
+struct link_key {
+    dev_t dev;
+    ino_t ino;
+    int used;
+};
+
+struct du_job {
+    const struct du_options *opts;
+    int nworkers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct du_node **queue;
+    size_t queue_len;
+    size_t queue_capacity;
+    int active;
+    int open_dirs;               // 열어 둔 du_node.fd 수 (max_open_dirs까지)
+    int max_open_dirs;
+
+    pthread_mutex_t link_lock;   // 이번 집계에서 이미 센 하드 링크
+    struct link_key *links;
+    size_t links_used;
+    size_t links_capacity;
+
+    pthread_mutex_t result_lock;
+    struct du_result *result;
+    size_t result_capacity;
+    int root_errno;              // 루트를 열지 못한 이유
+    int first_errno;             // 첫 번째 오류의 errno
+};
+
+// 루트가 "/"처럼 '/'로 끝나면 구분자를 더 붙이지 않음
+static int needs_separator(const struct du_node *node) {
+    size_t len = strlen(node->name);
+    return len == 0 || node->name[len - 1] != '/';
+}
+
+static size_t node_path_len(const struct du_node *node) {
+    if (!node->parent) return strlen(node->name);
+    return node_path_len(node->parent) + needs_separator(node->parent) + strlen(node->name);
+}
+
+static char *node_path(const struct du_node *node, const char *name) {
+    size_t len = node ? node_path_len(node) : 0;
+    size_t name_len = name ? strlen(name) : 0;
+    char *path = malloc(len + name_len + 2);
+    if (!path) return NULL;
+
+    // 뒤에서부터 채움
+    size_t pos = len;
+    path[len] = '\0';
+    for (const struct du_node *n = node; n; n = n->parent) {
+        size_t n_len = strlen(n->name);
+        pos -= n_len;
+        memcpy(path + pos, n->name, n_len);
+        if (n->parent && needs_separator(n->parent)) path[--pos] = '/';
+    }
+    if (name) {
+        if (node && needs_separator(node)) path[len++] = '/';
+        memcpy(path + len, name, name_len + 1);
+    }
+    return path;
+}
+
+static void job_record_error(struct du_job *job, const struct du_node *dir,
+                             const char *name, int err) {
+    pthread_mutex_lock(&job->result_lock);
+    job->result->errors++;
+    if (job->result->error[0] == '\0') {
+        job->first_errno = err;
+        char *path = node_path(dir, name);
+        snprintf(job->result->error, sizeof(job->result->error), "%s: %s",
+                 path ? path : (name ? name : ""), strerror(err));
+        free(path);
+    }
+    pthread_mutex_unlock(&job->result_lock);
+}
+
+// 처음 보는 (dev, inode)면 1
+static int link_first_seen(struct du_job *job, dev_t dev, ino_t ino) {
+    int first = 0;
+    pthread_mutex_lock(&job->link_lock);
+    if ((job->links_used + 1) * 2 > job->links_capacity) {
+        size_t new_capacity = job->links_capacity ? job->links_capacity * 2 : 256;
+        struct link_key *grown = calloc(new_capacity, sizeof(*grown));
+        if (!grown) {
+            pthread_mutex_unlock(&job->link_lock);
+            return 1;  // 메모리가 없으면 중복 제거 없이 셈
+        }
+        for (size_t i = 0; i < job->links_capacity; i++) {
+            if (!job->links[i].used) continue;
+            size_t h = hash_key(job->links[i].dev, job->links[i].ino) & (new_capacity - 1);
+            while (grown[h].used) h = (h + 1) & (new_capacity - 1);
+            grown[h] = job->links[i];
+        }
+        free(job->links);
+        job->links = grown;
+        job->links_capacity = new_capacity;
+    }
+
+    size_t h = hash_key(dev, ino) & (job->links_capacity - 1);
+    while (job->links[h].used && (job->links[h].dev != dev || job->links[h].ino != ino))
+        h = (h + 1) & (job->links_capacity - 1);
+    if (!job->links[h].used) {
+        job->links[h].dev = dev;
+        job->links[h].ino = ino;
+        job->links[h].used = 1;
+        job->links_used++;
+        first = 1;
+    }
+    pthread_mutex_unlock(&job->link_lock);
+    return first;
+}
+
+static void record_result(struct du_job *job, struct du_node *node) {
+    int max_depth = job->opts->max_depth;
+    if (max_depth >= 0 && node->depth > max_depth) return;
+
+    char *path = node_path(node, NULL);
+    if (!path) return;
+    pthread_mutex_lock(&job->result_lock);
+    struct du_result *r = job->result;
+    if (r->count == job->result_capacity) {
+        size_t new_capacity = job->result_capacity ? job->result_capacity * 2 : 64;
+        struct du_entry *grown = realloc(r->entries, new_capacity * sizeof(*grown));
+        if (!grown) {
+            pthread_mutex_unlock(&job->result_lock);
+            free(path);
+            return;
+        }
+        r->entries = grown;
+        job->result_capacity = new_capacity;
+    }
+    struct du_entry *e = &r->entries[r->count++];
+    e->path = path;
+    e->depth = node->depth;
+    e->bytes = node->bytes;
+    e->blocks = node->blocks;
+    e->files = node->files;
+    e->dirs = node->dirs;
+    pthread_mutex_unlock(&job->result_lock);
+}
+
+static struct du_node *node_new(struct du_node *parent, const char *name) {
+    size_t len = strlen(name);
+    struct du_node *node = calloc(1, sizeof(*node) + len + 1);
+    if (!node) return NULL;
+    node->parent = parent;
+    node->fd = -1;
+    node->depth = parent ? parent->depth + 1 : 0;
+    node->refs = 1;
+    memcpy(node->name, name, len + 1);
+    return node;
+}
+
+// 참조가 0이 되면 결과를 기록하고 합계를 부모로 올림 (재귀 대신 반복)
+static void node_release(struct du_job *job, struct du_node *node) {
+    while (node && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        struct du_node *parent = node->parent;
+        if (node->fd != -1) {
+            close(node->fd);
+            __atomic_sub_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED);
+        }
+        record_result(job, node);
+
+        if (parent) {
+            __atomic_add_fetch(&parent->bytes, node->bytes, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parent->blocks, node->blocks, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parent->files, node->files, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parent->dirs, node->dirs + 1, __ATOMIC_RELAXED);
+        }
+        free(node);
+        node = parent;
+    }
+}
+
+// 하위 디렉토리는 모두 힙의 스택으로 넘김 (그 자리에서 재귀하면 트리 깊이만큼 C 스택을 씀).
+// 스택을 늘리지 못하면 -1
+static int queue_push(struct du_job *job, struct du_node *node) {
+    int result = 0;
+    pthread_mutex_lock(&job->lock);
+    if (job->queue_len == job->queue_capacity) {
+        size_t new_capacity = job->queue_capacity ? job->queue_capacity * 2 : 16;
+        struct du_node **grown = realloc(job->queue, new_capacity * sizeof(*grown));
+        if (!grown) {
+            result = -1;
+            goto out;
+        }
+        job->queue = grown;
+        job->queue_capacity = new_capacity;
+    }
+    job->queue[job->queue_len++] = node;
+    pthread_cond_signal(&job->cond);
+out:
+    pthread_mutex_unlock(&job->lock);
+    return result;
+}
+
+// dir(NULL이면 작업 디렉토리)을 가리키는 fd. 열어 둔 fd가 없으면 fd가 있는 가장 가까운
+// 조상(없으면 최상위)부터 남은 이름들을 open_dir_chain으로 다시 열어 *tmp에 넣어 줌
+// (-1이 아니면 호출한 쪽이 닫음)
+static int dir_fd(const struct du_node *dir, int *tmp) {
+    *tmp = -1;
+    if (!dir) return AT_FDCWD;
+    if (dir->fd != -1) return dir->fd;
+
+    size_t depth = 0;
+    const struct du_node *base = dir;
+    while (base && base->fd == -1) {
+        base = base->parent;
+        depth++;
+    }
+    const char **names = malloc(depth * sizeof(*names));
+    if (!names) {
+        errno = ENOMEM;
+        return -1;
+    }
+    const struct du_node *step = dir;
+    for (size_t i = depth; i > 0; i--) {
+        names[i - 1] = step->name;
+        step = step->parent;
+    }
+
+    int cur = base ? base->fd : AT_FDCWD;
+    size_t first = 0;
+    if (!base) {
+        // 최상위는 사용자가 준 경로이므로 처음 열 때처럼 심볼릭 링크를 따라감
+        *tmp = openat(AT_FDCWD, names[0], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (*tmp == -1) {
+            int err = errno;
+            free(names);
+            errno = err;
+            return -1;
+        }
+        cur = *tmp;
+        first = 1;
+    }
+    if (first < depth) {
+        int fd = open_dir_chain(cur, names + first, depth - first);
+        int err = errno;
+        if (*tmp != -1) close(*tmp);
+        *tmp = fd;
+        if (fd == -1) {
+            free(names);
+            errno = err;
+            return -1;
+        }
+    }
+    free(names);
+    return *tmp;
+}
+
+static int append_name(struct du_cache_entry *e, size_t *capacity, const char *name) {
+    size_t len = strlen(name) + 1;
+    if (e->names_len + len > *capacity) {
+        size_t new_capacity = *capacity ? *capacity * 2 : 256;
+        while (new_capacity < e->names_len + len) new_capacity *= 2;
+        char *grown = realloc(e->names, new_capacity);
+        if (!grown) return -1;
+        e->names = grown;
+        *capacity = new_capacity;
+    }
+    memcpy(e->names + e->names_len, name, len);
+    e->names_len += len;
+    return 0;
+}
+
+static int append_link(struct du_cache_entry *e, size_t *capacity, const struct stat *st) {
+    if (e->nlinks == *capacity) {
+        size_t new_capacity = *capacity ? *capacity * 2 : 16;
+        struct du_link *grown = realloc(e->links, new_capacity * sizeof(*grown));
+        if (!grown) return -1;
+        e->links = grown;
+        *capacity = new_capacity;
+    }
+    struct du_link *link = &e->links[e->nlinks++];
+    link->dev = st->st_dev;
+    link->ino = st->st_ino;
+    link->bytes = (unsigned long long)st->st_size;
+    link->blocks = (unsigned long long)st->st_blocks * 512;
+    return 0;
+}
+
+// 캐시에 없거나 바뀐 디렉토리: 직접 읽어서 직속 합계를 만듦
+static struct du_cache_entry *read_directory(struct du_job *job, struct du_node *node, int fd,
+                                             const struct stat *dir_st) {
+    struct du_cache_entry *e = calloc(1, sizeof(*e));
+    if (!e) {
+        job_record_error(job, node, NULL, ENOMEM);
+        return NULL;
+    }
+    e->dev = dir_st->st_dev;
+    e->ino = dir_st->st_ino;
+    e->mtime = dir_st->st_mtim;
+
+    int dup_fd = dup(fd);
+    DIR *dir = dup_fd == -1 ? NULL : fdopendir(dup_fd);
+    if (!dir) {
+        job_record_error(job, node, NULL, errno);
+        if (dup_fd != -1) close(dup_fd);
+        free(e);
+        return NULL;
+    }
+
+    size_t names_capacity = 0, links_capacity = 0;
+    int complete = 1;
+    struct dirent *d;
+    while ((errno = 0, d = readdir(dir)) != NULL) {
+        if (d->d_name[0] == '.' &&
+            (d->d_name[1] == '\0' || (d->d_name[1] == '.' && d->d_name[2] == '\0')))
+            continue;
+
+        if (d->d_type == DT_DIR) {
+            if (append_name(e, &names_capacity, d->d_name) == -1) complete = 0;
+            continue;
+        }
+
+        struct stat st;
+        if (fstatat(fd, d->d_name, &st, AT_SYMLINK_NOFOLLOW) == -1) {
+            if (errno != ENOENT) {
+                job_record_error(job, node, d->d_name, errno);
+                complete = 0;
+            }
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            if (append_name(e, &names_capacity, d->d_name) == -1) complete = 0;
+        } else if (st.st_nlink > 1) {
+            if (append_link(e, &links_capacity, &st) == -1) complete = 0;
+        } else {
+            e->bytes += (unsigned long long)st.st_size;
+            e->blocks += (unsigned long long)st.st_blocks * 512;
+            e->files++;
+        }
+    }
+    if (errno != 0) {
+        job_record_error(job, node, NULL, errno);
+        complete = 0;
+    }
+    closedir(dir);
+
+    // 일부를 못 읽은 결과는 캐시에 남기지 않음
+    if (complete) {
+        struct du_cache_entry *stored = malloc(sizeof(*stored));
+        if (stored) {
+            *stored = *e;
+            stored->names = e->names_len ? malloc(e->names_len) : NULL;
+            stored->links = e->nlinks ? malloc(e->nlinks * sizeof(*e->links)) : NULL;
+            if ((e->names_len && !stored->names) || (e->nlinks && !stored->links)) {
+                cache_entry_free(stored);
+            } else {
+                if (e->names_len) memcpy(stored->names, e->names, e->names_len);
+                if (e->nlinks) memcpy(stored->links, e->links, e->nlinks * sizeof(*e->links));
+                cache_store(stored);
+            }
+        }
+    }
+    return e;
+}
+
+static void process_node(struct du_job *job, struct du_node *node) {
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+    if (node->parent) flags |= O_NOFOLLOW;
+    int tmp;
+    int pfd = dir_fd(node->parent, &tmp);
+    int fd = pfd == -1 ? -1 : openat(pfd, node->name, flags);
+    if (fd == -1) {
+        int err = errno;
+        if (tmp != -1) close(tmp);
+        if (!node->parent)
+            job->root_errno = err;
+        if (err != ENOENT || !node->parent)
+            job_record_error(job, node->parent, node->name, err);
+        node_release(job, node);
+        return;
+    }
+    if (tmp != -1) close(tmp);
+
+    struct stat dir_st;
+    if (fstat(fd, &dir_st) == -1) {
+        job_record_error(job, node, NULL, errno);
+        close(fd);
+        node_release(job, node);
+        return;
+    }
+    // 디렉토리 자신이 차지하는 블록도 포함 (du와 같음)
+    node->bytes += (unsigned long long)dir_st.st_size;
+    node->blocks += (unsigned long long)dir_st.st_blocks * 512;
+
+    struct du_cache_entry *e = NULL;
+    if (!(job->opts->flags & DU_NO_CACHE))
+        e = cache_lookup(&dir_st);
+    if (e) {
+        __atomic_add_fetch(&job->result->cached_dirs, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_add_fetch(&job->result->scanned_dirs, 1, __ATOMIC_RELAXED);
+        e = read_directory(job, node, fd, &dir_st);
+        if (!e) {
+            close(fd);
+            node_release(job, node);
+            return;
+        }
+    }
+
+    // 한도 안이고 하위 디렉토리가 있으면 자식들이 openat에 쓰도록 fd를 남겨 둠.
+    // 한도를 넘으면 닫고, 자식은 필요할 때 조상부터 다시 엶
+    if (e->names_len > 0 &&
+        __atomic_add_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED) <= job->max_open_dirs) {
+        node->fd = fd;
+    } else {
+        if (e->names_len > 0)
+            __atomic_sub_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED);
+        close(fd);
+    }
+
+    unsigned long long bytes = e->bytes, blocks = e->blocks, files = e->files;
+    for (size_t i = 0; i < e->nlinks; i++) {
+        if (link_first_seen(job, e->links[i].dev, e->links[i].ino)) {
+            bytes += e->links[i].bytes;
+            blocks += e->links[i].blocks;
+            files++;
+        }
+    }
+    __atomic_add_fetch(&node->bytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&node->blocks, blocks, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&node->files, files, __ATOMIC_RELAXED);
+
+    for (size_t off = 0; off < e->names_len; ) {
+        const char *name = e->names + off;
+        off += strlen(name) + 1;
+        struct du_node *child = node_new(node, name);
+        if (!child) {
+            job_record_error(job, node, name, ENOMEM);
+            continue;
+        }
+        __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+        if (queue_push(job, child) == -1) {
+            job_record_error(job, node, name, ENOMEM);
+            free(child);
+            __atomic_sub_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+        }
+    }
+    cache_entry_free(e);
+
+    node_release(job, node);
+}
+
+static void *worker_main(void *arg) {
+    struct du_job *job = arg;
+
+    pthread_mutex_lock(&job->lock);
+    for (;;) {
+        if (job->queue_len > 0) {
+            struct du_node *node = job->queue[--job->queue_len];
+            job->active++;
+            pthread_mutex_unlock(&job->lock);
+
+            process_node(job, node);
+
+            pthread_mutex_lock(&job->lock);
+            job->active--;
+            if (job->queue_len == 0 && job->active == 0)
+                pthread_cond_broadcast(&job->cond);
+            continue;
+        }
+        if (job->active == 0) break;
+        pthread_cond_wait(&job->cond, &job->lock);
+    }
+    pthread_mutex_unlock(&job->lock);
+    return NULL;
+}
+
+// 하위 디렉토리가 상위보다 먼저 오도록: 경로를 구성 요소 단위로 비교하고,
+// 한쪽이 다른 쪽의 상위 경로면 상위를 뒤로 보냄
+static int compare_du_path(const void *a, const void *b) {
+    const unsigned char *p = (const unsigned char *)((const struct du_entry *)a)->path;
+    const unsigned char *q = (const unsigned char *)((const struct du_entry *)b)->path;
+    while (*p && *p == *q) { p++; q++; }
+    if (*p == *q) return 0;
+    if (*p == '\0' && *q == '/') return 1;
+    if (*q == '\0' && *p == '/') return -1;
+    if (*p == '/') return -1;
+    if (*q == '/') return 1;
+    return (int)*p - (int)*q;
+}
+
+int du_scan(const char *path, const struct du_options *opts, struct du_result *out) {
+    memset(out, 0, sizeof(*out));
+
+    struct du_options defaults = { -1, 0, 0 };
+    if (!opts) opts = &defaults;
+    int workers = opts->workers;
+    if (workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (workers > DU_MAX_WORKERS) workers = DU_MAX_WORKERS;
+
+    struct du_job job;
+    memset(&job, 0, sizeof(job));
+    job.opts = opts;
+    job.nworkers = workers;
+    job.result = out;
+    job.max_open_dirs = DU_MAX_OPEN_DIRS;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+        limit.rlim_cur / 4 < (rlim_t)job.max_open_dirs)
+        job.max_open_dirs = (int)(limit.rlim_cur / 4);
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.cond, NULL);
+    pthread_mutex_init(&job.link_lock, NULL);
+    pthread_mutex_init(&job.result_lock, NULL);
+
+    // 끝의 '/'는 떼서 하위 경로가 "a//b"가 되지 않게 함
+    char root_name[MAX_PATH_SIZE];
+    snprintf(root_name, sizeof(root_name), "%s", path);
+    size_t root_len = strlen(root_name);
+    while (root_len > 1 && root_name[root_len - 1] == '/')
+        root_name[--root_len] = '\0';
+
+    struct du_node *root = node_new(NULL, root_name);
+    job.queue = malloc(sizeof(*job.queue));
+    if (!root || !job.queue) {
+        free(root);
+        free(job.queue);
+        errno = ENOMEM;
+        return -1;
+    }
+    job.queue[0] = root;
+    job.queue_len = 1;
+    job.queue_capacity = 1;
+
+    pthread_t threads[DU_MAX_WORKERS];
+    int started = 0;
+    for (int i = 1; i < workers; i++) {
+        if (pthread_create(&threads[started], NULL, worker_main, &job) != 0) break;
+        started++;
+    }
+    // 호출한 스레드도 워커로 참여
+    worker_main(&job);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&job.lock);
+    pthread_cond_destroy(&job.cond);
+    pthread_mutex_destroy(&job.link_lock);
+    pthread_mutex_destroy(&job.result_lock);
+    free(job.queue);
+    free(job.links);
+
+    qsort(out->entries, out->count, sizeof(*out->entries), compare_du_path);
+
+    if (job.root_errno) {
+        errno = job.root_errno;
+        return -1;
+    }
+    if (out->count == 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    // 하위 항목을 읽지 못했으면 합계가 모자라므로 실패로 알림 (결과는 읽은 만큼 남아 있음)
+    if (out->errors) {
+        errno = job.first_errno ? job.first_errno : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+void du_result_free(struct du_result *result) {
+    for (size_t i = 0; i < result->count; i++)
+        free(result->entries[i].path);
+    free(result->entries);
+    result->entries = NULL;
+    result->count = 0;
+}
+
+void du_format_size(unsigned long long bytes, char *buf) {
+    static const char units[] = "KMGTPE";
+    if (bytes < 1024) {
+        snprintf(buf, 16, "%llu", bytes);
+        return;
+    }
+    double value = (double)bytes / 1024;
+    int unit = 0;
+    while (value >= 1024 && units[unit + 1]) {
+        value /= 1024;
+        unit++;
+    }
+    snprintf(buf, 16, value < 10 ? "%.1f%c" : "%.0f%c", value, units[unit]);
+}
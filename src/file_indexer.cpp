@@ -0,0 +1,265 @@
+#include "../include/file_indexer.h"
+#include "../include/fileindex.h"
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSocketNotifier>
+#include <functional>
+#include <errno.h>
+#include <limits.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+class IndexTask : public QRunnable {
+public:
+    explicit IndexTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+const uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                            IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+// 삭제 표시가 이만큼 넘게 쌓이고 살아 있는 항목보다 많아지면 색인을 새로 만듦
+const size_t REBUILD_MIN_DEAD = 10000;
+
+struct SearchContext {
+    const std::atomic<qulonglong> *current;
+    qulonglong generation;
+    int limit;
+    qulonglong total;
+    bool truncated;
+    QStringList batch;
+    QElapsedTimer sinceFlush;
+    std::function<void(const QStringList &)> flush;
+};
+
+int collectHit(void *ctx, uint32_t, const char *path, int)
+{
+    SearchContext *search = static_cast<SearchContext *>(ctx);
+    if (search->current->load() != search->generation) return 1;
+    if (search->limit > 0 && search->total >= static_cast<qulonglong>(search->limit)) {
+        search->truncated = true;
+        return 1;
+    }
+
+    search->batch << QString::fromLocal8Bit(path);
+    search->total++;
+    if (search->batch.size() >= FileIndexer::RESULT_BATCH ||
+        search->sinceFlush.elapsed() >= FileIndexer::BATCH_INTERVAL_MS) {
+        search->flush(search->batch);
+        search->batch.clear();
+        search->sinceFlush.restart();
+    }
+    return 0;
+}
+
+}  // namespace
+
+FileIndexer::FileIndexer(const QString &root, QObject *parent) : QObject(parent)
+{
+    // 갱신은 순서가 중요하므로 한 스레드, 검색은 최신 요청 하나만 의미가 있으므로 한 스레드
+    writer.setMaxThreadCount(1);
+    searcher.setMaxThreadCount(1);
+
+    index = file_index_create(root.toLocal8Bit().constData());
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd != -1) {
+        notifier = new QSocketNotifier(inotifyFd, QSocketNotifier::Read, this);
+        // Qt 5.15부터 activated가 (int)와 (QSocketDescriptor, Type) 두 가지라 하나를 골라야 함
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        connect(notifier, QOverload<QSocketDescriptor, QSocketNotifier::Type>::of(&QSocketNotifier::activated),
+                this, [this]() { readEvents(); });
+#else
+        connect(notifier, &QSocketNotifier::activated, this, [this]() { readEvents(); });
+#endif
+    }
+}
+
+FileIndexer::~FileIndexer()
+{
+    __atomic_store_n(&stopping, 1, __ATOMIC_RELAXED);
+    ++searchGeneration;
+    writer.clear();
+    searcher.clear();
+    writer.waitForDone();
+    searcher.waitForDone();
+    file_index_free(index);
+    if (inotifyFd != -1)
+        close(inotifyFd);
+}
+
+void FileIndexer::start()
+{
+    if (!index) return;
+    writer.start(new IndexTask([this]() {
+        indexing = true;
+        emit indexStateChanged();
+        crawl(FILE_INDEX_ROOT);
+        indexing = false;
+        emit indexStateChanged();
+    }));
+}
+
+qulonglong FileIndexer::indexedCount() const
+{
+    if (!index) return 0;
+    struct file_index_stats stats;
+    file_index_get_stats(index, &stats);
+    return stats.live;
+}
+
+qulonglong FileIndexer::search(const QString &pattern, const QString &scope, int limit)
+{
+    qulonglong generation = ++searchGeneration;
+    // 아직 시작하지 않은 이전 검색은 큐에서 바로 제거
+    searcher.clear();
+    if (!index) return generation;
+
+    QByteArray localPattern = pattern.toLocal8Bit();
+    QByteArray localScope = scope.toLocal8Bit();
+    searcher.start(new IndexTask([this, generation, localPattern, localScope, limit]() {
+        QElapsedTimer elapsed;
+        elapsed.start();
+
+        uint32_t scopeId = localScope.isEmpty() ? FILE_INDEX_ROOT
+                                                : file_index_lookup_path(index, localScope.constData());
+        SearchContext ctx;
+        ctx.current = &searchGeneration;
+        ctx.generation = generation;
+        ctx.limit = limit;
+        ctx.total = 0;
+        ctx.truncated = false;
+        ctx.sinceFlush.start();
+        ctx.flush = [this, generation](const QStringList &paths) { emit resultsReady(generation, paths); };
+
+        // 범위 디렉토리가 아직 색인되지 않았으면 결과 없음
+        if (scopeId != FILE_INDEX_NONE)
+            file_index_query(index, localPattern.constData(), scopeId, 0, collectHit, &ctx);
+
+        if (searchGeneration.load() != generation) return;
+        if (!ctx.batch.isEmpty())
+            ctx.flush(ctx.batch);
+        emit searchFinished(generation, ctx.total, ctx.truncated, elapsed.nsecsElapsed() / 1e6);
+    }));
+    return generation;
+}
+
+void FileIndexer::cancelSearch()
+{
+    ++searchGeneration;
+    searcher.clear();
+}
+
+int FileIndexer::addWatch(void *ctx, uint32_t id, const char *path)
+{
+    FileIndexer *self = static_cast<FileIndexer *>(ctx);
+    if (self->inotifyFd == -1) return 0;
+
+    int wd = inotify_add_watch(self->inotifyFd, path, WATCH_MASK);
+    if (wd != -1) {
+        // 같은 디렉토리를 다시 감시하면 같은 번호가 나오므로 새 id로 덮어씀
+        self->watches.insert(wd, id);
+    } else if (errno == ENOSPC) {
+        // 감시 한도(fs.inotify.max_user_watches) 초과: 색인은 계속 만들되 이후 변경은 놓칠 수 있음
+        self->watchesExhausted = true;
+    }
+    return 0;
+}
+
+void FileIndexer::crawl(uint32_t dir)
+{
+    file_index_crawl(index, dir, &FileIndexer::addWatch, this, &stopping);
+}
+
+void FileIndexer::rebuild()
+{
+    indexing = true;
+    emit indexStateChanged();
+
+    for (auto it = watches.constBegin(); it != watches.constEnd(); ++it)
+        inotify_rm_watch(inotifyFd, it.key());
+    watches.clear();
+    watchesExhausted = false;
+    file_index_clear(index);
+    crawl(FILE_INDEX_ROOT);
+
+    indexing = false;
+    emit indexStateChanged();
+}
+
+void FileIndexer::readEvents()
+{
+    alignas(struct inotify_event) char buf[64 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+    std::vector<Event> events;
+
+    for (;;) {
+        ssize_t len = read(inotifyFd, buf, sizeof(buf));
+        if (len <= 0) break;
+
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + event->len;
+            events.push_back({ event->wd, event->mask,
+                               event->len > 0 ? QByteArray(event->name) : QByteArray() });
+        }
+    }
+    if (events.empty() || !index) return;
+
+    // 크롤링과 같은 스레드에서 순서대로 반영해야 읽기와 이벤트가 엇갈리지 않음
+    writer.start(new IndexTask([this, events]() { applyEvents(events); }));
+}
+
+void FileIndexer::applyEvents(const std::vector<Event> &events)
+{
+    bool needRebuild = false;
+
+    for (const Event &event : events) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            needRebuild = true;
+            break;
+        }
+        if (event.mask & IN_IGNORED) {
+            watches.remove(event.wd);
+            continue;
+        }
+
+        auto it = watches.constFind(event.wd);
+        if (it == watches.constEnd()) continue;
+        uint32_t dir = it.value();
+
+        if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+            // 하위 디렉토리는 부모의 DELETE/MOVED_FROM으로 처리됨. 루트가 사라지면 새로 만듦
+            if (dir == FILE_INDEX_ROOT) needRebuild = true;
+            continue;
+        }
+        if (!file_index_is_live(index, dir)) {
+            // 트리 밖으로 옮겨진 디렉토리의 감시
+            inotify_rm_watch(inotifyFd, event.wd);
+            watches.remove(event.wd);
+            continue;
+        }
+        if (event.name.isEmpty()) continue;
+
+        if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+            file_index_remove(index, dir, event.name.constData());
+        } else if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+            bool isDir = event.mask & IN_ISDIR;
+            uint32_t child = file_index_add(index, dir, event.name.constData(), isDir);
+            // 옮겨 온 디렉토리는 내용이 이미 있으므로 하위까지 읽음
+            if (isDir && child != FILE_INDEX_NONE)
+                crawl(child);
+        }
+    }
+
+    struct file_index_stats stats;
+    file_index_get_stats(index, &stats);
+    if (stats.dead > REBUILD_MIN_DEAD && stats.dead > stats.live)
+        needRebuild = true;
+
+    if (needRebuild)
+        rebuild();
+}
@@ -0,0 +1,688 @@
+#define _GNU_SOURCE
+#include "../include/fileindex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define NODE_DIR    0x01
+#define NODE_DEAD   0x02
+
+#define SLOT_EMPTY  UINT32_MAX
+#define SLOT_TOMB   (UINT32_MAX - 1)
+
+#define MAX_QUERY_TRIGRAMS  64
+
+struct fi_node {
+    uint32_t parent;
+    uint32_t name_off;    // names 풀 안의 위치 (NUL 종료)
+    uint16_t name_len;
+    uint8_t flags;
+};
+
+// 트라이그램 하나의 id 목록. id는 추가 순서대로 늘어나므로 항상 오름차순
+struct fi_posting {
+    uint32_t key;         // 소문자 3바이트, 빈 칸은 SLOT_EMPTY
+    uint32_t len;
+    uint32_t capacity;
+    uint32_t *ids;
+};
+
+struct file_index {
+    pthread_rwlock_t lock;
+
+    struct fi_node *nodes;
+    size_t count;
+    size_t capacity;
+    size_t dead;
+
+    char *names;
+    size_t names_len;
+    size_t names_capacity;
+
+    uint32_t *slots;      // (부모, 이름) -> id 해시 (선형 탐사)
+    size_t nslots;
+    size_t slots_used;    // 삭제 표시 포함
+
+    struct fi_posting *postings;
+    size_t npostings;
+    size_t postings_used;
+};
+
+static inline unsigned char lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+static inline const char *node_name(const struct file_index *idx, uint32_t id) {
+    return idx->names + idx->nodes[id].name_off;
+}
+
+static uint32_t hash_name(uint32_t parent, const char *name, size_t len) {
+    // FNV-1a
+    uint32_t h = 2166136261u ^ parent;
+    h *= 16777619u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline uint32_t hash_trigram(uint32_t key) {
+    return key * 2654435761u;
+}
+
+// ---------------------------------------------------------------------------
+// (부모, 이름) 해시
+// ---------------------------------------------------------------------------
+
+static uint32_t *slot_find(struct file_index *idx, uint32_t parent, const char *name, size_t len) {
+    if (!idx->nslots) return NULL;
+    size_t mask = idx->nslots - 1;
+    for (size_t i = hash_name(parent, name, len) & mask; ; i = (i + 1) & mask) {
+        uint32_t id = idx->slots[i];
+        if (id == SLOT_EMPTY) return NULL;
+        if (id == SLOT_TOMB) continue;
+        const struct fi_node *n = &idx->nodes[id];
+        if (n->parent == parent && n->name_len == len && memcmp(node_name(idx, id), name, len) == 0)
+            return &idx->slots[i];
+    }
+}
+
+static void slot_insert_unchecked(struct file_index *idx, uint32_t id) {
+    const struct fi_node *n = &idx->nodes[id];
+    size_t mask = idx->nslots - 1;
+    size_t i = hash_name(n->parent, node_name(idx, id), n->name_len) & mask;
+    while (idx->slots[i] != SLOT_EMPTY && idx->slots[i] != SLOT_TOMB)
+        i = (i + 1) & mask;
+    if (idx->slots[i] == SLOT_EMPTY) idx->slots_used++;
+    idx->slots[i] = id;
+}
+
+static int slots_reserve(struct file_index *idx) {
+    if ((idx->slots_used + 1) * 10 < idx->nslots * 7) return 0;
+
+    // 삭제 표시가 많으면 같은 크기로 다시 만들어 정리
+    size_t live = idx->count - idx->dead;
+    size_t nslots = idx->nslots ? idx->nslots : 1024;
+    while ((live + 1) * 10 >= nslots * 5) nslots *= 2;
+    uint32_t *slots = malloc(nslots * sizeof(*slots));
+    if (!slots) return -1;
+    memset(slots, 0xff, nslots * sizeof(*slots));
+
+    free(idx->slots);
+    idx->slots = slots;
+    idx->nslots = nslots;
+    idx->slots_used = 0;
+    for (uint32_t id = 1; id < idx->count; id++) {
+        if (!(idx->nodes[id].flags & NODE_DEAD))
+            slot_insert_unchecked(idx, id);
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// 트라이그램 목록
+// ---------------------------------------------------------------------------
+
+static struct fi_posting *posting_find(const struct file_index *idx, uint32_t key) {
+    if (!idx->npostings) return NULL;
+    size_t mask = idx->npostings - 1;
+    for (size_t i = hash_trigram(key) & mask; ; i = (i + 1) & mask) {
+        if (idx->postings[i].key == key) return &idx->postings[i];
+        if (idx->postings[i].key == SLOT_EMPTY) return NULL;
+    }
+}
+
+static struct fi_posting *posting_get(struct file_index *idx, uint32_t key) {
+    struct fi_posting *p = posting_find(idx, key);
+    if (p) return p;
+
+    if ((idx->postings_used + 1) * 10 >= idx->npostings * 7) {
+        size_t n = idx->npostings ? idx->npostings * 2 : 4096;
+        struct fi_posting *grown = calloc(n, sizeof(*grown));
+        if (!grown) return NULL;
+        for (size_t i = 0; i < n; i++) grown[i].key = SLOT_EMPTY;
+        for (size_t i = 0; i < idx->npostings; i++) {
+            if (idx->postings[i].key == SLOT_EMPTY) continue;
+            size_t j = hash_trigram(idx->postings[i].key) & (n - 1);
+            while (grown[j].key != SLOT_EMPTY) j = (j + 1) & (n - 1);
+            grown[j] = idx->postings[i];
+        }
+        free(idx->postings);
+        idx->postings = grown;
+        idx->npostings = n;
+    }
+
+    size_t mask = idx->npostings - 1;
+    size_t i = hash_trigram(key) & mask;
+    while (idx->postings[i].key != SLOT_EMPTY) i = (i + 1) & mask;
+    idx->postings[i].key = key;
+    idx->postings_used++;
+    return &idx->postings[i];
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 소문자 트라이그램을 중복 없이 정렬해서 keys에 채움
+static size_t extract_trigrams(const char *s, size_t len, uint32_t *keys, size_t max) {
+    size_t n = 0;
+    for (size_t i = 0; i + 3 <= len && n < max; i++) {
+        keys[n++] = ((uint32_t)lower((unsigned char)s[i]) << 16) |
+                    ((uint32_t)lower((unsigned char)s[i + 1]) << 8) |
+                    lower((unsigned char)s[i + 2]);
+    }
+    qsort(keys, n, sizeof(*keys), compare_u32);
+    size_t unique = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (unique == 0 || keys[unique - 1] != keys[i])
+            keys[unique++] = keys[i];
+    }
+    return unique;
+}
+
+static void index_trigrams(struct file_index *idx, uint32_t id, const char *name, size_t len) {
+    uint32_t keys[NAME_MAX];
+    size_t n = extract_trigrams(name, len, keys, NAME_MAX);
+    for (size_t i = 0; i < n; i++) {
+        struct fi_posting *p = posting_get(idx, keys[i]);
+        if (!p) continue;
+        if (p->len == p->capacity) {
+            uint32_t capacity = p->capacity ? p->capacity * 2 : 4;
+            uint32_t *grown = realloc(p->ids, capacity * sizeof(*grown));
+            if (!grown) continue;
+            p->ids = grown;
+            p->capacity = capacity;
+        }
+        p->ids[p->len++] = id;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 항목 추가/삭제 (쓰기 잠금을 잡은 상태에서 호출)
+// ---------------------------------------------------------------------------
+
+static uint32_t add_locked(struct file_index *idx, uint32_t parent, const char *name, int is_dir) {
+    size_t len = strlen(name);
+    if (len == 0 || len > NAME_MAX || parent >= idx->count) return FILE_INDEX_NONE;
+
+    uint32_t *slot = slot_find(idx, parent, name, len);
+    if (slot) {
+        // 같은 이름이 유형만 바뀌었으면 (파일 -> 디렉토리 등) 다시 만듦
+        struct fi_node *n = &idx->nodes[*slot];
+        if (!!(n->flags & NODE_DIR) == !!is_dir) return *slot;
+        n->flags |= NODE_DEAD;
+        idx->dead++;
+        *slot = SLOT_TOMB;
+    }
+
+    if (idx->count >= FILE_INDEX_NONE - 2 || slots_reserve(idx) == -1)
+        return FILE_INDEX_NONE;
+    if (idx->count == idx->capacity) {
+        size_t capacity = idx->capacity * 2;
+        struct fi_node *grown = realloc(idx->nodes, capacity * sizeof(*grown));
+        if (!grown) return FILE_INDEX_NONE;
+        idx->nodes = grown;
+        idx->capacity = capacity;
+    }
+    if (idx->names_len + len + 1 > idx->names_capacity) {
+        size_t capacity = idx->names_capacity * 2;
+        while (capacity < idx->names_len + len + 1) capacity *= 2;
+        if (capacity > UINT32_MAX) return FILE_INDEX_NONE;
+        char *grown = realloc(idx->names, capacity);
+        if (!grown) return FILE_INDEX_NONE;
+        idx->names = grown;
+        idx->names_capacity = capacity;
+    }
+
+    uint32_t id = (uint32_t)idx->count++;
+    struct fi_node *n = &idx->nodes[id];
+    n->parent = parent;
+    n->name_off = (uint32_t)idx->names_len;
+    n->name_len = (uint16_t)len;
+    n->flags = is_dir ? NODE_DIR : 0;
+    memcpy(idx->names + idx->names_len, name, len + 1);
+    idx->names_len += len + 1;
+
+    slot_insert_unchecked(idx, id);
+    index_trigrams(idx, id, name, len);
+    return id;
+}
+
+// 자신과 모든 상위 디렉토리가 살아 있으면 1. scope_hit에는 scope를 지나쳤는지 기록
+static int node_live_in(const struct file_index *idx, uint32_t id, uint32_t scope, int *scope_hit) {
+    int hit = 0;
+    for (uint32_t p = id; p != FILE_INDEX_NONE; p = idx->nodes[p].parent) {
+        if (idx->nodes[p].flags & NODE_DEAD) return 0;
+        if (p == scope) hit = 1;
+    }
+    if (scope_hit) *scope_hit = hit;
+    return 1;
+}
+
+// 루트가 "/"처럼 '/'로 끝나면 구분자를 더 붙이지 않음
+static inline int needs_separator(const struct file_index *idx, uint32_t id) {
+    const struct fi_node *n = &idx->nodes[id];
+    return n->name_len == 0 || idx->names[n->name_off + n->name_len - 1] != '/';
+}
+
+static int path_locked(const struct file_index *idx, uint32_t id, char *buf, size_t size) {
+    size_t len = 0;
+    for (uint32_t p = id; p != FILE_INDEX_NONE; p = idx->nodes[p].parent) {
+        uint32_t parent = idx->nodes[p].parent;
+        len += idx->nodes[p].name_len + (parent != FILE_INDEX_NONE && needs_separator(idx, parent));
+    }
+    if (len + 1 > size) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    // 뒤에서부터 채움
+    buf[len] = '\0';
+    for (uint32_t p = id; p != FILE_INDEX_NONE; p = idx->nodes[p].parent) {
+        uint32_t parent = idx->nodes[p].parent;
+        len -= idx->nodes[p].name_len;
+        memcpy(buf + len, node_name(idx, p), idx->nodes[p].name_len);
+        if (parent != FILE_INDEX_NONE && needs_separator(idx, parent))
+            buf[--len] = '/';
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// 공개 API
+// ---------------------------------------------------------------------------
+
+static int init_storage(struct file_index *idx, const char *root) {
+    size_t len = strlen(root);
+    while (len > 1 && root[len - 1] == '/') len--;
+
+    idx->capacity = 1024;
+    idx->nodes = malloc(idx->capacity * sizeof(*idx->nodes));
+    idx->names_capacity = len + 1 > 65536 ? len + 1 : 65536;
+    idx->names = malloc(idx->names_capacity);
+    if (!idx->nodes || !idx->names || len > UINT16_MAX) return -1;
+
+    // 루트는 항상 0번, 이름은 루트 경로 전체
+    memcpy(idx->names, root, len);
+    idx->names[len] = '\0';
+    idx->names_len = len + 1;
+    idx->nodes[0].parent = FILE_INDEX_NONE;
+    idx->nodes[0].name_off = 0;
+    idx->nodes[0].name_len = (uint16_t)len;
+    idx->nodes[0].flags = NODE_DIR;
+    idx->count = 1;
+    idx->dead = 0;
+    return 0;
+}
+
+static void free_storage(struct file_index *idx) {
+    for (size_t i = 0; i < idx->npostings; i++)
+        free(idx->postings[i].ids);
+    free(idx->postings);
+    free(idx->slots);
+    free(idx->names);
+    free(idx->nodes);
+    idx->postings = NULL;
+    idx->npostings = idx->postings_used = 0;
+    idx->slots = NULL;
+    idx->nslots = idx->slots_used = 0;
+    idx->names = NULL;
+    idx->nodes = NULL;
+    idx->count = idx->capacity = idx->dead = 0;
+    idx->names_len = idx->names_capacity = 0;
+}
+
+struct file_index *file_index_create(const char *root) {
+    struct file_index *idx = calloc(1, sizeof(*idx));
+    if (!idx) return NULL;
+    if (init_storage(idx, root) == -1) {
+        free_storage(idx);
+        free(idx);
+        errno = ENOMEM;
+        return NULL;
+    }
+    pthread_rwlock_init(&idx->lock, NULL);
+    return idx;
+}
+
+void file_index_free(struct file_index *idx) {
+    if (!idx) return;
+    pthread_rwlock_destroy(&idx->lock);
+    free_storage(idx);
+    free(idx);
+}
+
+void file_index_clear(struct file_index *idx) {
+    pthread_rwlock_wrlock(&idx->lock);
+    char root[PATH_MAX];
+    snprintf(root, sizeof(root), "%s", node_name(idx, 0));
+    free_storage(idx);
+    init_storage(idx, root);
+    pthread_rwlock_unlock(&idx->lock);
+}
+
+uint32_t file_index_add(struct file_index *idx, uint32_t parent, const char *name, int is_dir) {
+    pthread_rwlock_wrlock(&idx->lock);
+    uint32_t id = add_locked(idx, parent, name, is_dir);
+    pthread_rwlock_unlock(&idx->lock);
+    return id;
+}
+
+void file_index_remove(struct file_index *idx, uint32_t parent, const char *name) {
+    pthread_rwlock_wrlock(&idx->lock);
+    uint32_t *slot = slot_find(idx, parent, name, strlen(name));
+    if (slot) {
+        // 트라이그램 목록의 id는 그대로 두고 검색 때 걸러냄. 하위 항목은 부모 표시로 함께 걸러짐
+        idx->nodes[*slot].flags |= NODE_DEAD;
+        idx->dead++;
+        *slot = SLOT_TOMB;
+    }
+    pthread_rwlock_unlock(&idx->lock);
+}
+
+uint32_t file_index_lookup(struct file_index *idx, uint32_t parent, const char *name) {
+    pthread_rwlock_rdlock(&idx->lock);
+    uint32_t *slot = slot_find(idx, parent, name, strlen(name));
+    uint32_t id = slot ? *slot : FILE_INDEX_NONE;
+    pthread_rwlock_unlock(&idx->lock);
+    return id;
+}
+
+uint32_t file_index_lookup_path(struct file_index *idx, const char *path) {
+    pthread_rwlock_rdlock(&idx->lock);
+    uint32_t id = FILE_INDEX_NONE;
+    size_t root_len = idx->nodes[0].name_len;
+    const char *root = node_name(idx, 0);
+
+    if (strncmp(path, root, root_len) == 0 &&
+        (path[root_len] == '\0' || path[root_len] == '/' || root[root_len - 1] == '/')) {
+        id = 0;
+        const char *p = path + root_len;
+        while (*p && id != FILE_INDEX_NONE) {
+            while (*p == '/') p++;
+            const char *end = strchrnul(p, '/');
+            if (end == p) break;
+            if (end - p == 1 && p[0] == '.') {
+                p = end;
+                continue;
+            }
+            uint32_t *slot = slot_find(idx, id, p, (size_t)(end - p));
+            id = slot ? *slot : FILE_INDEX_NONE;
+            p = end;
+        }
+    }
+    pthread_rwlock_unlock(&idx->lock);
+    return id;
+}
+
+int file_index_is_live(struct file_index *idx, uint32_t id) {
+    pthread_rwlock_rdlock(&idx->lock);
+    int live = id < idx->count && node_live_in(idx, id, FILE_INDEX_NONE, NULL);
+    pthread_rwlock_unlock(&idx->lock);
+    return live;
+}
+
+int file_index_path(struct file_index *idx, uint32_t id, char *buf, size_t size) {
+    pthread_rwlock_rdlock(&idx->lock);
+    int rc;
+    if (id >= idx->count) {
+        errno = ENOENT;
+        rc = -1;
+    } else {
+        rc = path_locked(idx, id, buf, size);
+    }
+    pthread_rwlock_unlock(&idx->lock);
+    return rc;
+}
+
+void file_index_get_stats(struct file_index *idx, struct file_index_stats *out) {
+    pthread_rwlock_rdlock(&idx->lock);
+    out->live = idx->count - 1 - idx->dead;
+    out->dead = idx->dead;
+    out->trigrams = idx->postings_used;
+    out->memory = idx->capacity * sizeof(*idx->nodes) + idx->names_capacity +
+                  idx->nslots * sizeof(*idx->slots) + idx->npostings * sizeof(*idx->postings);
+    for (size_t i = 0; i < idx->npostings; i++)
+        out->memory += idx->postings[i].capacity * sizeof(uint32_t);
+    pthread_rwlock_unlock(&idx->lock);
+}
+
+// 디렉토리 하나에서 읽은 이름들 (잠금 없이 모은 뒤 한 번에 추가)
+struct crawl_batch {
+    char *names;
+    size_t len;
+    size_t capacity;
+};
+
+static int batch_push(struct crawl_batch *b, const char *name, int is_dir) {
+    size_t len = strlen(name) + 2;
+    if (b->len + len > b->capacity) {
+        size_t capacity = b->capacity ? b->capacity * 2 : 4096;
+        while (capacity < b->len + len) capacity *= 2;
+        char *grown = realloc(b->names, capacity);
+        if (!grown) return -1;
+        b->names = grown;
+        b->capacity = capacity;
+    }
+    b->names[b->len] = is_dir ? 'd' : 'f';
+    memcpy(b->names + b->len + 1, name, len - 1);
+    b->len += len;
+    return 0;
+}
+
+int file_index_crawl(struct file_index *idx, uint32_t dir, file_index_dir_fn on_dir,
+                     void *ctx, const int *cancel) {
+    uint32_t *stack = malloc(64 * sizeof(*stack));
+    size_t depth = 0, stack_capacity = 64;
+    struct crawl_batch batch = { NULL, 0, 0 };
+    char path[PATH_MAX];
+    int rc = 0;
+
+    if (!stack) {
+        errno = ENOMEM;
+        return -1;
+    }
+    stack[depth++] = dir;
+
+    while (depth > 0) {
+        if (cancel && __atomic_load_n(cancel, __ATOMIC_RELAXED)) {
+            errno = ECANCELED;
+            rc = -1;
+            break;
+        }
+        uint32_t id = stack[--depth];
+
+        pthread_rwlock_rdlock(&idx->lock);
+        int ok = id < idx->count && node_live_in(idx, id, FILE_INDEX_NONE, NULL) &&
+                 path_locked(idx, id, path, sizeof(path)) == 0;
+        pthread_rwlock_unlock(&idx->lock);
+        if (!ok) continue;
+
+        // 감시를 먼저 걸어야 읽는 도중 생긴 항목도 이벤트로 잡힘
+        if (on_dir && on_dir(ctx, id, path) != 0) continue;
+
+        DIR *d = opendir(path);
+        if (!d) continue;
+        batch.len = 0;
+        struct dirent *e;
+        while ((e = readdir(d)) != NULL) {
+            if (e->d_name[0] == '.' &&
+                (e->d_name[1] == '\0' || (e->d_name[1] == '.' && e->d_name[2] == '\0')))
+                continue;
+            int is_dir = e->d_type == DT_DIR;
+            if (e->d_type == DT_UNKNOWN) {
+                struct stat st;
+                if (fstatat(dirfd(d), e->d_name, &st, AT_SYMLINK_NOFOLLOW) == -1) continue;
+                is_dir = S_ISDIR(st.st_mode);
+            }
+            batch_push(&batch, e->d_name, is_dir);
+        }
+        closedir(d);
+
+        pthread_rwlock_wrlock(&idx->lock);
+        for (size_t off = 0; off < batch.len; ) {
+            int is_dir = batch.names[off] == 'd';
+            const char *name = batch.names + off + 1;
+            off += strlen(name) + 2;
+            uint32_t child = add_locked(idx, id, name, is_dir);
+            if (!is_dir || child == FILE_INDEX_NONE) continue;
+            if (depth == stack_capacity) {
+                uint32_t *grown = realloc(stack, stack_capacity * 2 * sizeof(*stack));
+                if (!grown) continue;
+                stack = grown;
+                stack_capacity *= 2;
+            }
+            stack[depth++] = child;
+        }
+        pthread_rwlock_unlock(&idx->lock);
+    }
+
+    free(batch.names);
+    free(stack);
+    return rc;
+}
+
+// 글롭에서 와일드카드가 아닌 부분들의 트라이그램을 모음
+static size_t query_trigrams(const char *pattern, int is_glob, uint32_t *keys, size_t max) {
+    size_t n = 0;
+    char literal[NAME_MAX + 1];
+    size_t len = 0;
+
+    for (const char *p = pattern; ; p++) {
+        int boundary = *p == '\0';
+        if (is_glob && !boundary) {
+            if (*p == '*' || *p == '?') {
+                boundary = 1;
+            } else if (*p == '[') {
+                // 괄호 표현식은 건너뜀
+                const char *q = p + 1;
+                if (*q == '!' || *q == '^') q++;
+                if (*q == ']') q++;
+                while (*q && *q != ']') q++;
+                if (*q) p = q;
+                boundary = 1;
+            } else if (*p == '\\' && p[1]) {
+                p++;
+            }
+        }
+        if (boundary) {
+            if (len >= 3 && n < max)
+                n += extract_trigrams(literal, len, keys + n, max - n);
+            len = 0;
+            if (*p == '\0') break;
+            continue;
+        }
+        if (len < NAME_MAX) literal[len++] = *p;
+    }
+
+    qsort(keys, n, sizeof(*keys), compare_u32);
+    size_t unique = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (unique == 0 || keys[unique - 1] != keys[i])
+            keys[unique++] = keys[i];
+    }
+    return unique;
+}
+
+static int contains_casefold(const char *name, const char *needle, size_t needle_len) {
+    for (const char *s = name; *s; s++) {
+        size_t i = 0;
+        while (i < needle_len && s[i] && lower((unsigned char)s[i]) == (unsigned char)needle[i]) i++;
+        if (i == needle_len) return 1;
+    }
+    return needle_len == 0;
+}
+
+static int compare_posting_len(const void *a, const void *b) {
+    const struct fi_posting *x = *(const struct fi_posting *const *)a;
+    const struct fi_posting *y = *(const struct fi_posting *const *)b;
+    return (x->len > y->len) - (x->len < y->len);
+}
+
+size_t file_index_query(struct file_index *idx, const char *pattern, uint32_t scope,
+                        size_t limit, file_index_hit_fn fn, void *ctx) {
+    int is_glob = strpbrk(pattern, "*?[") != NULL;
+    char needle[NAME_MAX + 1];
+    size_t needle_len = 0;
+    if (!is_glob) {
+        for (; pattern[needle_len] && needle_len < NAME_MAX; needle_len++)
+            needle[needle_len] = (char)lower((unsigned char)pattern[needle_len]);
+        needle[needle_len] = '\0';
+    }
+
+    size_t hits = 0;
+    uint32_t keys[MAX_QUERY_TRIGRAMS];
+    size_t nkeys = query_trigrams(pattern, is_glob, keys, MAX_QUERY_TRIGRAMS);
+
+    pthread_rwlock_rdlock(&idx->lock);
+    if (scope >= idx->count) scope = FILE_INDEX_ROOT;
+
+    // 후보: 트라이그램 목록의 교집합 (짧은 목록부터), 트라이그램이 없으면 전체
+    uint32_t *candidates = NULL;
+    size_t ncandidates = 0;
+    int scan_all = nkeys == 0;
+    if (!scan_all) {
+        struct fi_posting *lists[MAX_QUERY_TRIGRAMS];
+        for (size_t i = 0; i < nkeys; i++) {
+            lists[i] = posting_find(idx, keys[i]);
+            if (!lists[i]) goto done;
+        }
+        qsort(lists, nkeys, sizeof(*lists), compare_posting_len);
+
+        candidates = malloc((lists[0]->len + 1) * sizeof(*candidates));
+        if (!candidates) goto done;
+        memcpy(candidates, lists[0]->ids, lists[0]->len * sizeof(*candidates));
+        ncandidates = lists[0]->len;
+        for (size_t k = 1; k < nkeys && ncandidates > 0; k++) {
+            const uint32_t *ids = lists[k]->ids;
+            size_t len = lists[k]->len, j = 0, out = 0;
+            for (size_t i = 0; i < ncandidates; i++) {
+                // 목록이 훨씬 길면 지수 탐색으로 건너뜀
+                size_t step = 1;
+                while (j + step < len && ids[j + step] < candidates[i]) {
+                    j += step;
+                    step *= 2;
+                }
+                while (j < len && ids[j] < candidates[i]) j++;
+                if (j == len) break;
+                if (ids[j] == candidates[i]) candidates[out++] = candidates[i];
+            }
+            ncandidates = out;
+        }
+    }
+
+    size_t total = scan_all ? idx->count : ncandidates;
+    char path[PATH_MAX];
+    for (size_t i = 0; i < total; i++) {
+        uint32_t id = scan_all ? (uint32_t)i : candidates[i];
+        if (id == scope || id == FILE_INDEX_ROOT) continue;
+
+        const char *name = node_name(idx, id);
+        int match = is_glob ? fnmatch(pattern, name, FNM_CASEFOLD) == 0
+                            : contains_casefold(name, needle, needle_len);
+        if (!match) continue;
+
+        int in_scope = 0;
+        if (!node_live_in(idx, id, scope, &in_scope) || !in_scope) continue;
+        if (path_locked(idx, id, path, sizeof(path)) == -1) continue;
+
+        hits++;
+        if (fn(ctx, id, path, !!(idx->nodes[id].flags & NODE_DIR)) != 0) break;
+        if (limit && hits >= limit) break;
+    }
+
+done:
+    pthread_rwlock_unlock(&idx->lock);
+    free(candidates);
+    return hits;
+}
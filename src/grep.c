@@ -0,0 +1,731 @@
+#define _GNU_SOURCE
+#include "../include/grep.h"
+#include "../include/mapguard.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+#include <regex.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define QUEUE_CAPACITY      1024          // 워커가 밀리면 탐색 스레드가 기다림
+#define READ_LIMIT          (128 * 1024)  // 이 크기 이하는 read, 넘으면 mmap
+#define PENDING_FLUSH       1024          // 큰 파일은 이만큼 모이면 중간에 내보냄
+#define BMH_MIN_LEN         16            // 이 길이 이상의 고정 문자열은 BMH
+
+// ---------------------------------------------------------------------------
+// 패턴 매칭
+// ---------------------------------------------------------------------------
+
+enum { MATCH_LITERAL, MATCH_BMH, MATCH_REGEX };
+
+struct matcher {
+    int kind;
+    int icase;
+    const unsigned char *pat;     // 대소문자 무시면 소문자로 바꾼 패턴
+    size_t len;
+    size_t anchor;                // 후보를 찾을 때 쓰는 (가장 드문) 바이트 위치
+    unsigned char anchor_lo, anchor_hi;
+    size_t skip[256];             // BMH 건너뛰기 표
+    regex_t re;
+};
+
+static inline unsigned char lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+static inline unsigned char upper(unsigned char c) {
+    return (c >= 'a' && c <= 'z') ? (unsigned char)(c - 32) : c;
+}
+
+// 텍스트에서 흔한 바이트일수록 큰 값. 목록에 없는 바이트가 가장 드묾
+static int byte_rank(unsigned char c) {
+    static const char common[] = "zqjxkvbpygfwmucldrhsnioate \n";
+    static const char middle[] = "ZQJXKVBYPGFWMUCLDRHSNIOATE9876543210_-.:/,=\"'()\t";
+    const char *p;
+    if (c && (p = strchr(common, c)) != NULL) return 100 + (int)(p - common);
+    if (c && (p = strchr(middle, c)) != NULL) return 50 + (int)(p - middle);
+    return 0;
+}
+
+// 두 바이트 중 하나를 찾는 memchr (대소문자 무시 후보 탐색용)
+static const unsigned char *memchr2(unsigned char a, unsigned char b,
+                                    const unsigned char *p, size_t len) {
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i va = _mm_set1_epi8((char)a);
+    const __m128i vb = _mm_set1_epi8((char)b);
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+        if (mask) return p + i + __builtin_ctz((unsigned)mask);
+    }
+#endif
+    for (; i < len; i++) {
+        if (p[i] == a || p[i] == b) return p + i;
+    }
+    return NULL;
+}
+
+// 개행 수 (줄 번호 계산용)
+static unsigned long count_newlines(const unsigned char *p, size_t len) {
+    unsigned long n = 0;
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        n += (unsigned long)__builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+    }
+#endif
+    for (; i < len; i++)
+        n += p[i] == '\n';
+    return n;
+}
+
+static int has_regex_meta(const char *s) {
+    return strpbrk(s, ".[]()*+?{}|^$\\") != NULL;
+}
+
+static int matcher_init(struct matcher *m, const char *pattern, int flags,
+                        unsigned char *pat_buf, char *error, size_t error_size) {
+    memset(m, 0, sizeof(*m));
+    m->icase = !!(flags & GREP_IGNORE_CASE);
+    m->len = strlen(pattern);
+
+    // 메타 문자가 없는 정규식은 고정 문자열로 처리
+    if ((flags & GREP_REGEX) && has_regex_meta(pattern)) {
+        m->kind = MATCH_REGEX;
+        int rc = regcomp(&m->re, pattern, REG_EXTENDED | REG_NEWLINE | (m->icase ? REG_ICASE : 0));
+        if (rc != 0) {
+            regerror(rc, &m->re, error, error_size);
+            return -1;
+        }
+        return 0;
+    }
+
+    for (size_t i = 0; i < m->len; i++)
+        pat_buf[i] = m->icase ? lower((unsigned char)pattern[i]) : (unsigned char)pattern[i];
+    m->pat = pat_buf;
+
+    if (!m->icase && m->len >= BMH_MIN_LEN) {
+        m->kind = MATCH_BMH;
+        for (size_t i = 0; i < 256; i++) m->skip[i] = m->len;
+        for (size_t i = 0; i + 1 < m->len; i++) m->skip[m->pat[i]] = m->len - 1 - i;
+        return 0;
+    }
+
+    m->kind = MATCH_LITERAL;
+    int best = INT_MAX;
+    for (size_t i = 0; i < m->len; i++) {
+        int rank = byte_rank(m->pat[i]);
+        if (m->icase) {
+            int other = byte_rank(upper(m->pat[i]));
+            if (other > rank) rank = other;
+        }
+        if (rank < best) {
+            best = rank;
+            m->anchor = i;
+        }
+    }
+    m->anchor_lo = m->len ? m->pat[m->anchor] : 0;
+    m->anchor_hi = m->icase ? upper(m->anchor_lo) : m->anchor_lo;
+    return 0;
+}
+
+static int equal_casefold(const unsigned char *text, const unsigned char *pat, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (lower(text[i]) != pat[i]) return 0;
+    }
+    return 1;
+}
+
+// [p, end)에서 고정 문자열의 첫 위치
+static const unsigned char *find_literal(const struct matcher *m, const unsigned char *p,
+                                         const unsigned char *end) {
+    size_t len = (size_t)(end - p);
+    if (m->len == 0) return p;
+    if (len < m->len) return NULL;
+
+    if (m->kind == MATCH_BMH) {
+        const unsigned char last = m->pat[m->len - 1];
+        for (size_t i = 0; i + m->len <= len; ) {
+            unsigned char c = p[i + m->len - 1];
+            if (c == last && memcmp(p + i, m->pat, m->len - 1) == 0)
+                return p + i;
+            i += m->skip[c];
+        }
+        return NULL;
+    }
+
+    // 드문 바이트를 SIMD memchr로 찾고 그 자리에서 전체를 비교
+    const unsigned char *scan = p + m->anchor;
+    const unsigned char *scan_end = end - (m->len - 1 - m->anchor);
+    while (scan < scan_end) {
+        const unsigned char *q = m->anchor_lo == m->anchor_hi
+            ? memchr(scan, m->anchor_lo, (size_t)(scan_end - scan))
+            : memchr2(m->anchor_lo, m->anchor_hi, scan, (size_t)(scan_end - scan));
+        if (!q) return NULL;
+        const unsigned char *candidate = q - m->anchor;
+        if (m->icase ? equal_casefold(candidate, m->pat, m->len)
+                     : memcmp(candidate, m->pat, m->len) == 0)
+            return candidate;
+        scan = q + 1;
+    }
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// 작업
+// ---------------------------------------------------------------------------
+
+struct grep_job {
+    const char *pattern;
+    int flags;
+    unsigned long long max_file_size;
+    unsigned long long max_matches;
+    grep_hit_fn fn;
+    void *ctx;
+    const int *cancel;
+    struct grep_stats *stats;
+    int stop;                       // 취소, 콜백 중단, 최대 개수 도달
+
+    pthread_mutex_t lock;           // 파일 큐
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    char *queue[QUEUE_CAPACITY];
+    size_t head, count;
+    int walk_done;
+
+    pthread_mutex_t out_lock;       // 결과 전달과 통계의 오류 메시지
+};
+
+struct pending_hit {
+    unsigned long line;
+    const unsigned char *text;
+    size_t len;
+};
+
+struct worker {
+    struct grep_job *job;
+    struct matcher m;
+    unsigned char *pat_buf;
+    unsigned char *buf;             // 작은 파일을 읽는 버퍼
+    struct pending_hit *pending;
+    size_t npending;
+};
+
+static int job_stopped(struct grep_job *job) {
+    if (__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) return 1;
+    if (job->cancel && __atomic_load_n(job->cancel, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    return 0;
+}
+
+static void job_record_error(struct grep_job *job, const char *path, int err) {
+    __atomic_add_fetch(&job->stats->errors, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&job->out_lock);
+    if (job->stats->error[0] == '\0')
+        snprintf(job->stats->error, sizeof(job->stats->error), "%s: %s", path, strerror(err));
+    pthread_mutex_unlock(&job->out_lock);
+}
+
+// 한 파일에서 모은 결과를 한 번에 내보냄 (파일 안의 줄이 섞이지 않도록)
+static void flush_hits(struct worker *w, const char *path) {
+    struct grep_job *job = w->job;
+    if (w->npending == 0) return;
+
+    pthread_mutex_lock(&job->out_lock);
+    for (size_t i = 0; i < w->npending && !__atomic_load_n(&job->stop, __ATOMIC_RELAXED); i++) {
+        if (job->max_matches && job->stats->matches >= job->max_matches) {
+            job->stats->truncated = 1;
+            __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        job->stats->matches++;
+        const struct pending_hit *h = &w->pending[i];
+        if (job->fn(job->ctx, path, h->line, (const char *)h->text, h->len) != 0)
+            __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&job->out_lock);
+    w->npending = 0;
+}
+
+// 다음 일치 위치 (정규식은 [p, end)를 한 번에 검사)
+static const unsigned char *find_match(struct worker *w, const unsigned char *base,
+                                       const unsigned char *p, const unsigned char *end) {
+    if (w->m.kind != MATCH_REGEX)
+        return find_literal(&w->m, p, end);
+
+#ifdef REG_STARTEND
+    regmatch_t match;
+    match.rm_so = (regoff_t)(p - base);
+    match.rm_eo = (regoff_t)(end - base);
+    if (regexec(&w->m.re, (const char *)base, 1, &match, REG_STARTEND) != 0)
+        return NULL;
+    return base + match.rm_so;
+#else
+    // REG_STARTEND가 없으면 줄 단위로 복사해서 검사
+    char line[4096];
+    while (p < end) {
+        const unsigned char *nl = memchr(p, '\n', (size_t)(end - p));
+        size_t len = (size_t)((nl ? nl : end) - p);
+        if (len >= sizeof(line)) len = sizeof(line) - 1;
+        memcpy(line, p, len);
+        line[len] = '\0';
+        if (regexec(&w->m.re, line, 0, NULL, 0) == 0) return p;
+        if (!nl) break;
+        p = nl + 1;
+    }
+    (void)base;
+    return NULL;
+#endif
+}
+
+// first_line은 data 첫 줄의 줄 번호 (스트림을 나눠서 검사할 때 1이 아님)
+static int search_buffer(struct worker *w, const char *path, const unsigned char *data, size_t size,
+                         unsigned long first_line) {
+    const unsigned char *end = data + size;
+    const unsigned char *p = data;
+    const unsigned char *counted = data;   // 이 위치까지의 개행 수가 line에 반영됨
+    unsigned long line = first_line;
+    int matched = 0;
+
+    while (p < end && !job_stopped(w->job)) {
+        const unsigned char *hit = find_match(w, data, p, end);
+        if (!hit) break;
+
+        const unsigned char *prev_nl = memrchr(p, '\n', (size_t)(hit - p));
+        const unsigned char *line_start = prev_nl ? prev_nl + 1 : p;
+        const unsigned char *line_end = memchr(hit, '\n', (size_t)(end - hit));
+        if (!line_end) line_end = end;
+
+        line += count_newlines(counted, (size_t)(line_start - counted));
+        counted = line_start;
+
+        size_t len = (size_t)(line_end - line_start);
+        if (len > 0 && line_start[len - 1] == '\r') len--;
+        w->pending[w->npending].line = line;
+        w->pending[w->npending].text = line_start;
+        w->pending[w->npending].len = len;
+        w->npending++;
+        matched = 1;
+        if (w->npending == PENDING_FLUSH)
+            flush_hits(w, path);
+
+        // 한 줄은 한 번만 보고
+        p = line_end + 1;
+    }
+    flush_hits(w, path);
+    return matched;
+}
+
+static void search_file(struct worker *w, const char *path) {
+    struct grep_job *job = w->job;
+    int fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd == -1) {
+        if (errno != ENOENT && errno != ELOOP) job_record_error(job, path, errno);
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        job_record_error(job, path, errno);
+        close(fd);
+        return;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        return;
+    }
+    if ((unsigned long long)st.st_size > job->max_file_size) {
+        __atomic_add_fetch(&job->stats->skipped_large, 1, __ATOMIC_RELAXED);
+        close(fd);
+        return;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const unsigned char *data = w->buf;
+    unsigned char *heap = NULL;
+    void *map = NULL;
+    int guard = -1;
+    if (size > READ_LIMIT) {
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            job_record_error(job, path, errno);
+            close(fd);
+            return;
+        }
+        // 검색 중에 다른 프로세스가 파일을 줄이면 잘린 페이지가 SIGBUS를 내므로 보호 구역에 넣음.
+        // 보호 슬롯이 모자라면 매핑 대신 통째로 읽음
+        guard = map_guard_add(map, size);
+        if (guard == -1) {
+            munmap(map, size);
+            map = NULL;
+            heap = malloc(size);
+            if (!heap) {
+                job_record_error(job, path, ENOMEM);
+                close(fd);
+                return;
+            }
+        } else {
+            madvise(map, size, MADV_SEQUENTIAL);
+            data = map;
+        }
+    }
+    if (!map) {
+        // 작은 파일은 read 한두 번이 mmap/munmap보다 빠름. 읽는 사이 커진 부분은 무시
+        unsigned char *dst = heap ? heap : w->buf;
+        size_t got = 0;
+        while (got < size) {
+            ssize_t n = read(fd, dst + got, size - got);
+            if (n <= 0) {
+                if (n == -1 && errno == EINTR) continue;
+                break;
+            }
+            got += (size_t)n;
+        }
+        size = got;
+        data = dst;
+    }
+    close(fd);
+
+    size_t probe = size < GREP_BINARY_PROBE ? size : GREP_BINARY_PROBE;
+    if (!(job->flags & GREP_BINARY) && memchr(data, 0, probe)) {
+        __atomic_add_fetch(&job->stats->skipped_binary, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_add_fetch(&job->stats->files_searched, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&job->stats->bytes_searched, size, __ATOMIC_RELAXED);
+        if (search_buffer(w, path, data, size, 1))
+            __atomic_add_fetch(&job->stats->files_matched, 1, __ATOMIC_RELAXED);
+    }
+
+    if (map) {
+        map_guard_remove(guard);
+        munmap(map, (size_t)st.st_size);
+    }
+    free(heap);
+}
+
+static void *worker_main(void *arg) {
+    struct worker *w = arg;
+    struct grep_job *job = w->job;
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        while (job->count == 0 && !job->walk_done)
+            pthread_cond_wait(&job->not_empty, &job->lock);
+        if (job->count == 0) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        char *path = job->queue[job->head];
+        job->head = (job->head + 1) % QUEUE_CAPACITY;
+        job->count--;
+        pthread_cond_signal(&job->not_full);
+        pthread_mutex_unlock(&job->lock);
+
+        // 멈춘 뒤에는 큐만 비움
+        if (!job_stopped(job))
+            search_file(w, path);
+        free(path);
+    }
+    return NULL;
+}
+
+static int queue_push(struct grep_job *job, const char *path) {
+    char *copy = strdup(path);
+    if (!copy) return -1;
+    pthread_mutex_lock(&job->lock);
+    while (job->count == QUEUE_CAPACITY)
+        pthread_cond_wait(&job->not_full, &job->lock);
+    job->queue[(job->head + job->count) % QUEUE_CAPACITY] = copy;
+    job->count++;
+    pthread_cond_signal(&job->not_empty);
+    pthread_mutex_unlock(&job->lock);
+    return 0;
+}
+
+// 심볼릭 링크는 따라가지 않음 (grep -r과 같음)
+static void walk(struct grep_job *job, const char *root) {
+    struct stat st;
+    if (lstat(root, &st) == -1) {
+        job_record_error(job, root, errno);
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        if (S_ISREG(st.st_mode)) queue_push(job, root);
+        return;
+    }
+
+    size_t depth = 0, capacity = 64;
+    char **stack = malloc(capacity * sizeof(*stack));
+    if (!stack || !(stack[depth] = strdup(root))) {
+        free(stack);
+        return;
+    }
+    depth++;
+
+    char path[PATH_MAX];
+    while (depth > 0) {
+        char *dir_path = stack[--depth];
+        if (job_stopped(job)) {
+            free(dir_path);
+            continue;
+        }
+
+        DIR *dir = opendir(dir_path);
+        if (!dir) {
+            if (errno != ENOENT) job_record_error(job, dir_path, errno);
+            free(dir_path);
+            continue;
+        }
+
+        struct dirent *e;
+        while ((e = readdir(dir)) != NULL && !job_stopped(job)) {
+            if (e->d_name[0] == '.' &&
+                (e->d_name[1] == '\0' || (e->d_name[1] == '.' && e->d_name[2] == '\0')))
+                continue;
+
+            unsigned char type = e->d_type;
+            if (type == DT_UNKNOWN) {
+                struct stat est;
+                if (fstatat(dirfd(dir), e->d_name, &est, AT_SYMLINK_NOFOLLOW) == -1) continue;
+                type = S_ISDIR(est.st_mode) ? DT_DIR : S_ISREG(est.st_mode) ? DT_REG : DT_UNKNOWN;
+            }
+            if (type != DT_DIR && type != DT_REG) continue;
+
+            int n = snprintf(path, sizeof(path), "%s%s%s", dir_path,
+                             dir_path[strlen(dir_path) - 1] == '/' ? "" : "/", e->d_name);
+            if (n < 0 || (size_t)n >= sizeof(path)) {
+                job_record_error(job, e->d_name, ENAMETOOLONG);
+                continue;
+            }
+
+            if (type == DT_REG) {
+                queue_push(job, path);
+                continue;
+            }
+            if (depth == capacity) {
+                char **grown = realloc(stack, capacity * 2 * sizeof(*stack));
+                if (!grown) continue;
+                stack = grown;
+                capacity *= 2;
+            }
+            if ((stack[depth] = strdup(path)) != NULL) depth++;
+        }
+        closedir(dir);
+        free(dir_path);
+    }
+    while (depth > 0) free(stack[--depth]);
+    free(stack);
+}
+
+int grep_run(const char *const *paths, size_t n, const char *pattern,
+             const struct grep_options *opts, grep_hit_fn fn, void *ctx,
+             const int *cancel, struct grep_stats *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    struct grep_options defaults = { 0, 0, 0, 0 };
+    if (!opts) opts = &defaults;
+    int nworkers = opts->workers;
+    if (nworkers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nworkers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (nworkers > GREP_MAX_WORKERS) nworkers = GREP_MAX_WORKERS;
+
+    struct grep_job job;
+    memset(&job, 0, sizeof(job));
+    job.pattern = pattern;
+    job.flags = opts->flags;
+    job.max_file_size = opts->max_file_size ? opts->max_file_size : GREP_DEFAULT_MAX_SIZE;
+    job.max_matches = opts->max_matches;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.cancel = cancel;
+    job.stats = stats;
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.not_empty, NULL);
+    pthread_cond_init(&job.not_full, NULL);
+    pthread_mutex_init(&job.out_lock, NULL);
+
+    // 워커마다 매처를 따로 둠 (glibc regexec는 같은 regex_t에서 서로를 잠금으로 기다림)
+    struct worker workers[GREP_MAX_WORKERS];
+    pthread_t threads[GREP_MAX_WORKERS];
+    int started = 0, err = 0;
+    size_t pat_len = strlen(pattern);
+    for (int i = 0; i < nworkers; i++) {
+        struct worker *w = &workers[i];
+        memset(w, 0, sizeof(*w));
+        w->job = &job;
+        w->pat_buf = malloc(pat_len + 1);
+        w->buf = malloc(READ_LIMIT);
+        w->pending = malloc(PENDING_FLUSH * sizeof(*w->pending));
+        if (!w->pat_buf || !w->buf || !w->pending) {
+            free(w->pat_buf);
+            free(w->buf);
+            free(w->pending);
+            break;
+        }
+        if (matcher_init(&w->m, pattern, opts->flags, w->pat_buf, stats->error, sizeof(stats->error)) == -1) {
+            free(w->pat_buf);
+            free(w->buf);
+            free(w->pending);
+            err = EINVAL;
+            break;
+        }
+        if (pthread_create(&threads[i], NULL, worker_main, w) != 0) {
+            if (w->m.kind == MATCH_REGEX) regfree(&w->m.re);
+            free(w->pat_buf);
+            free(w->buf);
+            free(w->pending);
+            break;
+        }
+        started++;
+    }
+
+    if (err == 0 && started == 0)
+        err = ENOMEM;
+    if (err == 0) {
+        for (size_t i = 0; i < n && !job_stopped(&job); i++)
+            walk(&job, paths[i]);
+    } else {
+        __atomic_store_n(&job.stop, 1, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_lock(&job.lock);
+    job.walk_done = 1;
+    pthread_cond_broadcast(&job.not_empty);
+    pthread_mutex_unlock(&job.lock);
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        if (workers[i].m.kind == MATCH_REGEX) regfree(&workers[i].m.re);
+        free(workers[i].pat_buf);
+        free(workers[i].buf);
+        free(workers[i].pending);
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    pthread_cond_destroy(&job.not_empty);
+    pthread_cond_destroy(&job.not_full);
+    pthread_mutex_destroy(&job.out_lock);
+
+    if (err == 0 && cancel && __atomic_load_n(cancel, __ATOMIC_RELAXED))
+        err = ECANCELED;
+    if (err) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+int grep_fd(int fd, const char *label, const char *pattern,
+            const struct grep_options *opts, grep_hit_fn fn, void *ctx,
+            const int *cancel, struct grep_stats *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    struct grep_options defaults = { 0, 0, 0, 0 };
+    if (!opts) opts = &defaults;
+
+    struct grep_job job;
+    memset(&job, 0, sizeof(job));
+    job.pattern = pattern;
+    job.flags = opts->flags;
+    job.max_matches = opts->max_matches;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.cancel = cancel;
+    job.stats = stats;
+    pthread_mutex_init(&job.out_lock, NULL);
+
+    // 스트림은 나눌 수 없으므로 호출한 스레드가 워커 하나로 직접 검사
+    struct worker w;
+    memset(&w, 0, sizeof(w));
+    w.job = &job;
+    w.pat_buf = malloc(strlen(pattern) + 1);
+    w.buf = malloc(READ_LIMIT);
+    w.pending = malloc(PENDING_FLUSH * sizeof(*w.pending));
+    int err = 0, have_matcher = 0;
+    if (!w.pat_buf || !w.buf || !w.pending)
+        err = ENOMEM;
+    else if (matcher_init(&w.m, pattern, opts->flags, w.pat_buf, stats->error, sizeof(stats->error)) == -1)
+        err = EINVAL;
+    else
+        have_matcher = 1;
+
+    // 완성된 줄까지만 검사하고 남은 조각은 버퍼 앞으로 옮겨 다음 read와 이어 붙임.
+    // 버퍼보다 긴 줄은 READ_LIMIT 단위로 잘라서 검사
+    size_t used = 0;
+    unsigned long line = 1;
+    int probed = 0, matched = 0, binary = 0;
+    while (err == 0 && !job_stopped(&job)) {
+        ssize_t n = read(fd, w.buf + used, READ_LIMIT - used);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            err = errno;
+            break;
+        }
+        int eof = n == 0;
+        used += (size_t)n;
+
+        if (!probed && used > 0) {
+            probed = 1;
+            size_t probe = used < GREP_BINARY_PROBE ? used : GREP_BINARY_PROBE;
+            if (!(job.flags & GREP_BINARY) && memchr(w.buf, 0, probe)) {
+                binary = 1;
+                stats->skipped_binary++;
+                break;
+            }
+        }
+
+        size_t len = used;
+        if (!eof) {
+            const unsigned char *nl = memrchr(w.buf, '\n', used);
+            if (nl) len = (size_t)(nl + 1 - w.buf);
+            else if (used < READ_LIMIT) continue;
+        }
+        if (len > 0) {
+            stats->bytes_searched += len;
+            if (search_buffer(&w, label, w.buf, len, line)) matched = 1;
+            line += count_newlines(w.buf, len);
+            memmove(w.buf, w.buf + len, used - len);
+            used -= len;
+        }
+        if (eof) break;
+    }
+    if (probed && !binary) {
+        stats->files_searched = 1;
+        stats->files_matched = (unsigned long long)matched;
+    }
+
+    if (have_matcher && w.m.kind == MATCH_REGEX) regfree(&w.m.re);
+    free(w.pat_buf);
+    free(w.buf);
+    free(w.pending);
+    pthread_mutex_destroy(&job.out_lock);
+
+    if (err == 0 && cancel && __atomic_load_n(cancel, __ATOMIC_RELAXED))
+        err = ECANCELED;
+    if (err) {
+        if (err != EINVAL && stats->error[0] == '\0')
+            snprintf(stats->error, sizeof(stats->error), "%s: %s", label, strerror(err));
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include "../include/grep_panel.h"
+#include "../include/grep.h"
+#include <QCheckBox>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFont>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPushButton>
+#include <QRunnable>
+#include <QVBoxLayout>
+#include <functional>
+#include <errno.h>
+#include <string.h>
+
+namespace {
+
+class GrepTask : public QRunnable {
+public:
+    explicit GrepTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+struct SearchContext {
+    QVector<GrepPanel::Hit> batch;
+    QElapsedTimer sinceFlush;
+    std::function<void(const QVector<GrepPanel::Hit> &)> flush;
+};
+
+// 엔진이 결과 전달을 직렬화하므로 잠금 없이 모아서 묶음 단위로 넘김
+int collectHit(void *arg, const char *path, unsigned long line, const char *text, size_t len)
+{
+    SearchContext *ctx = static_cast<SearchContext *>(arg);
+
+    // 아주 긴 줄은 앞부분만 디코딩
+    const size_t maxBytes = 4 * static_cast<size_t>(GrepPanel::MAX_LINE_CHARS);
+    size_t shown = len < maxBytes ? len : maxBytes;
+    QString lineText = QString::fromLocal8Bit(text, static_cast<int>(shown));
+    if (lineText.size() > GrepPanel::MAX_LINE_CHARS)
+        lineText = lineText.left(GrepPanel::MAX_LINE_CHARS) + QStringLiteral("...");
+
+    ctx->batch.append({ QString::fromLocal8Bit(path), line, lineText });
+    if (ctx->batch.size() >= GrepPanel::RESULT_BATCH ||
+        ctx->sinceFlush.elapsed() >= GrepPanel::BATCH_INTERVAL_MS) {
+        ctx->flush(ctx->batch);
+        ctx->batch.clear();
+        ctx->sinceFlush.restart();
+    }
+    return 0;
+}
+
+}  // namespace
+
+GrepPanel::GrepPanel(QWidget *parent) : QWidget(parent)
+{
+    pool.setMaxThreadCount(1);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    dirLabel = new QLabel(this);
+    layout->addWidget(dirLabel);
+
+    QHBoxLayout *queryLayout = new QHBoxLayout();
+    patternEdit = new QLineEdit(this);
+    patternEdit->setPlaceholderText(tr("검색할 내용..."));
+    ignoreCase = new QCheckBox(tr("대소문자 무시"), this);
+    regex = new QCheckBox(tr("정규식"), this);
+    searchButton = new QPushButton(tr("검색"), this);
+    stopButton = new QPushButton(tr("중지"), this);
+    stopButton->setEnabled(false);
+    queryLayout->addWidget(patternEdit, 1);
+    queryLayout->addWidget(ignoreCase);
+    queryLayout->addWidget(regex);
+    queryLayout->addWidget(searchButton);
+    queryLayout->addWidget(stopButton);
+    layout->addLayout(queryLayout);
+
+    results = new QListWidget(this);
+    results->setUniformItemSizes(true);
+    results->setFont(QFont("Monospace"));
+    layout->addWidget(results);
+
+    statusLabel = new QLabel(this);
+    layout->addWidget(statusLabel);
+
+    connect(searchButton, &QPushButton::clicked, this, [this]() { startSearch(); });
+    connect(patternEdit, &QLineEdit::returnPressed, this, [this]() { startSearch(); });
+    connect(stopButton, &QPushButton::clicked, this, [this]() { stopSearch(); });
+    connect(results, &QListWidget::itemDoubleClicked, this, [this](QListWidgetItem *item) {
+        emit openRequested(item->data(Qt::UserRole).toString(),
+                           item->data(Qt::UserRole + 1).toULongLong());
+    });
+}
+
+GrepPanel::~GrepPanel()
+{
+    stopSearch();
+    pool.waitForDone();
+}
+
+void GrepPanel::setDirectory(const QString &path)
+{
+    directory = path;
+    dirLabel->setText(tr("검색 위치: %1").arg(path));
+}
+
+void GrepPanel::stopSearch()
+{
+    if (cancelFlag)
+        __atomic_store_n(cancelFlag.get(), 1, __ATOMIC_RELAXED);
+}
+
+void GrepPanel::startSearch()
+{
+    QString pattern = patternEdit->text();
+    if (pattern.isEmpty() || directory.isEmpty()) return;
+
+    // 이전 검색은 취소하고 그 결과는 번호로 걸러냄
+    stopSearch();
+    qulonglong gen = ++generation;
+    std::shared_ptr<int> cancel = std::make_shared<int>(0);
+    cancelFlag = cancel;
+    searchRoot = directory;
+
+    results->clear();
+    statusLabel->setText(tr("검색 중..."));
+    stopButton->setEnabled(true);
+
+    struct grep_options opts = { 0, 0, 0, MAX_RESULTS };
+    if (ignoreCase->isChecked()) opts.flags |= GREP_IGNORE_CASE;
+    if (regex->isChecked()) opts.flags |= GREP_REGEX;
+
+    QByteArray localPattern = pattern.toLocal8Bit();
+    QByteArray localDir = directory.toLocal8Bit();
+    pool.start(new GrepTask([this, gen, cancel, opts, localPattern, localDir]() {
+        QElapsedTimer elapsed;
+        elapsed.start();
+
+        SearchContext ctx;
+        ctx.sinceFlush.start();
+        ctx.flush = [this, gen](const QVector<Hit> &hits) {
+            QMetaObject::invokeMethod(this, [this, gen, hits]() { appendHits(gen, hits); },
+                                      Qt::QueuedConnection);
+        };
+
+        const char *paths[] = { localDir.constData() };
+        struct grep_stats stats;
+        int rc = grep_run(paths, 1, localPattern.constData(), &opts, collectHit, &ctx,
+                          cancel.get(), &stats);
+        int err = errno;
+        if (!ctx.batch.isEmpty())
+            ctx.flush(ctx.batch);
+
+        QString summary;
+        if (rc == -1 && err == ECANCELED) {
+            summary = tr("중지됨: 파일 %1개에서 %2줄").arg(stats.files_matched).arg(stats.matches);
+        } else if (rc == -1) {
+            summary = stats.error[0] ? tr("검색할 수 없습니다: %1").arg(QString::fromLocal8Bit(stats.error))
+                                     : tr("검색할 수 없습니다: %1").arg(QString::fromLocal8Bit(strerror(err)));
+        } else {
+            summary = tr("파일 %1개 중 %2개에서 %3줄 (%4 MB, %5초)")
+                      .arg(stats.files_searched).arg(stats.files_matched).arg(stats.matches)
+                      .arg(stats.bytes_searched / (1024.0 * 1024.0), 0, 'f', 1)
+                      .arg(elapsed.elapsed() / 1000.0, 0, 'f', 2);
+            if (stats.truncated)
+                summary += tr(" - 처음 %1줄만 표시").arg(MAX_RESULTS);
+            if (stats.skipped_binary || stats.skipped_large)
+                summary += tr(" - 바이너리 %1개, 큰 파일 %2개 건너뜀")
+                           .arg(stats.skipped_binary).arg(stats.skipped_large);
+            if (stats.errors)
+                summary += tr(" - 읽기 오류 %1개").arg(stats.errors);
+        }
+        QMetaObject::invokeMethod(this, [this, gen, rc, summary]() {
+            finishSearch(gen, rc, summary);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void GrepPanel::appendHits(qulonglong gen, const QVector<Hit> &hits)
+{
+    if (gen != generation) return;
+
+    QDir root(searchRoot);
+    for (const Hit &hit : hits) {
+        QListWidgetItem *item = new QListWidgetItem(
+            QStringLiteral("%1:%2: %3").arg(root.relativeFilePath(hit.path), QString::number(hit.line), hit.text),
+            results);
+        item->setData(Qt::UserRole, hit.path);
+        item->setData(Qt::UserRole + 1, hit.line);
+    }
+}
+
+void GrepPanel::finishSearch(qulonglong gen, int, const QString &summary)
+{
+    if (gen != generation) return;
+    statusLabel->setText(summary);
+    stopButton->setEnabled(false);
+}
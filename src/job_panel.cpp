@@ -0,0 +1,341 @@
+#include "../include/job_panel.h"
+#include "../include/jobspawn.h"
+#include "../include/pidsig.h"
+#include <QElapsedTimer>
+#include <QFont>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QScrollBar>
+#include <QSocketNotifier>
+#include <QSplitter>
+#include <QStackedWidget>
+#include <QTableWidget>
+#include <QTextCodec>
+#include <QTextCursor>
+#include <QVBoxLayout>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct JobPanel::Job {
+    QString command;
+    pid_t pid = 0;
+    int outFd = -1;
+    int errFd = -1;
+    QSocketNotifier *outNotifier = nullptr;
+    QSocketNotifier *errNotifier = nullptr;
+    // 읽기 경계에서 잘린 멀티바이트 문자를 이어 붙이도록 스트림마다 디코더를 둠
+    std::unique_ptr<QTextDecoder> outDecoder;
+    std::unique_ptr<QTextDecoder> errDecoder;
+    QPlainTextEdit *console = nullptr;
+    QElapsedTimer elapsed;
+    qint64 runtimeMs = 0;
+    bool running = true;
+    bool statusKnown = true;       // 다른 곳에서 거둬 가면 종료 상태를 모름
+    int status = 0;                // waitpid 상태
+};
+
+namespace {
+
+// 맨 아래를 보고 있을 때만 따라 내려감
+void appendToConsole(QPlainTextEdit *console, const QString &text, const QColor &color = QColor())
+{
+    if (text.isEmpty()) return;
+    QScrollBar *bar = console->verticalScrollBar();
+    bool atEnd = bar->value() == bar->maximum();
+
+    QTextCharFormat format;
+    if (color.isValid())
+        format.setForeground(color);
+    QTextCursor cursor(console->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(text, format);
+
+    if (atEnd)
+        bar->setValue(bar->maximum());
+}
+
+QString formatRuntime(qint64 ms)
+{
+    qint64 seconds = ms / 1000;
+    if (seconds < 60)
+        return QObject::tr("%1초").arg(ms / 1000.0, 0, 'f', 1);
+    return QStringLiteral("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10, QLatin1Char('0'));
+}
+
+QString signalText(int sig)
+{
+    const char *name = signal_name(sig);
+    return name ? QStringLiteral("SIG") + QLatin1String(name) : QString::number(sig);
+}
+
+}  // namespace
+
+JobPanel::JobPanel(QWidget *parent) : QWidget(parent)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    QSplitter *splitter = new QSplitter(Qt::Horizontal, this);
+    jobTable = new QTableWidget(0, ColumnCount, splitter);
+    jobTable->setHorizontalHeaderLabels({ tr("명령"), "PID", tr("상태"), tr("실행 시간"), tr("종료 코드") });
+    jobTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    jobTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    jobTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    jobTable->verticalHeader()->hide();
+    jobTable->horizontalHeader()->setSectionResizeMode(Command, QHeaderView::Stretch);
+    consoles = new QStackedWidget(splitter);
+    splitter->addWidget(jobTable);
+    splitter->addWidget(consoles);
+    splitter->setStretchFactor(1, 2);
+    layout->addWidget(splitter);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    stopButton = new QPushButton(tr("중지"), this);
+    stopButton->setEnabled(false);
+    clearButton = new QPushButton(tr("끝난 작업 지우기"), this);
+    statusLabel = new QLabel(this);
+    buttonLayout->addWidget(stopButton);
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addWidget(statusLabel, 1);
+    layout->addLayout(buttonLayout);
+
+    connect(jobTable, &QTableWidget::currentCellChanged, this, [this](int row) {
+        if (row < 0 || row >= static_cast<int>(jobs.size())) {
+            stopButton->setEnabled(false);
+            return;
+        }
+        consoles->setCurrentWidget(jobs[row]->console);
+        stopButton->setEnabled(jobs[row]->running);
+    });
+    connect(stopButton, &QPushButton::clicked, this, [this]() { terminateSelected(); });
+    connect(clearButton, &QPushButton::clicked, this, [this]() { clearFinished(); });
+    connect(&refreshTimer, &QTimer::timeout, this, [this]() { reap(); });
+}
+
+JobPanel::~JobPanel()
+{
+    refreshTimer.stop();
+    // 터미널을 닫을 때처럼 남은 작업에는 SIGHUP을 보내고 파이프를 닫음
+    for (const std::unique_ptr<Job> &job : jobs) {
+        if (job->running)
+            kill(-job->pid, SIGHUP);
+        closeStream(job.get(), false);
+        closeStream(job.get(), true);
+    }
+}
+
+bool JobPanel::start(const QString &program, const QStringList &arguments, const QString &directory,
+                     QString *error)
+{
+    QVector<QByteArray> argumentBytes;
+    argumentBytes.append(program.toLocal8Bit());
+    for (const QString &arg : arguments)
+        argumentBytes.append(arg.toLocal8Bit());
+    QVector<char *> argv;
+    for (QByteArray &arg : argumentBytes)
+        argv.append(arg.data());
+    argv.append(nullptr);
+
+    QByteArray cwd = directory.toLocal8Bit();
+    struct job_process process;
+    if (job_spawn(argv[0], argv.data(), directory.isEmpty() ? nullptr : cwd.constData(), &process) == -1) {
+        if (error)
+            *error = QString::fromLocal8Bit(strerror(errno));
+        return false;
+    }
+
+    std::unique_ptr<Job> job(new Job);
+    job->command = (QStringList(program) + arguments).join(' ');
+    job->pid = process.pid;
+    job->outFd = process.out_fd;
+    job->errFd = process.err_fd;
+    job->outDecoder.reset(QTextCodec::codecForLocale()->makeDecoder());
+    job->errDecoder.reset(QTextCodec::codecForLocale()->makeDecoder());
+    job->elapsed.start();
+
+    job->console = new QPlainTextEdit(consoles);
+    job->console->setReadOnly(true);
+    job->console->setFont(QFont("Monospace"));
+    job->console->setMaximumBlockCount(MAX_CONSOLE_LINES);
+    consoles->addWidget(job->console);
+    appendToConsole(job->console, QStringLiteral("%1$ %2\n").arg(directory, job->command), Qt::gray);
+
+    job->outNotifier = new QSocketNotifier(job->outFd, QSocketNotifier::Read, this);
+    job->errNotifier = new QSocketNotifier(job->errFd, QSocketNotifier::Read, this);
+    connect(job->outNotifier, SIGNAL(activated(int)), this, SLOT(readOutput(int)));
+    connect(job->errNotifier, SIGNAL(activated(int)), this, SLOT(readOutput(int)));
+
+    int row = jobTable->rowCount();
+    jobTable->insertRow(row);
+    for (int column = 0; column < ColumnCount; ++column)
+        jobTable->setItem(row, column, new QTableWidgetItem());
+    jobs.push_back(std::move(job));
+    updateRow(row);
+    jobTable->setCurrentCell(row, Command);
+
+    if (!refreshTimer.isActive())
+        refreshTimer.start(REFRESH_INTERVAL_MS);
+    return true;
+}
+
+int JobPanel::runningCount() const
+{
+    int n = 0;
+    for (const std::unique_ptr<Job> &job : jobs) {
+        if (job->running) ++n;
+    }
+    return n;
+}
+
+void JobPanel::readOutput(int fd)
+{
+    for (const std::unique_ptr<Job> &job : jobs) {
+        if (job->outFd == fd) {
+            drain(job.get(), false);
+            return;
+        }
+        if (job->errFd == fd) {
+            drain(job.get(), true);
+            return;
+        }
+    }
+}
+
+void JobPanel::drain(Job *job, bool error)
+{
+    int fd = error ? job->errFd : job->outFd;
+    if (fd == -1) return;
+
+    QTextDecoder *decoder = error ? job->errDecoder.get() : job->outDecoder.get();
+    QByteArray buffer(READ_CHUNK, Qt::Uninitialized);
+    QString text;
+    int total = 0;
+    bool eof = false;
+    // 레벨 트리거이므로 많이 쏟아지면 일부만 읽고 다음 이벤트에서 이어 읽음
+    while (total < MAX_READ_PER_EVENT) {
+        ssize_t n = read(fd, buffer.data(), READ_CHUNK);
+        if (n > 0) {
+            text += decoder->toUnicode(buffer.constData(), static_cast<int>(n));
+            total += static_cast<int>(n);
+        } else if (n == -1 && errno == EINTR) {
+            continue;
+        } else {
+            eof = n == 0 || errno != EAGAIN;
+            break;
+        }
+    }
+    appendToConsole(job->console, text, error ? QColor(Qt::red) : QColor());
+    if (eof)
+        closeStream(job, error);
+}
+
+void JobPanel::closeStream(Job *job, bool error)
+{
+    int &fd = error ? job->errFd : job->outFd;
+    QSocketNotifier *&notifier = error ? job->errNotifier : job->outNotifier;
+    if (notifier) {
+        // fd를 닫기 전에 감시를 멈춤
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+        notifier = nullptr;
+    }
+    if (fd != -1) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+void JobPanel::reap()
+{
+    for (size_t row = 0; row < jobs.size(); ++row) {
+        Job *job = jobs[row].get();
+        if (!job->running) continue;
+
+        int rc = job_poll(job->pid, &job->status);
+        if (rc == 0) {
+            updateRow(static_cast<int>(row));
+            continue;
+        }
+
+        // 파이프에 남은 출력을 마저 읽음. 자손이 파이프를 물고 있으면 이후 출력도 계속 이벤트로 받음
+        drain(job, false);
+        drain(job, true);
+        job->running = false;
+        job->statusKnown = rc == 1;
+        job->runtimeMs = job->elapsed.elapsed();
+        updateRow(static_cast<int>(row));
+
+        QString result = jobTable->item(static_cast<int>(row), ExitCode)->text();
+        appendToConsole(job->console, tr("\n[%1, %2]\n").arg(result, formatRuntime(job->runtimeMs)), Qt::gray);
+        if (jobTable->currentRow() == static_cast<int>(row))
+            stopButton->setEnabled(false);
+        emit jobFinished(job->command, result);
+    }
+
+    int running = runningCount();
+    statusLabel->setText(tr("작업 %1개, 실행 중 %2개").arg(jobs.size()).arg(running));
+    if (running == 0)
+        refreshTimer.stop();
+}
+
+void JobPanel::updateRow(int row)
+{
+    const Job *job = jobs[row].get();
+    jobTable->item(row, Command)->setText(job->command);
+    jobTable->item(row, Pid)->setText(QString::number(job->pid));
+    jobTable->item(row, Runtime)->setText(formatRuntime(job->running ? job->elapsed.elapsed() : job->runtimeMs));
+
+    QString status, code;
+    if (job->running) {
+        status = tr("실행 중");
+    } else if (!job->statusKnown) {
+        status = tr("종료");
+        code = tr("알 수 없음");
+    } else if (WIFSIGNALED(job->status)) {
+        status = tr("시그널로 종료");
+        code = signalText(WTERMSIG(job->status));
+    } else {
+        int exitCode = WEXITSTATUS(job->status);
+        status = exitCode == 0 ? tr("완료") : tr("실패");
+        code = QString::number(exitCode);
+    }
+    jobTable->item(row, Status)->setText(status);
+    jobTable->item(row, ExitCode)->setText(code);
+}
+
+int JobPanel::selectedRow() const
+{
+    int row = jobTable->currentRow();
+    return row >= 0 && row < static_cast<int>(jobs.size()) ? row : -1;
+}
+
+void JobPanel::terminateSelected()
+{
+    int row = selectedRow();
+    if (row == -1 || !jobs[row]->running) return;
+
+    // 아직 거둬들이지 않았으므로 pid(=프로세스 그룹)가 재사용되지 않음
+    if (kill(-jobs[row]->pid, SIGTERM) == -1)
+        statusLabel->setText(tr("중지할 수 없습니다: %1").arg(QString::fromLocal8Bit(strerror(errno))));
+    else
+        statusLabel->setText(tr("PID %1 프로세스 그룹에 SIGTERM을 보냈습니다").arg(jobs[row]->pid));
+}
+
+void JobPanel::clearFinished()
+{
+    for (int row = static_cast<int>(jobs.size()) - 1; row >= 0; --row) {
+        if (jobs[row]->running) continue;
+        closeStream(jobs[row].get(), false);
+        closeStream(jobs[row].get(), true);
+        consoles->removeWidget(jobs[row]->console);
+        delete jobs[row]->console;
+        jobs.erase(jobs.begin() + row);
+        jobTable->removeRow(row);
+    }
+    statusLabel->setText(tr("작업 %1개, 실행 중 %2개").arg(jobs.size()).arg(runningCount()));
+}
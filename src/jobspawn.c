@@ -0,0 +1,101 @@
+#define _GNU_SOURCE
+#include "../include/jobspawn.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+static void close_pair(int fds[2]) {
+    if (fds[0] != -1) close(fds[0]);
+    if (fds[1] != -1) close(fds[1]);
+}
+
+int job_spawn_fds(const char *program, char *const argv[], const char *cwd, const int fds[3],
+                  int new_group, pid_t *pid) {
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_init(&attr);
+
+    // dup2로 옮긴 fd는 close-on-exec가 풀리고, 원래 fd는 close-on-exec라 exec에서 닫힘
+    for (int target = 0; target < 3; target++) {
+        if (fds[target] == JOB_FD_NULL)
+            posix_spawn_file_actions_addopen(&actions, target, "/dev/null",
+                                             target == STDIN_FILENO ? O_RDONLY : O_WRONLY, 0);
+        else if (fds[target] >= 0)
+            posix_spawn_file_actions_adddup2(&actions, fds[target], target);
+    }
+    if (cwd)
+        posix_spawn_file_actions_addchdir_np(&actions, cwd);
+
+    // 부모가 바꿔 둔 시그널 처리와 마스크를 물려주지 않음
+    sigset_t defaults, empty;
+    sigemptyset(&defaults);
+    sigaddset(&defaults, SIGPIPE);
+    sigaddset(&defaults, SIGUSR1);
+    sigaddset(&defaults, SIGCHLD);
+    sigaddset(&defaults, SIGINT);
+    sigemptyset(&empty);
+    posix_spawnattr_setsigdefault(&attr, &defaults);
+    posix_spawnattr_setsigmask(&attr, &empty);
+    short flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+    if (new_group) {
+        posix_spawnattr_setpgroup(&attr, 0);
+        flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    posix_spawnattr_setflags(&attr, flags);
+
+    int rc = posix_spawnp(pid, program, &actions, &attr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    if (rc != 0) {
+        errno = rc;
+        return -1;
+    }
+    return 0;
+}
+
+int job_spawn(const char *program, char *const argv[], const char *cwd, struct job_process *job) {
+    int out[2] = { -1, -1 }, err[2] = { -1, -1 };
+    if (pipe2(out, O_CLOEXEC) == -1 || pipe2(err, O_CLOEXEC) == -1) {
+        int saved = errno;
+        close_pair(out);
+        close_pair(err);
+        errno = saved;
+        return -1;
+    }
+    // 읽는 쪽만 비차단 (자식의 쓰기는 평소처럼 막혀야 함)
+    fcntl(out[0], F_SETFL, O_NONBLOCK);
+    fcntl(err[0], F_SETFL, O_NONBLOCK);
+
+    const int fds[3] = { JOB_FD_NULL, out[1], err[1] };
+    pid_t pid;
+    int rc = job_spawn_fds(program, argv, cwd, fds, 1, &pid);
+    int saved = errno;
+    close(out[1]);
+    close(err[1]);
+    if (rc == -1) {
+        close(out[0]);
+        close(err[0]);
+        errno = saved;
+        return -1;
+    }
+
+    job->pid = pid;
+    job->out_fd = out[0];
+    job->err_fd = err[0];
+    return 0;
+}
+
+int job_poll(pid_t pid, int *status) {
+    pid_t rc;
+    do {
+        rc = waitpid(pid, status, WNOHANG);
+    } while (rc == -1 && errno == EINTR);
+    if (rc == -1) return -1;
+    return rc == pid;
+}
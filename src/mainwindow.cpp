@@ -51,6 +51,7 @@ void MainWindow::handleRename() { MainWindowFileActions::handleRename(this); }
 void MainWindow::handleLn() { MainWindowFileActions::handleLn(this); }
 void MainWindow::handleCat() { MainWindowFileActions::handleCat(this); }
 void MainWindow::handleRmdir() { MainWindowFileActions::handleRmdir(this); }
+void MainWindow::handleDu() { MainWindowFileActions::handleDu(this); }
 
 void MainWindow::handlePs() { MainWindowProcessActions::handlePs(this); }
 void MainWindow::handleKill(const QString &pid) { MainWindowProcessActions::handleKill(this, pid); }
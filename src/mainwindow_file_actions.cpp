@@ -3,6 +3,51 @@
 #include "../include/mainwindow_file_actions.h"
 #include "../include/config.h"
 #include "../include/commands.h"
+#include "../include/utils.h"
+#include "../include/dirscan.h"
+#include "../include/copy.h"
+#include "../include/remove.h"
+#include "../include/mapped_text_view.h"
+#include "../include/dir_stats_tracker.h"
+#include "../include/du.h"
+#include "../include/grep_panel.h"
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+// handleLs 대화상자의 페이지 단위 목록 상태
+struct LsPagerState {
+    struct ls_pager pager;
+    bool open = false;
+    ~LsPagerState() {
+        if (open) ls_pager_close(&pager);
+    }
+};
+
+class DuTask : public QRunnable {
+public:
+    explicit DuTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+// handleDu 목록에서 크기/개수 열을 표시 문자열이 아닌 숫자로 정렬
+class DuItem : public QTreeWidgetItem {
+public:
+    using QTreeWidgetItem::QTreeWidgetItem;
+    bool operator<(const QTreeWidgetItem &other) const override {
+        int column = treeWidget() ? treeWidget()->sortColumn() : 0;
+        if (column == 0)
+            return text(0).compare(other.text(0), Qt::CaseInsensitive) < 0;
+        return data(column, Qt::UserRole).toULongLong() < other.data(column, Qt::UserRole).toULongLong();
+    }
+};
+}
 
 MainWindowFileActions::MainWindowFileActions(QObject *parent) : QObject(parent) {}
 
@@ -43,44 +88,79 @@ void MainWindowFileActions::handleLs(MainWindow* window)
     resultText->setFont(QFont("Monospace"));
     layout->addWidget(resultText);
     
+    // 표시된 항목 수
+    QLabel *countLabel = new QLabel(dialog);
+    layout->addWidget(countLabel);
+    
     // 새로고침 버튼
     QPushButton *refreshButton = new QPushButton(QObject::tr("새로고침"), dialog);
     layout->addWidget(refreshButton);
     
+    // 대화상자가 열려 있는 동안 유지되는 스트리밍 목록
+    auto pagerState = std::make_shared<LsPagerState>();
+    
+    // 다음 페이지를 끝에 덧붙임
+    auto loadMore = [=]() {
+        if (!pagerState->open) return;
+        
+        std::vector<struct file_info> page(LS_PAGE_SIZE);
+        size_t count = ls_pager_next(&pagerState->pager, page.data(), page.size());
+        if (count == 0) return;
+        
+        struct out_buf ob;
+        out_buf_init(&ob, -1);
+        for (size_t i = 0; i < count; ++i) {
+            ls_format_entry(&ob, pagerState->pager.listing.dirfd, &page[i],
+                            pagerState->pager.opts.show_all_times);
+        }
+        
+        QTextCursor cursor(resultText->document());
+        cursor.movePosition(QTextCursor::End);
+        cursor.insertText(QString::fromLocal8Bit(ob.data, (int)ob.len));
+        out_buf_free(&ob);
+        
+        countLabel->setText(QObject::tr("%1개 중 %2개 표시")
+                            .arg(pagerState->pager.total)
+                            .arg(pagerState->pager.pos));
+    };
+    
     // 새로고침 함수 정의
     auto refreshListing = [=]() {
-        QString tempFileName = QDir::temp().filePath("ls_output.tmp");
-        FILE *temp = fopen(tempFileName.toLocal8Bit().constData(), "w+");
+        struct ls_options opts = {
+            timeSort->isChecked(),
+            sizeSort->isChecked(),
+            reverseSort->isChecked(),
+            showAllTimes->isChecked(),
+            false
+        };
+        
+        if (pagerState->open) {
+            ls_pager_close(&pagerState->pager);
+            pagerState->open = false;
+        }
+        resultText->clear();
+        countLabel->clear();
         
-        if (temp) {
-            int stdout_fd = dup(STDOUT_FILENO);
-            dup2(fileno(temp), STDOUT_FILENO);
-            
-            struct ls_options opts = {
-                timeSort->isChecked(),
-                sizeSort->isChecked(),
-                reverseSort->isChecked(),
-                showAllTimes->isChecked(),
-                false
-            };
-            
-            call_ls(window->currentPath.c_str(), &opts);
-            
-            dup2(stdout_fd, STDOUT_FILENO);
-            ::close(stdout_fd);
-            fclose(temp);
-            
-            QFile tempFile(tempFileName);
-            if (tempFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                QString content = QString::fromLocal8Bit(tempFile.readAll());
-                resultText->setPlainText(content);
-                tempFile.close();
-            }
-            
-            QFile::remove(tempFileName);
+        if (ls_pager_open(&pagerState->pager, window->currentPath.c_str(), &opts) == -1) {
+            resultText->setPlainText(QObject::tr("디렉토리를 읽을 수 없습니다: %1")
+                                     .arg(QString::fromLocal8Bit(strerror(errno))));
+            return;
         }
+        pagerState->open = true;
+        
+        // 첫 화면을 채울 만큼만 정렬/표시하고 나머지는 스크롤 시 불러옴
+        loadMore();
+        loadMore();
     };
     
+    // 끝 부분까지 스크롤하면 다음 페이지 로드
+    QScrollBar *scrollBar = resultText->verticalScrollBar();
+    connect(scrollBar, &QScrollBar::valueChanged, [=](int value) {
+        if (value >= scrollBar->maximum() - scrollBar->pageStep()) {
+            loadMore();
+        }
+    });
+    
     // 체크박스 상태 변경 시 자동 새로고침
     connect(timeSort, &QCheckBox::stateChanged, refreshListing);
     connect(sizeSort, &QCheckBox::stateChanged, refreshListing);
@@ -106,6 +186,7 @@ void MainWindowFileActions::handleMkdir(MainWindow* window)
     if (ok && !folderName.isEmpty()) {
         call_mkdir(window->currentPath.c_str(), 
                   folderName.toLocal8Bit().constData());
+        window->dirStats->touch(folderName);
         refreshFileList(window);
     }
 }
@@ -120,13 +201,7 @@ void MainWindowFileActions::handleRm(MainWindow* window)
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
-        for (const QModelIndex &index : selected) {
-            QString path = window->fileSystemModel->filePath(index);
-            call_rm(window->currentPath.c_str(),
-                   path.toLocal8Bit().constData(),
-                   QFileInfo(path).isDir());
-        }
-        refreshFileList(window);
+        startRemoveJob(window, selected);
     }
 }
 
@@ -179,6 +254,7 @@ void MainWindowFileActions::handleCp(MainWindow* window)
         call_cp(window->currentPath.c_str(),
                sourcePath.toLocal8Bit().constData(),
                targetPath.toLocal8Bit().constData());
+        window->dirStats->touchPath(targetPath);
         refreshFileList(window);
     }
 }
@@ -214,6 +290,8 @@ void MainWindowFileActions::handleRename(MainWindow* window)
         call_rename(window->currentPath.c_str(),
                    oldName.toLocal8Bit().constData(),
                    newName.toLocal8Bit().constData());
+        window->dirStats->touch(oldName);
+        window->dirStats->touch(newName);
         refreshFileList(window);
     }
 }
@@ -232,6 +310,7 @@ void MainWindowFileActions::handleLn(MainWindow* window)
                targetPath.toLocal8Bit().constData(),
                linkPath.toLocal8Bit().constData(),
                1);
+        window->dirStats->touchPath(linkPath);
         refreshFileList(window);
     }
 }
@@ -249,8 +328,10 @@ void MainWindowFileActions::refreshFileList(MainWindow* window)
     window->treeView->clearSelection();
     window->listView->clearSelection();
     
-    // 상태바 업데이트
+    // 상태바 업데이트 (디렉토리가 바뀐 경우에만 전체 집계)
+    window->dirStats->setDirectory(qPath);
     updateStatusBar(window);
+    window->grepPanel->setDirectory(qPath);
 }
 
 void MainWindowFileActions::handleCat(MainWindow* window)
@@ -258,40 +339,69 @@ void MainWindowFileActions::handleCat(MainWindow* window)
     QModelIndexList selected = window->listView->selectionModel()->selectedRows();
     if (selected.isEmpty()) return;
 
-    QString filePath = window->fileSystemModel->filePath(selected.first());
-    
+    openFileViewer(window, window->fileSystemModel->filePath(selected.first()));
+}
+
+void MainWindowFileActions::openFileViewer(MainWindow* window, const QString &filePath, qulonglong line)
+{
+    if (!is_within_base_dir(filePath.toLocal8Bit().constData())) {
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("오류: %1 외부의 파일을 읽을 수 없습니다").arg(BASE_DIR));
+        return;
+    }
+
+    // 파일을 mmap하고 보이는 줄만 그리므로 크기와 상관없이 바로 열림
+    MappedTextView *view = new MappedTextView();
+    QString error;
+    if (!view->openFile(filePath, &error)) {
+        delete view;
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("파일을 열 수 없습니다: %1").arg(error));
+        return;
+    }
+
     QDialog *viewDialog = new QDialog(window);
     viewDialog->setWindowTitle(QObject::tr("파일 내용 - %1").arg(QFileInfo(filePath).fileName()));
-    viewDialog->resize(600, 400);
-    
+    viewDialog->resize(800, 600);
+
     QVBoxLayout *layout = new QVBoxLayout(viewDialog);
-    QTextEdit *textEdit = new QTextEdit(viewDialog);
-    textEdit->setReadOnly(true);
-    layout->addWidget(textEdit);
-    
-    QString tempFileName = QDir::temp().filePath("cat_output.tmp");
-    FILE *temp = fopen(tempFileName.toLocal8Bit().constData(), "w+");
-    
-    if (temp) {
-        int stdout_fd = dup(STDOUT_FILENO);
-        dup2(fileno(temp), STDOUT_FILENO);
-        
-        call_cat(window->currentPath.c_str(),
-                filePath.toLocal8Bit().constData());
-        
-        dup2(stdout_fd, STDOUT_FILENO);
-        ::close(stdout_fd);
-        fclose(temp);
-        
-        QFile tempFile(tempFileName);
-        if (tempFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            textEdit->setPlainText(QString::fromLocal8Bit(tempFile.readAll()));
-            tempFile.close();
+    QHBoxLayout *jumpLayout = new QHBoxLayout();
+    QLineEdit *jumpEdit = new QLineEdit(viewDialog);
+    jumpEdit->setPlaceholderText(QObject::tr("줄 번호 또는 @바이트 오프셋으로 이동"));
+    QLabel *positionLabel = new QLabel(viewDialog);
+    jumpLayout->addWidget(jumpEdit);
+    jumpLayout->addWidget(positionLabel);
+    layout->addLayout(jumpLayout);
+    layout->addWidget(view);
+    view->setParent(viewDialog);
+
+    QObject::connect(view, &MappedTextView::positionChanged, positionLabel,
+                     [positionLabel](qulonglong offset, qulonglong size, qlonglong line) {
+        int percent = size ? static_cast<int>(offset * 100 / size) : 100;
+        QString text = QObject::tr("%1 / %2 바이트 (%3%)").arg(offset).arg(size).arg(percent);
+        if (line >= 0)
+            text = QObject::tr("%1줄, ").arg(line + 1) + text;
+        positionLabel->setText(text);
+    });
+    QObject::connect(jumpEdit, &QLineEdit::returnPressed, view, [view, jumpEdit]() {
+        QString target = jumpEdit->text().trimmed();
+        bool ok = false;
+        if (target.startsWith('@')) {
+            qulonglong offset = target.mid(1).toULongLong(&ok, 0);
+            if (ok) view->scrollToOffset(offset);
+        } else {
+            qulonglong line = target.toULongLong(&ok);
+            if (ok && line > 0) view->scrollToLine(line - 1);
         }
-        
-        QFile::remove(tempFileName);
-    }
-    
+        view->setFocus();
+    });
+    // 내용 검색 결과에서 열었으면 일치한 줄로 바로 이동
+    if (line > 0)
+        view->scrollToLine(line - 1);
+    else
+        view->scrollToOffset(0);
+    view->setFocus();
+
     viewDialog->exec();
     delete viewDialog;
 }
@@ -305,20 +415,21 @@ void MainWindowFileActions::createNewFolder(MainWindow* window)
     if (ok && !folderName.isEmpty()) {
         call_mkdir(window->currentPath.c_str(), 
                   folderName.toLocal8Bit().constData());
+        window->dirStats->touch(folderName);
         refreshFileList(window);
     }
 }
 
 void MainWindowFileActions::deleteSelected(MainWindow* window)
 {
-    // 현재 선택된 항목들의 목록을 가져옴
+    // 현재 선택된 항목들의 목록을 가져옴 (열마다 중복되지 않도록 행 단위)
     QModelIndexList selected;
     if (window->treeView->hasFocus()) {
-        selected = window->treeView->selectionModel()->selectedIndexes();
+        selected = window->treeView->selectionModel()->selectedRows();
     } else {
-        selected = window->listView->selectionModel()->selectedIndexes();
+        selected = window->listView->selectionModel()->selectedRows();
     }
-    
+
     if (selected.isEmpty()) {
         return;
     }
@@ -328,22 +439,87 @@ void MainWindowFileActions::deleteSelected(MainWindow* window)
         QObject::tr("선택한 항목을 삭제하시겠습니까?"),
         QMessageBox::Yes | QMessageBox::No);
 
-    if (reply == QMessageBox::Yes) {
-        // 선택된 각 항목에 대해 삭제 수행
-        for (const QModelIndex &index : selected) {
-            QString path = window->fileSystemModel->filePath(index);
-            QString fileName = QFileInfo(path).fileName();
-            
-            if (!fileName.isEmpty()) {
-                // 파일 시스템에서 실제 삭제 수행
-                call_rm(window->currentPath.c_str(),
-                       fileName.toLocal8Bit().constData(),
-                       QFileInfo(path).isDir());
-            }
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+
+    startRemoveJob(window, selected);
+}
+
+// 선택한 항목들을 삭제 엔진으로 지우고 진행 상황을 대화상자로 보여줌 (handleRm, deleteSelected 공용)
+void MainWindowFileActions::startRemoveJob(MainWindow *window, const QModelIndexList &selected)
+{
+    QList<QByteArray> pathBytes;
+    for (const QModelIndex &index : selected) {
+        QByteArray path = window->fileSystemModel->filePath(index).toLocal8Bit();
+        if (path.isEmpty() || pathBytes.contains(path)) continue;
+        if (!is_within_base_dir(path.constData())) {
+            QMessageBox::warning(window, QObject::tr("오류"),
+                                 QObject::tr("%1 외부의 파일을 삭제할 수 없습니다").arg(BASE_DIR));
+            return;
         }
-        // 파일 목록 갱신
-        refreshFileList(window);
+        pathBytes << path;
     }
+
+    std::vector<const char *> paths;
+    for (const QByteArray &path : pathBytes)
+        paths.push_back(path.constData());
+
+    // 디렉토리 fd 기준으로 워커 스레드들이 트리를 나눠 지움
+    struct remove_job *job = remove_job_start(paths.data(), paths.size(), 0);
+    if (!job) {
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("삭제를 시작할 수 없습니다: %1")
+                                 .arg(QString::fromLocal8Bit(strerror(errno))));
+        return;
+    }
+
+    QProgressDialog *progress = new QProgressDialog(QObject::tr("삭제 중..."),
+                                                    QObject::tr("취소"), 0, 0, window);
+    progress->setWindowTitle(QObject::tr("삭제"));
+    progress->setWindowModality(Qt::NonModal);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setMinimumDuration(300);
+    progress->setValue(0);
+
+    QObject::connect(progress, &QProgressDialog::canceled, [job]() { remove_job_cancel(job); });
+
+    // 창 닫기 버튼도 canceled를 보내므로 대화상자/타이머 정리는 작업이 끝난 뒤에 함
+    QTimer *timer = new QTimer(window);
+    QObject::connect(timer, &QTimer::timeout, [=]() {
+        struct remove_progress p;
+        remove_job_progress(job, &p);
+
+        if (!p.finished) {
+            progress->setLabelText(QObject::tr("파일 %1개, 디렉토리 %2개 삭제됨")
+                                       .arg(p.files_removed).arg(p.dirs_removed));
+            return;
+        }
+
+        // close()도 canceled를 보내므로 job을 해제하기 전에 취소 연결부터 끊음
+        timer->stop();
+        QObject::disconnect(progress, &QProgressDialog::canceled, nullptr, nullptr);
+        int result = remove_job_wait(job);
+        bool canceled = result == -1 && errno == ECANCELED;
+        remove_job_progress(job, &p);
+        QString error = remove_job_error(job) ? QString::fromLocal8Bit(remove_job_error(job)) : QString();
+        remove_job_free(job);
+        for (const QByteArray &path : pathBytes)
+            window->dirStats->touchPath(QString::fromLocal8Bit(path));
+
+        progress->close();
+        progress->deleteLater();
+        timer->deleteLater();
+        refreshFileList(window);
+
+        if (result == -1 && !canceled) {
+            QMessageBox::warning(window, QObject::tr("오류"),
+                                 QObject::tr("%1개 항목을 삭제하지 못했습니다.\n%2")
+                                     .arg(p.errors).arg(error));
+        }
+    });
+    timer->start(100);
 }
 
 void MainWindowFileActions::copySelected(MainWindow* window, bool isMove)
@@ -366,63 +542,120 @@ void MainWindowFileActions::copySelected(MainWindow* window, bool isMove)
 void MainWindowFileActions::pasteToCurrentDir(MainWindow* window)
 {
     bool isMove = window->moveOperation;  // 이동 작업 여부 확인
-    
+
+    // 원본/대상 경로 목록 (C 문자열 배열은 QByteArray 수명에 묶임)
+    QList<QByteArray> sourceBytes, targetBytes;
     for (const QModelIndex &sourceIndex : window->selectedIndexes) {
         QString sourcePath = window->fileSystemModel->filePath(sourceIndex);
         QString fileName = window->fileSystemModel->fileName(sourceIndex);
         QString destPath = QString::fromStdString(window->currentPath) + "/" + fileName;
-        
-        QFileInfo sourceInfo(sourcePath);
-        if (sourceInfo.isDir()) {
-            // 디렉토리인 경우 재귀적으로 복사
-            copyDirectory(sourcePath, destPath);
-            if (isMove) {
-                // 이동 작업인 경우 원본 디렉토리 삭제
-                QDir(sourcePath).removeRecursively();
-            }
-        } else {
-            // 파일인 경우 call_cp 사용
-            call_cp(window->currentPath.c_str(),
-                   sourcePath.toLocal8Bit().constData(),
-                   destPath.toLocal8Bit().constData());
-            
-            if (isMove) {
-                // 이동 작업인 경우 원본 파일 삭제
-                call_rm(QFileInfo(sourcePath).path().toLocal8Bit().constData(),
-                       fileName.toLocal8Bit().constData(),
-                       false);  // false는 디렉토리가 아님을 의미
-            }
-        }
+        if (QFileInfo(sourcePath).absoluteFilePath() == QFileInfo(destPath).absoluteFilePath())
+            continue;  // 같은 위치에 붙여넣기는 무시
+        sourceBytes << sourcePath.toLocal8Bit();
+        targetBytes << destPath.toLocal8Bit();
     }
-    
-    // 복사/이동 완료 후 화면 갱신
-    refreshFileList(window);
+
     window->selectedIndexes.clear();  // 선택 항목 초기화
     window->pasteAction->setEnabled(false);
     window->moveOperation = false;  // 이동 작업 플래그 초기화
+    if (sourceBytes.isEmpty()) return;
+
+    std::vector<const char *> sources, targets;
+    for (int i = 0; i < sourceBytes.size(); i++) {
+        sources.push_back(sourceBytes[i].constData());
+        targets.push_back(targetBytes[i].constData());
+    }
+
+    // 탐색과 복사는 워커 스레드에서 진행하고 GUI는 주기적으로 진행률만 읽음
+    // 이동은 같은 파일시스템이면 rename으로 끝나고, 아니면 복사 후 원본을 지움
+    struct copy_job *job = copy_job_start(sources.data(), targets.data(), sources.size(), 0,
+                                          isMove ? COPY_JOB_MOVE : 0);
+    if (!job) {
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("작업을 시작할 수 없습니다: %1")
+                                 .arg(QString::fromLocal8Bit(strerror(errno))));
+        return;
+    }
+
+    QProgressDialog *progress = new QProgressDialog(
+        isMove ? QObject::tr("이동 준비 중...") : QObject::tr("복사 준비 중..."),
+        QObject::tr("취소"), 0, 1000, window);
+    progress->setWindowTitle(isMove ? QObject::tr("이동") : QObject::tr("복사"));
+    progress->setWindowModality(Qt::NonModal);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setMinimumDuration(300);
+    progress->setValue(0);
+
+    QObject::connect(progress, &QProgressDialog::canceled, [job]() { copy_job_cancel(job); });
+
+    // 창 닫기 버튼도 canceled를 보내므로 대화상자/타이머 정리는 작업이 끝난 뒤에 함
+    QTimer *timer = new QTimer(window);
+    QElapsedTimer *clock = new QElapsedTimer();
+    clock->start();
+
+    QObject::connect(timer, &QTimer::timeout, [=]() {
+        struct copy_progress p;
+        copy_job_progress(job, &p);
+
+        if (!p.finished) {
+            double seconds = clock->elapsed() / 1000.0;
+            double rate = seconds > 0 ? p.bytes_done / seconds : 0;
+            QString eta = QObject::tr("계산 중");
+            if (rate > 0 && p.bytes_total >= p.bytes_done)
+                eta = QObject::tr("%1초").arg(qRound((p.bytes_total - p.bytes_done) / rate));
+            progress->setLabelText(QObject::tr("파일 %1 / %2\n%3 / %4 (%5/s)\n남은 시간: %6")
+                                       .arg(p.files_done).arg(p.files_total)
+                                       .arg(formatSize(p.bytes_done))
+                                       .arg(formatSize(p.bytes_total))
+                                       .arg(formatSize(static_cast<qint64>(rate)))
+                                       .arg(eta));
+            if (p.bytes_total > 0)
+                progress->setValue(static_cast<int>(p.bytes_done * 1000 / p.bytes_total));
+            return;
+        }
+
+        // 모든 워커가 끝났으므로 join은 바로 반환됨.
+        // close()도 canceled를 보내므로 job을 해제하기 전에 취소 연결부터 끊음
+        timer->stop();
+        QObject::disconnect(progress, &QProgressDialog::canceled, nullptr, nullptr);
+        int result = copy_job_wait(job);
+        bool canceled = result == -1 && errno == ECANCELED;
+        QString error = copy_job_error(job) ? QString::fromLocal8Bit(copy_job_error(job)) : QString();
+        copy_job_free(job);
+        delete clock;
+        for (int i = 0; i < targetBytes.size(); i++) {
+            window->dirStats->touchPath(QString::fromLocal8Bit(sourceBytes[i]));
+            window->dirStats->touchPath(QString::fromLocal8Bit(targetBytes[i]));
+        }
+
+        progress->close();
+        progress->deleteLater();
+        timer->deleteLater();
+        refreshFileList(window);
+
+        if (result == -1 && !canceled) {
+            QMessageBox::warning(window, QObject::tr("오류"),
+                                 isMove ? QObject::tr("일부 항목을 이동하지 못했습니다. 실패한 항목은 원래 위치에 그대로 있습니다.\n%1").arg(error)
+                                        : QObject::tr("일부 항목을 복사하지 못했습니다.\n%1").arg(error));
+        }
+    });
+    timer->start(100);
 }
 
 void MainWindowFileActions::updateStatusBar(MainWindow* window)
 {
-    QDir currentDir(window->getCurrentDirectory());
-    qint64 totalSize = 0;
-    int fileCount = 0;
-    int dirCount = 0;
-    
-    QFileInfoList entries = currentDir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    for (const QFileInfo &info : entries) {
-        if (info.isFile()) {
-            totalSize += info.size();
-            fileCount++;
-        } else if (info.isDir()) {
-            dirCount++;
-        }
+    // 통계는 DirStatsTracker가 증분으로 유지하므로 여기서는 표시만 함
+    DirStatsTracker *stats = window->dirStats;
+    if (!stats->ready()) {
+        window->statusBar()->showMessage(QObject::tr("디렉토리 정보를 계산하는 중..."));
+        return;
     }
-    
+
     QString status = QObject::tr("파일 %1개, 디렉토리 %2개, 총 크기: %3")
-                    .arg(fileCount)
-                    .arg(dirCount)
-                    .arg(formatSize(totalSize));
+                    .arg(stats->fileCount())
+                    .arg(stats->dirCount())
+                    .arg(formatSize(stats->totalSize()));
     window->statusBar()->showMessage(status);
 }
 
@@ -517,55 +750,150 @@ void MainWindowFileActions::handleRmdir(MainWindow* window)
     if (reply == QMessageBox::Yes) {
         call_rmdir(window->currentPath.c_str(), 
                   fileName.toLocal8Bit().constData());
+        window->dirStats->touch(fileName);
         refreshFileList(window);
     }
 }
 
-void MainWindowFileActions::copyDirectory(const QString &sourcePath, const QString &destPath)
+void MainWindowFileActions::handleDu(MainWindow* window)
 {
-    QDir sourceDir(sourcePath);
-    QDir destDir(destPath);
-    
-    // 대상 디렉토리가 없으면 생성
-    if (!destDir.exists()) {
-        destDir.mkpath(".");
-    }
+    QDialog *dialog = new QDialog(window);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QObject::tr("디스크 사용량"));
+    dialog->resize(700, 500);
 
-    // 디렉토리 내용물 복사
-    QFileInfoList entries = sourceDir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    for (const QFileInfo &entry : entries) {
-        QString srcPath = entry.filePath();
-        QString destFilePath = destDir.filePath(entry.fileName());
-        
-        if (entry.isDir()) {
-            // 디렉토리인 경우 재귀적으로 복사
-            copyDirectory(srcPath, destFilePath);
-        } else {
-            // 파일인 경우 call_cp 사용
-            call_cp(QFileInfo(destFilePath).path().toLocal8Bit().constData(),
-                   srcPath.toLocal8Bit().constData(),
-                   destFilePath.toLocal8Bit().constData());
-        }
-    }
-}
+    QVBoxLayout *layout = new QVBoxLayout(dialog);
+    QLabel *pathLabel = new QLabel(dialog);
+    layout->addWidget(pathLabel);
 
-bool MainWindowFileActions::removeDirectory(const QString &dirPath)
-{
-    QDir dir(dirPath);
-    if (!dir.exists()) return true;
+    QTreeWidget *tree = new QTreeWidget(dialog);
+    tree->setRootIsDecorated(false);
+    tree->setHeaderLabels(QStringList() << QObject::tr("이름") << QObject::tr("디스크 사용량")
+                                        << QObject::tr("크기") << QObject::tr("파일 수")
+                                        << QObject::tr("디렉토리 수"));
+    tree->setSortingEnabled(true);
+    tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    layout->addWidget(tree);
 
-    bool success = true;
-    QFileInfoList entries = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    
-    for (const QFileInfo &entry : entries) {
-        if (entry.isDir()) {
-            success = removeDirectory(entry.filePath());
-        } else {
-            success = QFile::remove(entry.filePath());
-        }
-        
-        if (!success) return false;
-    }
+    QLabel *summaryLabel = new QLabel(dialog);
+    layout->addWidget(summaryLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *upButton = new QPushButton(QObject::tr("상위 디렉토리"), dialog);
+    QPushButton *refreshButton = new QPushButton(QObject::tr("새로고침"), dialog);
+    QPushButton *fullButton = new QPushButton(QObject::tr("전체 다시 집계"), dialog);
+    buttonLayout->addWidget(upButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(refreshButton);
+    buttonLayout->addWidget(fullButton);
+    layout->addLayout(buttonLayout);
+
+    // 집계는 워커 스레드에서 하고, 대화상자가 먼저 닫히면 결과를 버림.
+    // 하위 디렉토리로 들어가거나 다시 열 때는 바뀌지 않은 디렉토리가 캐시로 처리됨
+    auto currentDir = std::make_shared<QString>(QString::fromStdString(window->currentPath));
+    auto generation = std::make_shared<qulonglong>(0);
+    QPointer<QDialog> guard(dialog);
+
+    std::function<void(int)> scan = [=](int flags) {
+        qulonglong gen = ++*generation;
+        QString dir = *currentDir;
+        pathLabel->setText(QObject::tr("경로: %1").arg(dir));
+        summaryLabel->setText(QObject::tr("집계 중..."));
+        upButton->setEnabled(QDir::cleanPath(dir) != QDir::cleanPath(QString(BASE_DIR)));
+
+        QByteArray localPath = dir.toLocal8Bit();
+        QThreadPool::globalInstance()->start(new DuTask([=]() {
+            auto result = std::shared_ptr<struct du_result>(new struct du_result, [](struct du_result *r) {
+                du_result_free(r);
+                delete r;
+            });
+            struct du_options opts = { 1, 0, flags };
+            int rc = du_scan(localPath.constData(), &opts, result.get());
+            int err = errno;
+
+            QMetaObject::invokeMethod(qApp, [=]() {
+                if (!guard || gen != *generation) return;
+
+                tree->clear();
+                if (rc == -1 && result->count == 0) {
+                    summaryLabel->setText(QObject::tr("집계할 수 없습니다: %1")
+                                          .arg(QString::fromLocal8Bit(strerror(err))));
+                    return;
+                }
+
+                // 마지막 항목이 루트, 나머지는 깊이 1인 하위 디렉토리
+                const struct du_entry *root = &result->entries[result->count - 1];
+                unsigned long long childBlocks = 0, childBytes = 0, childFiles = 0;
+                tree->setSortingEnabled(false);
+                for (size_t i = 0; i + 1 < result->count; ++i) {
+                    const struct du_entry *e = &result->entries[i];
+                    DuItem *item = new DuItem(tree);
+                    item->setText(0, QFileInfo(QString::fromLocal8Bit(e->path)).fileName());
+                    item->setData(0, Qt::UserRole, QString::fromLocal8Bit(e->path));
+                    item->setText(1, formatSize(static_cast<qint64>(e->blocks)));
+                    item->setData(1, Qt::UserRole, static_cast<qulonglong>(e->blocks));
+                    item->setText(2, formatSize(static_cast<qint64>(e->bytes)));
+                    item->setData(2, Qt::UserRole, static_cast<qulonglong>(e->bytes));
+                    item->setText(3, QString::number(e->files));
+                    item->setData(3, Qt::UserRole, static_cast<qulonglong>(e->files));
+                    item->setText(4, QString::number(e->dirs));
+                    item->setData(4, Qt::UserRole, static_cast<qulonglong>(e->dirs));
+                    for (int column = 1; column < 5; ++column)
+                        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+                    childBlocks += e->blocks;
+                    childBytes += e->bytes;
+                    childFiles += e->files;
+                }
+
+                // 바로 아래 파일들은 한 줄로 묶어서 표시
+                if (root->files > childFiles) {
+                    DuItem *item = new DuItem(tree);
+                    unsigned long long blocks = root->blocks - childBlocks;
+                    unsigned long long bytes = root->bytes - childBytes;
+                    item->setText(0, QObject::tr("(이 디렉토리의 파일)"));
+                    item->setText(1, formatSize(static_cast<qint64>(blocks)));
+                    item->setData(1, Qt::UserRole, static_cast<qulonglong>(blocks));
+                    item->setText(2, formatSize(static_cast<qint64>(bytes)));
+                    item->setData(2, Qt::UserRole, static_cast<qulonglong>(bytes));
+                    item->setText(3, QString::number(root->files - childFiles));
+                    item->setData(3, Qt::UserRole, static_cast<qulonglong>(root->files - childFiles));
+                    for (int column = 1; column < 4; ++column)
+                        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+                }
+                tree->setSortingEnabled(true);
+                tree->sortByColumn(1, Qt::DescendingOrder);
+
+                QString summary = QObject::tr("합계 %1 (파일 %2개, 디렉토리 %3개) - 디렉토리 %4개 읽음, %5개 캐시 사용")
+                                  .arg(formatSize(static_cast<qint64>(root->blocks)))
+                                  .arg(root->files)
+                                  .arg(root->dirs)
+                                  .arg(result->scanned_dirs)
+                                  .arg(result->cached_dirs);
+                if (result->errors)
+                    summary += QObject::tr("\n오류 %1개 (일부 항목이 빠져 합계가 실제보다 작음): %2")
+                                   .arg(result->errors)
+                                   .arg(QString::fromLocal8Bit(result->error));
+                summaryLabel->setText(summary);
+            }, Qt::QueuedConnection);
+        }));
+    };
 
-    return dir.rmdir(dirPath);
+    // 하위 디렉토리를 더블클릭하면 그 안으로 들어감
+    QObject::connect(tree, &QTreeWidget::itemDoubleClicked, dialog, [=](QTreeWidgetItem *item) {
+        QString path = item->data(0, Qt::UserRole).toString();
+        if (path.isEmpty()) return;
+        *currentDir = path;
+        scan(0);
+    });
+    QObject::connect(upButton, &QPushButton::clicked, dialog, [=]() {
+        QString parent = QFileInfo(*currentDir).absolutePath();
+        if (!is_within_base_dir(parent.toLocal8Bit().constData())) return;
+        *currentDir = parent;
+        scan(0);
+    });
+    QObject::connect(refreshButton, &QPushButton::clicked, dialog, [=]() { scan(0); });
+    QObject::connect(fullButton, &QPushButton::clicked, dialog, [=]() { scan(DU_NO_CACHE); });
+
+    scan(0);
+    dialog->show();
 }
\ No newline at end of file
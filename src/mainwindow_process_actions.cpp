@@ -2,6 +2,71 @@
 #include "../include/mainwindow.h"
 #include "../include/mainwindow_process_actions.h"
 #include "../include/commands.h"
+#include "../include/process_monitor.h"
+#include "../include/process_table_model.h"
+#include "../include/signal_batch.h"
+#include "../include/procscan.h"
+#include <climits>
+#include <csignal>
+#include <unistd.h>
+
+namespace {
+
+// 종료를 기다릴 만한 시그널 (SIGSTOP, SIGCONT 등은 보내고 끝냄)
+bool terminatesProcess(int sig)
+{
+    return sig == SIGTERM || sig == SIGKILL || sig == SIGINT || sig == SIGQUIT || sig == SIGHUP;
+}
+
+// 시그널과 SIGKILL로 올릴 시간을 고르는 대화상자. 취소하면 false
+bool askSignal(QWidget *parent, const QString &title, const QString &prompt, int *sig, int *escalateMs)
+{
+    QDialog *dialog = new QDialog(parent);
+    dialog->setWindowTitle(title);
+    QVBoxLayout *layout = new QVBoxLayout(dialog);
+    layout->addWidget(new QLabel(prompt, dialog));
+
+    QComboBox *signalCombo = new QComboBox(dialog);
+    const int choices[] = { SIGTERM, SIGKILL, SIGINT, SIGHUP, SIGQUIT, SIGSTOP, SIGCONT, SIGUSR1, SIGUSR2 };
+    for (int s : choices)
+        signalCombo->addItem(QString("SIG%1 (%2)").arg(QLatin1String(signal_name(s))).arg(s), s);
+    layout->addWidget(signalCombo);
+
+    QHBoxLayout *escalateLayout = new QHBoxLayout();
+    QCheckBox *escalateCheck = new QCheckBox(QObject::tr("끝나지 않으면 SIGKILL:"), dialog);
+    escalateCheck->setChecked(true);
+    QSpinBox *escalateSpin = new QSpinBox(dialog);
+    escalateSpin->setRange(1, 60);
+    escalateSpin->setValue(SignalBatch::DEFAULT_WAIT_MS / 1000);
+    escalateSpin->setSuffix(QObject::tr("초 후"));
+    escalateLayout->addWidget(escalateCheck);
+    escalateLayout->addWidget(escalateSpin);
+    escalateLayout->addStretch();
+    layout->addLayout(escalateLayout);
+
+    auto updateEscalate = [signalCombo, escalateCheck, escalateSpin]() {
+        int s = signalCombo->currentData().toInt();
+        bool possible = terminatesProcess(s) && s != SIGKILL;
+        escalateCheck->setEnabled(possible);
+        escalateSpin->setEnabled(possible && escalateCheck->isChecked());
+    };
+    QObject::connect(signalCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), dialog, updateEscalate);
+    QObject::connect(escalateCheck, &QCheckBox::toggled, dialog, updateEscalate);
+    updateEscalate();
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, dialog);
+    QObject::connect(buttons, &QDialogButtonBox::accepted, dialog, &QDialog::accept);
+    QObject::connect(buttons, &QDialogButtonBox::rejected, dialog, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    bool accepted = dialog->exec() == QDialog::Accepted;
+    *sig = signalCombo->currentData().toInt();
+    *escalateMs = escalateCheck->isEnabled() && escalateCheck->isChecked() ? escalateSpin->value() * 1000 : 0;
+    delete dialog;
+    return accepted;
+}
+
+}  // namespace
 
 MainWindowProcessActions::MainWindowProcessActions(QObject *parent) : QObject(parent) {}
 
@@ -12,113 +77,340 @@ void MainWindowProcessActions::handlePs(MainWindow* window)
     psDialog->resize(800, 600);
     
     QVBoxLayout *layout = new QVBoxLayout(psDialog);
-    QTableWidget *processTable = new QTableWidget(psDialog);
-    layout->addWidget(processTable);
-    
-    // 프로세스 목록 표시
-    refreshProcessList(window, processTable);
+
+    // 실시간 갱신 설정과 마지막 표본 요약
+    QHBoxLayout *liveLayout = new QHBoxLayout();
+    QCheckBox *liveCheck = new QCheckBox(QObject::tr("실시간 갱신"), psDialog);
+    liveCheck->setChecked(true);
+    QSpinBox *intervalSpin = new QSpinBox(psDialog);
+    intervalSpin->setRange(1, 10);
+    intervalSpin->setValue(ProcessMonitor::DEFAULT_INTERVAL_MS / 1000);
+    intervalSpin->setSuffix(QObject::tr("초"));
+    QLabel *summaryLabel = new QLabel(psDialog);
+    liveLayout->addWidget(liveCheck);
+    liveLayout->addWidget(intervalSpin);
+    liveLayout->addWidget(summaryLabel, 1);
+    layout->addLayout(liveLayout);
+
+    // 목록 탭과 트리 탭이 같은 표본을 보여줌
+    QTabWidget *viewTabs = new QTabWidget(psDialog);
+    QWidget *listPage = new QWidget(viewTabs);
+    QVBoxLayout *listLayout = new QVBoxLayout(listPage);
+    listLayout->setContentsMargins(0, 0, 0, 0);
+
+    // 필터: pid, 사용자, 상태, 최소 RSS, 명령 부분 문자열
+    QHBoxLayout *filterLayout = new QHBoxLayout();
+    QLineEdit *pidFilter = new QLineEdit(psDialog);
+    pidFilter->setPlaceholderText("PID");
+    pidFilter->setValidator(new QIntValidator(0, INT_MAX, pidFilter));
+    pidFilter->setMaximumWidth(80);
+    QLineEdit *userFilter = new QLineEdit(psDialog);
+    userFilter->setPlaceholderText(QObject::tr("사용자"));
+    userFilter->setMaximumWidth(100);
+    QComboBox *stateFilter = new QComboBox(psDialog);
+    stateFilter->addItem(QObject::tr("모든 상태"), 0);
+    const char states[] = "RSDZTI";
+    for (const char *c = states; *c; ++c)
+        stateFilter->addItem(QString(QChar::fromLatin1(*c)), static_cast<int>(*c));
+    QSpinBox *rssFilter = new QSpinBox(psDialog);
+    rssFilter->setRange(0, 1024 * 1024);
+    rssFilter->setPrefix(QObject::tr("RSS ≥ "));
+    rssFilter->setSuffix(" MB");
+    QLineEdit *commandFilter = new QLineEdit(psDialog);
+    commandFilter->setPlaceholderText(QObject::tr("명령 검색..."));
+    commandFilter->setClearButtonEnabled(true);
+    filterLayout->addWidget(pidFilter);
+    filterLayout->addWidget(userFilter);
+    filterLayout->addWidget(stateFilter);
+    filterLayout->addWidget(rssFilter);
+    filterLayout->addWidget(commandFilter, 1);
+    listLayout->addLayout(filterLayout);
+
+    // 표본 배열을 그대로 보여주는 모델 위에 필터 프록시
+    ProcessTableModel *processModel = new ProcessTableModel(psDialog);
+    ProcessFilterProxy *proxy = new ProcessFilterProxy(psDialog);
+    proxy->setSourceModel(processModel);
+
+    QTableView *processTable = new QTableView(psDialog);
+    processTable->setModel(proxy);
+    processTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    processTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    processTable->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    processTable->verticalHeader()->hide();
+    // 행 높이를 행마다 재지 않도록 고정
+    processTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    processTable->verticalHeader()->setDefaultSectionSize(processTable->fontMetrics().height() + 6);
+    processTable->horizontalHeader()->setStretchLastSection(true);
+    processTable->setSortingEnabled(true);
+    processTable->sortByColumn(ProcessTableModel::Cpu, Qt::DescendingOrder);
+    listLayout->addWidget(processTable);
+    viewTabs->addTab(listPage, QObject::tr("목록"));
+
+    // 트리 탭: PPID 연결로 만든 트리, 하위 트리 합계
+    ProcessTreeModel *treeModel = new ProcessTreeModel(psDialog);
+    QTreeView *processTree = new QTreeView(viewTabs);
+    processTree->setModel(treeModel);
+    processTree->setUniformRowHeights(true);
+    processTree->setSelectionBehavior(QAbstractItemView::SelectRows);
+    processTree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    processTree->setContextMenuPolicy(Qt::CustomContextMenu);
+    processTree->header()->resizeSection(ProcessTreeModel::Command, 360);
+    viewTabs->addTab(processTree, QObject::tr("트리"));
+    layout->addWidget(viewTabs);
+
+    QObject::connect(pidFilter, &QLineEdit::textChanged, proxy, [proxy](const QString &text) {
+        proxy->setPidFilter(text.toInt());
+    });
+    QObject::connect(userFilter, &QLineEdit::textChanged, proxy, [proxy](const QString &text) {
+        proxy->setUserFilter(text.trimmed());
+    });
+    QObject::connect(stateFilter, QOverload<int>::of(&QComboBox::currentIndexChanged), proxy,
+                     [proxy, stateFilter]() {
+        proxy->setStateFilter(static_cast<char>(stateFilter->currentData().toInt()));
+    });
+    QObject::connect(rssFilter, QOverload<int>::of(&QSpinBox::valueChanged), proxy, [proxy](int mb) {
+        proxy->setMinRss(static_cast<quint32>(mb) * 1024);
+    });
+    QObject::connect(commandFilter, &QLineEdit::textChanged, proxy, [proxy](const QString &text) {
+        proxy->setCommandFilter(text);
+    });
+
+    // 스캔은 워커 스레드에서 하고, 모델은 표본만 바꿔 끼움
+    ProcessMonitor *monitor = new ProcessMonitor(psDialog);
+    auto treeExpanded = std::make_shared<bool>(false);
+    QObject::connect(monitor, &ProcessMonitor::sampleReady, processModel,
+                     [monitor, processModel, treeModel, processTree, treeExpanded, proxy, summaryLabel]() {
+        std::shared_ptr<const ProcessMonitor::Sample> sample = monitor->latest();
+        processModel->setSample(sample);
+        treeModel->setSample(sample);
+        // 처음에는 루트 바로 아래까지만 펼침 (이후에는 사용자가 바꾼 펼침 상태가 유지됨)
+        if (!*treeExpanded) {
+            processTree->expandToDepth(0);
+            *treeExpanded = true;
+        }
+        summaryLabel->setText(QObject::tr("프로세스 %1개 (표시 %2개), CPU 합계 %3%, 스캔 %4 ms")
+                              .arg(sample->size())
+                              .arg(proxy->rowCount())
+                              .arg(sample->totalCpu, 0, 'f', 1)
+                              .arg(sample->metrics.elapsed_ms, 0, 'f', 1));
+    });
+    QObject::connect(monitor, &ProcessMonitor::scanFailed, summaryLabel, &QLabel::setText);
+    QObject::connect(liveCheck, &QCheckBox::toggled, monitor, [monitor, intervalSpin](bool on) {
+        if (on)
+            monitor->start(intervalSpin->value() * 1000);
+        else
+            monitor->stop();
+    });
+    QObject::connect(intervalSpin, QOverload<int>::of(&QSpinBox::valueChanged), monitor,
+                     [monitor](int seconds) {
+        if (monitor->isRunning())
+            monitor->start(seconds * 1000);
+    });
+    monitor->start(intervalSpin->value() * 1000);
     
-    // 프로세스 종료 버튼과 새로고침 버튼
-    QPushButton *killButton = new QPushButton(QObject::tr("프로세스 종료"), psDialog);
+    // 시그널 버튼들과 새로고침 버튼, 마지막 시그널 결과
+    QPushButton *killButton = new QPushButton(QObject::tr("선택한 프로세스에 시그널"), psDialog);
+    QPushButton *patternButton = new QPushButton(QObject::tr("패턴으로 시그널..."), psDialog);
     QPushButton *refreshButton = new QPushButton(QObject::tr("새로고침"), psDialog);
+    QPushButton *subtreeButton = new QPushButton(QObject::tr("하위 트리에 시그널"), psDialog);
+    subtreeButton->setEnabled(false);
     QHBoxLayout *buttonLayout = new QHBoxLayout();
     buttonLayout->addWidget(killButton);
+    buttonLayout->addWidget(patternButton);
+    buttonLayout->addWidget(subtreeButton);
     buttonLayout->addWidget(refreshButton);
     layout->addLayout(buttonLayout);
-    
-    // 프로세스 종료 버튼 클릭 시
-    QObject::connect(killButton, &QPushButton::clicked, [window, processTable]() {
-        QList<QTableWidgetItem*> selectedItems = processTable->selectedItems();
-        if (!selectedItems.isEmpty()) {
-            int row = selectedItems.first()->row();
-            QString pid = processTable->item(row, 1)->text();
-            
-            if (pid.toInt() == getpid()) {
+    QLabel *signalLabel = new QLabel(psDialog);
+    layout->addWidget(signalLabel);
+
+    // 목록을 읽은 때의 (pid, 시작 시각)으로 pidfd를 열어 보내고, 종료는 이벤트 루프에서 확인.
+    // 대화상자를 띄우는 동안 표본이 바뀌므로 대상은 호출하는 쪽에서 먼저 복사해 둠
+    auto sendSignals = [window, signalLabel, monitor](const QVector<SignalBatch::Target> &targets,
+                                                     const QString &title, const QString &prompt) {
+        if (targets.isEmpty()) return;
+        for (const SignalBatch::Target &t : targets) {
+            if (t.pid == getpid()) {
                 QMessageBox::warning(window, QObject::tr("오류"),
-                                   QObject::tr("현재 실행 중인 프로그램은 종료할 수 없습니다."));
+                                     QObject::tr("현재 실행 중인 프로그램에는 시그널을 보낼 수 없습니다."));
                 return;
             }
-            
-            bool ok;
-            QString signal = QInputDialog::getText(window, QObject::tr("시그널 전송"),
-                                                QObject::tr("PID %1에 전송할 시그널 번호 (기본: 9):").arg(pid),
-                                                QLineEdit::Normal,
-                                                "9", &ok);
-            if (ok) {
-                if (call_kill(pid.toLocal8Bit().constData(),
-                             signal.toLocal8Bit().constData()) == 0) {
-                    QMessageBox::information(window, QObject::tr("성공"),
-                                          QObject::tr("프로세스가 종료되었습니다."));
-                    refreshProcessList(window, processTable);
-                } else {
-                    QMessageBox::warning(window, QObject::tr("오류"),
-                                      QObject::tr("프로세스를 종료할 수 없습니다."));
-                }
-            }
         }
+
+        int sig, escalateMs;
+        if (!askSignal(window, title, prompt, &sig, &escalateMs)) return;
+
+        // 대화상자가 먼저 닫혀도 상승·종료 확인은 끝까지 가야 하므로 batch는 창에 붙이고,
+        // 대화상자 쪽 갱신은 signalLabel을 문맥으로 연결해 라벨과 함께 끊기게 함
+        SignalBatch *batch = new SignalBatch(targets, window);
+        QObject::connect(batch, &SignalBatch::progress, signalLabel, [batch, signalLabel]() {
+            signalLabel->setText(batch->summary());
+        });
+        QObject::connect(batch, &SignalBatch::finished, signalLabel, [batch, signalLabel, monitor]() {
+            signalLabel->setText(batch->summary());
+            monitor->refresh();
+        });
+        QObject::connect(batch, &SignalBatch::finished, window, [window, batch]() {
+            window->statusBar()->showMessage(batch->summary(), 5000);
+            batch->deleteLater();
+        });
+        batch->start(sig, terminatesProcess(sig), escalateMs);
+        signalLabel->setText(batch->summary());
+    };
+
+    // 현재 탭에서 선택한 프로세스들에 시그널
+    QObject::connect(killButton, &QPushButton::clicked,
+                     [viewTabs, processTable, processTree, proxy, processModel, treeModel, sendSignals]() {
+        QVector<SignalBatch::Target> targets;
+        const ProcessMonitor::Sample *sample = nullptr;
+        QVector<int> rows;
+        if (viewTabs->currentIndex() == 1) {
+            sample = treeModel->sample();
+            for (const QModelIndex &index : processTree->selectionModel()->selectedRows())
+                rows.append(treeModel->sampleRow(index));
+        } else {
+            sample = processModel->sample();
+            for (const QModelIndex &index : processTable->selectionModel()->selectedRows())
+                rows.append(processModel->sampleRow(proxy->mapToSource(index).row()));
+        }
+        for (int row : rows)
+            targets.append({ sample->pid[row], sample->starttime[row] });
+        if (targets.isEmpty()) return;
+
+        QString prompt = targets.size() == 1
+            ? QObject::tr("PID %1 (%2)에 전송할 시그널:").arg(targets.first().pid)
+                  .arg(QString::fromLocal8Bit(sample->command(rows.first())))
+            : QObject::tr("선택한 프로세스 %1개에 전송할 시그널:").arg(targets.size());
+        sendSignals(targets, QObject::tr("시그널 전송"), prompt);
+    });
+
+    // pgrep처럼 명령 전체를 정규식과 비교해 일치하는 프로세스 모두에 시그널
+    QObject::connect(patternButton, &QPushButton::clicked, [window, processModel, sendSignals]() {
+        bool ok;
+        QString pattern = QInputDialog::getText(window, QObject::tr("패턴으로 시그널"),
+                                                QObject::tr("명령과 비교할 정규식 (pkill -f 형식):"),
+                                                QLineEdit::Normal, QString(), &ok);
+        if (!ok || pattern.isEmpty() || !processModel->sample()) return;
+
+        char error[256];
+        struct proc_pattern re;
+        if (proc_pattern_compile(&re, pattern.toLocal8Bit().constData(), PROC_MATCH_FULL,
+                                 error, sizeof(error)) == -1) {
+            QMessageBox::warning(window, QObject::tr("오류"),
+                                 QObject::tr("잘못된 패턴입니다: %1").arg(QString::fromLocal8Bit(error)));
+            return;
+        }
+        const ProcessMonitor::Sample *sample = processModel->sample();
+        QVector<SignalBatch::Target> targets;
+        QStringList preview;
+        for (int row = 0; row < sample->size(); ++row) {
+            if (sample->pid[row] == getpid()) continue;
+            if (!proc_pattern_match(&re, sample->command(row), sample->command(row))) continue;
+            targets.append({ sample->pid[row], sample->starttime[row] });
+            if (preview.size() < 10)
+                preview.append(QString("%1  %2").arg(sample->pid[row]).arg(QString::fromLocal8Bit(sample->command(row))));
+        }
+        proc_pattern_free(&re);
+
+        if (targets.isEmpty()) {
+            QMessageBox::information(window, QObject::tr("패턴으로 시그널"),
+                                     QObject::tr("일치하는 프로세스가 없습니다."));
+            return;
+        }
+        if (targets.size() > preview.size())
+            preview.append(QObject::tr("... 외 %1개").arg(targets.size() - preview.size()));
+        sendSignals(targets, QObject::tr("패턴으로 시그널"),
+                    QObject::tr("일치하는 프로세스 %1개에 전송할 시그널:\n%2")
+                    .arg(targets.size()).arg(preview.join('\n')));
     });
     
+    // 트리에서 고른 프로세스와 그 자손 전체에 시그널 (부모부터 전위 순서로)
+    auto signalSubtree = [processTree, treeModel, sendSignals]() {
+        QModelIndex index = processTree->currentIndex();
+        if (!index.isValid()) return;
+
+        const ProcessMonitor::Sample *sample = treeModel->sample();
+        QVector<SignalBatch::Target> targets;
+        for (int row : treeModel->subtreeRows(index))
+            targets.append({ sample->pid[row], sample->starttime[row] });
+        sendSignals(targets, QObject::tr("하위 트리에 시그널"),
+                    QObject::tr("PID %1과 하위 프로세스 %2개에 전송할 시그널:")
+                    .arg(targets.first().pid).arg(targets.size() - 1));
+    };
+    QObject::connect(subtreeButton, &QPushButton::clicked, signalSubtree);
+    QObject::connect(viewTabs, &QTabWidget::currentChanged, subtreeButton, [subtreeButton, processTree](int tab) {
+        subtreeButton->setEnabled(tab == 1 && processTree->currentIndex().isValid());
+    });
+    QObject::connect(processTree->selectionModel(), &QItemSelectionModel::currentChanged, subtreeButton,
+                     [subtreeButton](const QModelIndex &current) {
+        subtreeButton->setEnabled(current.isValid());
+    });
+    QObject::connect(processTree, &QTreeView::customContextMenuRequested, processTree,
+                     [processTree, signalSubtree](const QPoint &pos) {
+        if (!processTree->indexAt(pos).isValid()) return;
+        QMenu menu(processTree);
+        menu.addAction(QObject::tr("하위 트리에 시그널 보내기..."), signalSubtree);
+        menu.addSeparator();
+        menu.addAction(QObject::tr("모두 펼치기"), processTree, &QTreeView::expandAll);
+        menu.addAction(QObject::tr("모두 접기"), processTree, &QTreeView::collapseAll);
+        menu.exec(processTree->viewport()->mapToGlobal(pos));
+    });
+
     // 새로고침 버튼 클릭 시
-    QObject::connect(refreshButton, &QPushButton::clicked, [window, processTable]() {
-        refreshProcessList(window, processTable);
+    QObject::connect(refreshButton, &QPushButton::clicked, monitor, [monitor]() {
+        monitor->refresh();
     });
     
     psDialog->exec();
     delete psDialog;
 }
 
+// 프로세스 목록 대화상자와 같은 길: 묻기 전에 (pid, 시작 시각)을 읽어 두고 pidfd로 보내므로
+// 시그널을 고르는 사이 프로세스가 끝나고 pid가 재사용돼도 다른 프로세스에 보내지 않음
 void MainWindowProcessActions::handleKill(MainWindow* window, const QString &pid)
 {
-    bool ok;
-    QString signal = QInputDialog::getText(window, QObject::tr("시그널 전송"),
-                                         QObject::tr("PID %1에 전송할 시그널 번호 (기본: 15):").arg(pid),
-                                         QLineEdit::Normal,
-                                         "15", &ok);
-    if (ok) {
-        call_kill(pid.toLocal8Bit().constData(),
-                 signal.toLocal8Bit().constData());
+    bool ok = true;
+    int target = pid.isEmpty()
+        ? QInputDialog::getInt(window, QObject::tr("시그널 전송"), QObject::tr("시그널을 보낼 PID:"),
+                               1, 1, INT_MAX, 1, &ok)
+        : pid.toInt(&ok);
+    if (!ok) return;
+    if (target <= 0) {
+        QMessageBox::warning(window, QObject::tr("오류"), QObject::tr("잘못된 PID입니다: %1").arg(pid));
+        return;
+    }
+    if (target == getpid()) {
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("현재 실행 중인 프로그램에는 시그널을 보낼 수 없습니다."));
+        return;
     }
-}
 
-void MainWindowProcessActions::refreshProcessList(MainWindow* window, QTableWidget *processTable)
-{
-    processTable->setRowCount(0);
-    
-    QString tempFileName = QDir::temp().filePath("ps_output.tmp");
-    FILE *temp = fopen(tempFileName.toLocal8Bit().constData(), "w+");
-    
-    if (temp) {
-        int stdout_fd = dup(STDOUT_FILENO);
-        dup2(fileno(temp), STDOUT_FILENO);
-        
-        call_ps("-ef");
-        
-        dup2(stdout_fd, STDOUT_FILENO);
-        ::close(stdout_fd);
-        fclose(temp);
-        
-        QFile tempFile(tempFileName);
-        if (tempFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream in(&tempFile);
-            QStringList headers = in.readLine().split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-            
-            processTable->setColumnCount(headers.size());
-            processTable->setHorizontalHeaderLabels(headers);
-            
-            while (!in.atEnd()) {
-                QStringList fields = in.readLine().split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-                int row = processTable->rowCount();
-                processTable->insertRow(row);
-                for (int i = 0; i < fields.size() && i < headers.size(); ++i) {
-                    processTable->setItem(row, i, new QTableWidgetItem(fields[i]));
-                }
-            }
-            tempFile.close();
-        }
-        QFile::remove(tempFileName);
+    QFile statFile(QString("/proc/%1/stat").arg(target));
+    QByteArray stat = statFile.open(QIODevice::ReadOnly) ? statFile.readAll() : QByteArray();
+    struct proc_info info;
+    if (stat.isEmpty() ||
+        proc_parse_stat(stat.constData(), static_cast<size_t>(stat.size()), &info,
+                        static_cast<unsigned long>(sysconf(_SC_PAGESIZE) / 1024)) == -1) {
+        QMessageBox::warning(window, QObject::tr("오류"),
+                             QObject::tr("PID %1 프로세스가 없습니다.").arg(target));
+        return;
     }
-    
-    processTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    int sig, escalateMs;
+    if (!askSignal(window, QObject::tr("시그널 전송"),
+                   QObject::tr("PID %1 (%2)에 전송할 시그널:").arg(target).arg(QString::fromLocal8Bit(info.comm)),
+                   &sig, &escalateMs))
+        return;
+
+    SignalBatch *batch = new SignalBatch({ { static_cast<pid_t>(target), info.starttime } }, window);
+    QObject::connect(batch, &SignalBatch::progress, window, [window, batch]() {
+        window->statusBar()->showMessage(batch->summary());
+    });
+    QObject::connect(batch, &SignalBatch::finished, window, [window, batch]() {
+        window->statusBar()->showMessage(batch->summary(), 5000);
+        batch->deleteLater();
+    });
+    batch->start(sig, terminatesProcess(sig), escalateMs);
+    window->statusBar()->showMessage(batch->summary());
 }
 
 // 프로세스 관련 액션들의 구현 
\ No newline at end of file
@@ -2,9 +2,33 @@
 #include "../include/mainwindow.h"
 #include "../include/mainwindow_test_actions.h"
 #include "../include/commands.h"
+#include "../include/job_panel.h"
+#include <cerrno>
+#include <cstring>
+#include <functional>
 
 MainWindowTestActions::MainWindowTestActions(QObject *parent) : QObject(parent) {}
 
+namespace {
+
+class BenchTask : public QRunnable {
+public:
+    explicit BenchTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+QString formatLatency(quint64 ns)
+{
+    if (ns < 1000) return QObject::tr("%1 ns").arg(ns);
+    if (ns < 1000000) return QObject::tr("%1 us").arg(ns / 1e3, 0, 'f', 1);
+    return QObject::tr("%1 ms").arg(ns / 1e6, 0, 'f', 2);
+}
+
+} // namespace
+
 void MainWindowTestActions::handleMmapTest(MainWindow* window)
 {
     QString fileName = QFileDialog::getSaveFileName(window, 
@@ -17,42 +41,98 @@ void MainWindowTestActions::handleMmapTest(MainWindow* window)
     }
 
     QDialog *resultDialog = new QDialog(window);
-    resultDialog->setWindowTitle(QObject::tr("메모리 매핑 테스트 결과"));
+    resultDialog->setWindowTitle(QObject::tr("공유 메모리 링 벤치마크"));
     resultDialog->resize(600, 400);
 
     QVBoxLayout *layout = new QVBoxLayout(resultDialog);
-    
+
+    struct mmap_test_options defaults;
+    mmap_test_default_options(&defaults);
+
+    QFormLayout *form = new QFormLayout;
+    QSpinBox *messagesSpin = new QSpinBox(resultDialog);
+    messagesSpin->setRange(1000, 100000000);
+    messagesSpin->setSingleStep(1000000);
+    messagesSpin->setGroupSeparatorShown(true);
+    messagesSpin->setValue(static_cast<int>(defaults.messages));
+    QSpinBox *producersSpin = new QSpinBox(resultDialog);
+    producersSpin->setRange(1, MMAP_TEST_MAX_PRODUCERS);
+    producersSpin->setValue(defaults.producers);
+    producersSpin->setToolTip(QObject::tr("1이면 SPSC, 2 이상이면 MPSC"));
+    QSpinBox *capacitySpin = new QSpinBox(resultDialog);
+    capacitySpin->setRange(2, 1 << 20);
+    capacitySpin->setValue(static_cast<int>(defaults.capacity));
+    form->addRow(QObject::tr("메시지 수:"), messagesSpin);
+    form->addRow(QObject::tr("생산자 프로세스:"), producersSpin);
+    form->addRow(QObject::tr("링 슬롯 수:"), capacitySpin);
+    layout->addLayout(form);
+
     QTextEdit *resultText = new QTextEdit(resultDialog);
     resultText->setReadOnly(true);
+    resultText->setPlainText(QObject::tr("파일: %1").arg(fileName));
     layout->addWidget(resultText);
 
-    QString tempFileName = QDir::temp().filePath("mmap_output.tmp");
-    FILE *temp = fopen(tempFileName.toLocal8Bit().constData(), "w+");
-    
-    if (temp) {
-        int stdout_fd = dup(STDOUT_FILENO);
-        dup2(fileno(temp), STDOUT_FILENO);
-        
-        call_mmap_test(fileName.toLocal8Bit().constData());
-        
-        dup2(stdout_fd, STDOUT_FILENO);
-        ::close(stdout_fd);
-        fclose(temp);
-        
-        QFile tempFile(tempFileName);
-        if (tempFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QString content = QString::fromLocal8Bit(tempFile.readAll());
-            resultText->setPlainText(content);
-            tempFile.close();
-        }
-        
-        QFile::remove(tempFileName);
-    }
-
+    QHBoxLayout *buttons = new QHBoxLayout;
+    QPushButton *startButton = new QPushButton(QObject::tr("시작"), resultDialog);
     QPushButton *closeButton = new QPushButton(QObject::tr("닫기"), resultDialog);
-    layout->addWidget(closeButton);
+    buttons->addStretch();
+    buttons->addWidget(startButton);
+    buttons->addWidget(closeButton);
+    layout->addLayout(buttons);
     QObject::connect(closeButton, &QPushButton::clicked, resultDialog, &QDialog::accept);
 
+    // 수백만 개를 주고받는 동안 UI가 멈추지 않도록 스레드 풀에서 실행하고 결과만 되돌림
+    QPointer<QDialog> guard(resultDialog);
+    QObject::connect(startButton, &QPushButton::clicked, resultDialog, [=]() {
+        struct mmap_test_options opts = defaults;
+        opts.messages = static_cast<unsigned long>(messagesSpin->value());
+        opts.producers = producersSpin->value();
+        opts.capacity = static_cast<uint32_t>(capacitySpin->value());
+        QByteArray localPath = fileName.toLocal8Bit();
+
+        startButton->setEnabled(false);
+        resultText->append(QObject::tr("\n실행 중... (메시지 %L1개, 생산자 %2개)")
+                           .arg(opts.messages).arg(opts.producers));
+
+        QThreadPool::globalInstance()->start(new BenchTask([=]() {
+            struct mmap_test_result result;
+            int rc = mmap_test_run(localPath.constData(), &opts, &result);
+            int err = errno;
+
+            QMetaObject::invokeMethod(qApp, [=]() {
+                if (!guard) return;
+                startButton->setEnabled(true);
+                if (rc == -1) {
+                    resultText->append(QObject::tr("메모리 매핑 테스트 실패: %1")
+                                       .arg(QString::fromLocal8Bit(strerror(err))));
+                    return;
+                }
+                resultText->append(QObject::tr(
+                    "링 버퍼: 슬롯 %1개 × %2바이트, 생산자 %3개 (%4), 소비자 PID %5\n"
+                    "메시지 %L6개, %7 ms, %L8 msg/s (%9 MB/s)\n")
+                    .arg(result.capacity)
+                    .arg(result.msg_size)
+                    .arg(result.producers)
+                    .arg(result.producers > 1 ? "MPSC" : "SPSC")
+                    .arg(result.parent_pid)
+                    .arg(result.messages)
+                    .arg(result.elapsed_ms, 0, 'f', 1)
+                    .arg(static_cast<qulonglong>(result.msgs_per_sec))
+                    .arg(result.mb_per_sec, 0, 'f', 1)
+                    + QObject::tr(
+                    "지연 p50 %1, p99 %2, p999 %3, 최대 %4\n"
+                    "futex 대기: 생산자 %5번, 소비자 %6번, 순서 어긋남 %7개")
+                    .arg(formatLatency(result.p50_ns))
+                    .arg(formatLatency(result.p99_ns))
+                    .arg(formatLatency(result.p999_ns))
+                    .arg(formatLatency(result.max_ns))
+                    .arg(static_cast<qulonglong>(result.producer_sleeps))
+                    .arg(static_cast<qulonglong>(result.consumer_sleeps))
+                    .arg(result.out_of_order));
+            }, Qt::QueuedConnection);
+        }));
+    });
+
     resultDialog->exec();
     delete resultDialog;
 }
@@ -103,19 +183,15 @@ void MainWindowTestActions::handleExecuteProgram(MainWindow* window)
             return;
         }
 
-        QByteArray programBytes = program.toLocal8Bit();
-        QVector<QByteArray> argumentBytes;
-        QVector<char*> args;
-        
-        args.push_back(programBytes.data());
-        for (const QString &arg : arguments) {
-            argumentBytes.push_back(arg.toLocal8Bit());
-            args.push_back(argumentBytes.last().data());
+        // 작업 패널에서 띄우고 바로 돌아옴 (출력은 작업별 콘솔로)
+        QString error;
+        if (!window->jobPanel->start(program, arguments, window->getCurrentDirectory(), &error)) {
+            QMessageBox::warning(window, QObject::tr("오류"),
+                QObject::tr("프로그램을 실행할 수 없습니다: %1").arg(error));
+            return;
         }
-        args.push_back(nullptr);
-
-        execute_program(programBytes.data(), args.data());
-        
-        window->statusBar()->showMessage(QObject::tr("프로그램 실행 완료"), 3000);
+        window->jobDock->show();
+        window->jobDock->raise();
+        window->statusBar()->showMessage(QObject::tr("프로그램 실행: %1").arg(program), 3000);
     }
 }
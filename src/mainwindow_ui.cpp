@@ -2,6 +2,12 @@
 #include "../include/mainwindow_ui.h"
 #include "../include/mainwindow_file_actions.h"
 #include "../include/config.h"
+#include "../include/preview_loader.h"
+#include "../include/dir_stats_tracker.h"
+#include "../include/file_indexer.h"
+#include "../include/grep_panel.h"
+#include "../include/job_panel.h"
+#include <memory>
 
 MainWindowUI::MainWindowUI(QObject *parent) : QObject(parent) {}
 
@@ -110,10 +116,27 @@ void MainWindowUI::setupUI(MainWindow* window)
     mainLayout->addWidget(mainSplitter);
     window->setCentralWidget(centralWidget);
 
+    // 상태바 통계는 디렉토리 변경 알림과 작업별 델타로 갱신
+    window->dirStats = new DirStatsTracker(window);
+    QObject::connect(window->dirStats, &DirStatsTracker::statsChanged, window,
+                     [window]() { MainWindowFileActions::updateStatusBar(window); });
+
+    // 미리보기는 워커 스레드에서 만들고, 가장 최근 선택의 결과만 반영
+    PreviewLoader *previewLoader = new PreviewLoader(window);
+    QObject::connect(previewLoader, &PreviewLoader::previewReady, previewText,
+        [previewLoader, previewText, sizeLabel, modifiedLabel](qulonglong generation, const QString &text,
+                                                               qint64 size, const QDateTime &modified) {
+            if (generation != previewLoader->currentGeneration()) return;
+            previewText->setPlainText(text);
+            sizeLabel->setText(size >= 0 ? MainWindowFileActions::formatSize(size) : QString());
+            modifiedLabel->setText(modified.isValid() ? modified.toString("yyyy-MM-dd hh:mm:ss") : QString());
+        });
+
     // 파일 선택 시 미리보기 업데이트
     QObject::connect(window->listView->selectionModel(), &QItemSelectionModel::selectionChanged,
-        [window, previewText, nameLabel, sizeLabel, typeLabel, modifiedLabel](const QItemSelection &selected) {
+        [window, previewLoader, previewText, nameLabel, sizeLabel, typeLabel, modifiedLabel](const QItemSelection &selected) {
             if (selected.indexes().isEmpty()) {
+                previewLoader->cancel();
                 previewText->clear();
                 nameLabel->clear();
                 sizeLabel->clear();
@@ -124,89 +147,144 @@ void MainWindowUI::setupUI(MainWindow* window)
 
             QModelIndex index = selected.indexes().first();
             QString filePath = window->fileSystemModel->filePath(index);
-            QFileInfo fileInfo(filePath);
 
-            // 파일 정보 업데이트
-            nameLabel->setText(fileInfo.fileName());
-            sizeLabel->setText(MainWindowFileActions::formatSize(fileInfo.size()));
+            // 이름과 유형은 모델에 이미 있으므로 바로 표시 (디스크 접근 없음)
+            nameLabel->setText(window->fileSystemModel->fileName(index));
             typeLabel->setText(window->fileSystemModel->type(index));
-            modifiedLabel->setText(fileInfo.lastModified().toString("yyyy-MM-dd hh:mm:ss"));
-
-            // 텍스트 파일인 경우 내용 미리보기
-            if (fileInfo.isFile()) {
-                QFile file(filePath);
-                if (file.open(QIODevice::ReadOnly)) {
-                    // 바이너리 파인지 확인
-                    QByteArray header = file.read(4096);
-                    bool isBinary = false;
-                    for (char c : header) {
-                        if (c == 0 || (unsigned char)c > 127) {
-                            isBinary = true;
-                            break;
-                        }
-                    }
-
-                    if (!isBinary && fileInfo.size() < 1024 * 1024) { // 1MB 미만 텍스트 파일만
-                        file.seek(0);
-                        QTextStream in(&file);
-                        previewText->setPlainText(in.read(4096)); // 최대 4KB까지만 읽기
-                    } else {
-                        previewText->setPlainText(QObject::tr("바이너리 파일은 미리보기를 지원하지 않습니다."));
-                    }
-                    file.close();
-                } else {
-                    previewText->setPlainText(QObject::tr("파일을 열 수 없습니다."));
-                }
-            } else if (fileInfo.isDir()) {
-                // 디렉토리 내용 표시
-                QDir dir(filePath);
-                QStringList entries = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
-                previewText->setPlainText(QObject::tr("디디디렉토리 내용:\n\n") + entries.join("\n"));
-            }
+            sizeLabel->clear();
+            modifiedLabel->clear();
+            previewText->setPlainText(QObject::tr("불러오는 중..."));
+
+            previewLoader->request(filePath);
     });
 
-    // 검색 기능 구현
-    QObject::connect(searchButton, &QPushButton::clicked, [window, searchEdit]() {
+    // 검색은 BASE_DIR 전체의 파일 이름 색인으로 처리 (백그라운드에서 만들고 inotify로 갱신)
+    FileIndexer *fileIndexer = new FileIndexer(QString(BASE_DIR), window);
+    const int searchResultLimit = 10000;
+
+    // 검색 결과 패널: 결과가 묶음 단위로 도착하는 대로 덧붙임
+    QDockWidget *searchDock = new QDockWidget(QObject::tr("검색 결과"), window);
+    searchDock->setObjectName("searchDock");
+    QWidget *searchPanel = new QWidget(searchDock);
+    QVBoxLayout *searchPanelLayout = new QVBoxLayout(searchPanel);
+    QHBoxLayout *searchStatusLayout = new QHBoxLayout();
+    QLabel *searchStatus = new QLabel(searchPanel);
+    QCheckBox *scopeCheck = new QCheckBox(QObject::tr("현재 디렉토리 아래만"), searchPanel);
+    scopeCheck->setChecked(true);
+    searchStatusLayout->addWidget(searchStatus, 1);
+    searchStatusLayout->addWidget(scopeCheck);
+    searchPanelLayout->addLayout(searchStatusLayout);
+    QListWidget *searchResults = new QListWidget(searchPanel);
+    searchResults->setUniformItemSizes(true);
+    searchPanelLayout->addWidget(searchResults);
+    searchDock->setWidget(searchPanel);
+    window->addDockWidget(Qt::BottomDockWidgetArea, searchDock);
+    searchDock->hide();
+
+    auto searchGeneration = std::make_shared<qulonglong>(0);
+    auto runSearch = [=]() {
         QString searchText = searchEdit->text();
         if (searchText.isEmpty()) {
             window->statusBar()->showMessage(QObject::tr("검색어를 입력하세요."), 3000);
             return;
         }
 
-        // 현재 디렉토리에서 검색 시작
-        QString currentDir = QString::fromStdString(window->currentPath);
-        QDirIterator it(currentDir, 
-                       QStringList() << "*" + searchText + "*",
-                       QDir::AllEntries | QDir::NoDotAndDotDot,
-                       QDirIterator::Subdirectories);
+        searchDock->show();
+        searchResults->clear();
+        QString scope = scopeCheck->isChecked() ? QString::fromStdString(window->currentPath) : QString();
+        *searchGeneration = fileIndexer->search(searchText, scope, searchResultLimit);
+        searchStatus->setText(fileIndexer->isIndexing()
+                              ? QObject::tr("색인하는 중... (지금까지 %1개 항목)").arg(fileIndexer->indexedCount())
+                              : QObject::tr("검색 중..."));
+    };
+
+    QObject::connect(fileIndexer, &FileIndexer::resultsReady, searchResults,
+        [searchGeneration, searchResults](qulonglong generation, const QStringList &paths) {
+            if (generation != *searchGeneration) return;
+            searchResults->addItems(paths);
+        });
+
+    QObject::connect(fileIndexer, &FileIndexer::searchFinished, searchResults,
+        [window, fileIndexer, searchEdit, searchStatus, searchGeneration, searchResultLimit]
+        (qulonglong generation, qulonglong total, bool truncated, double elapsedMs) {
+            if (generation != *searchGeneration) return;
+
+            QString status = total > 0
+                ? QObject::tr("'%1' 검색 결과: %2개 항목 발견 (%3 ms)").arg(searchEdit->text()).arg(total).arg(elapsedMs, 0, 'f', 1)
+                : QObject::tr("'%1'에 대한 검색 결과가 없습니다.").arg(searchEdit->text());
+            if (truncated)
+                status += QObject::tr(" - 처음 %1개만 표시").arg(searchResultLimit);
+            if (fileIndexer->isIndexing())
+                status += QObject::tr(" - 색인하는 중이라 일부만 검색됨");
+            else if (fileIndexer->watchLimitReached())
+                status += QObject::tr(" - inotify 감시 한도를 넘어 최근 변경이 빠졌을 수 있음");
+            searchStatus->setText(status);
+            window->statusBar()->showMessage(status, 3000);
+        });
+
+    // 색인이 끝나면 색인 도중 검색한 결과를 다시 채움
+    QObject::connect(fileIndexer, &FileIndexer::indexStateChanged, searchDock,
+        [fileIndexer, searchDock, searchEdit, runSearch]() {
+            if (!fileIndexer->isIndexing() && searchDock->isVisible() && !searchEdit->text().isEmpty())
+                runSearch();
+        });
+
+    // 결과를 더블클릭하면 그 항목이 있는 디렉토리로 이동해서 선택
+    QObject::connect(searchResults, &QListWidget::itemDoubleClicked, [window](QListWidgetItem *item) {
+        QFileInfo info(item->text());
+        window->setCurrentDirectory(info.absolutePath().toStdString(), true);
+        QModelIndex index = window->fileSystemModel->index(info.absoluteFilePath());
+        window->listView->setCurrentIndex(index);
+        window->listView->scrollTo(index);
+    });
 
-        QStringList foundFiles;
-        while (it.hasNext()) {
-            foundFiles << it.next();
-        }
+    QObject::connect(searchButton, &QPushButton::clicked, runSearch);
+    QObject::connect(scopeCheck, &QCheckBox::toggled, searchPanel, [searchEdit, runSearch]() {
+        if (!searchEdit->text().isEmpty()) runSearch();
+    });
 
-        if (!foundFiles.isEmpty()) {
-            // 첫 번째 검색 결과로 이동
-            QModelIndex index = window->fileSystemModel->index(foundFiles.first());
-            window->listView->setCurrentIndex(index);
-            window->listView->scrollTo(index);
-            
-            // 검색 결과 표시
-            window->statusBar()->showMessage(
-                QObject::tr("'%1' 검색 결과: %2개 항목 발견")
-                .arg(searchText)
-                .arg(foundFiles.size()), 
-                3000
-            );
+    // 색인 검색은 빠르므로 입력하는 동안에도 잠깐 멈추면 검색
+    QTimer *searchDebounce = new QTimer(window);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(200);
+    QObject::connect(searchDebounce, &QTimer::timeout, runSearch);
+    QObject::connect(searchEdit, &QLineEdit::textChanged, [fileIndexer, searchDebounce, searchGeneration](const QString &text) {
+        if (text.size() >= 2) {
+            searchDebounce->start();
         } else {
-            window->statusBar()->showMessage(
-                QObject::tr("'%1'에 대한 검색 결과가 없습니다.")
-                .arg(searchText), 
-                3000
-            );
+            searchDebounce->stop();
+            fileIndexer->cancelSearch();
+            *searchGeneration = 0;
         }
     });
 
+    fileIndexer->start();
+
+    // 내용 검색 패널: 현재 디렉토리 아래를 grep 엔진으로 검색, 결과를 더블클릭하면 그 줄을 열어 보여줌
+    window->grepDock = new QDockWidget(QObject::tr("내용 검색"), window);
+    window->grepDock->setObjectName("grepDock");
+    window->grepPanel = new GrepPanel(window->grepDock);
+    window->grepDock->setWidget(window->grepPanel);
+    window->addDockWidget(Qt::BottomDockWidgetArea, window->grepDock);
+    window->grepDock->hide();
+    QObject::connect(window->grepPanel, &GrepPanel::openRequested, window,
+                     [window](const QString &path, qulonglong line) {
+        MainWindowFileActions::openFileViewer(window, path, line);
+    });
+
+    // 작업 패널: 프로그램 실행으로 띄운 작업 목록과 작업별 출력
+    window->jobDock = new QDockWidget(QObject::tr("작업"), window);
+    window->jobDock->setObjectName("jobDock");
+    window->jobPanel = new JobPanel(window->jobDock);
+    window->jobDock->setWidget(window->jobPanel);
+    window->addDockWidget(Qt::BottomDockWidgetArea, window->jobDock);
+    window->tabifyDockWidget(window->grepDock, window->jobDock);
+    window->jobDock->hide();
+    QObject::connect(window->jobPanel, &JobPanel::jobFinished, window,
+                     [window](const QString &command, const QString &result) {
+        window->statusBar()->showMessage(QObject::tr("작업 종료: %1 (%2)").arg(command, result), 5000);
+    });
+
     // Enter 키로도 검색 가능하도록 설정
     QObject::connect(searchEdit, &QLineEdit::returnPressed, searchButton, &QPushButton::click);
 
@@ -264,6 +342,17 @@ void MainWindowUI::createActions(MainWindow* window)
     window->lsAction = new QAction(QIcon::fromTheme("view-list-details"), QObject::tr("상세 보기"), window);
     window->lsAction->setStatusTip(QObject::tr("파일 목록 상세 보기"));
 
+    // du 액션 추가
+    window->duAction = new QAction(QIcon::fromTheme("drive-harddisk"), QObject::tr("디스크 사용량"), window);
+    window->duAction->setStatusTip(QObject::tr("하위 디렉토리별 디스크 사용량 보기"));
+
+    // 내용 검색 패널 표시/숨김
+    window->grepAction = window->grepDock->toggleViewAction();
+    window->grepAction->setIcon(QIcon::fromTheme("edit-find"));
+    window->grepAction->setText(QObject::tr("내용 검색"));
+    window->grepAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_F));
+    window->grepAction->setStatusTip(QObject::tr("현재 디렉토리 아래 파일 내용 검색"));
+
     // rmdir 액션 추가
     window->rmdirAction = new QAction(QIcon::fromTheme("folder-remove"), QObject::tr("디렉토리 삭제"), window);
     window->rmdirAction->setStatusTip(QObject::tr("빈 디렉토리 삭제"));
@@ -301,6 +390,8 @@ void MainWindowUI::createActions(MainWindow* window)
                     [window]() { MainWindowFileActions::handleChmod(window); });
     QObject::connect(window->lsAction, &QAction::triggered, 
                     [window]() { MainWindowFileActions::handleLs(window); });
+    QObject::connect(window->duAction, &QAction::triggered, 
+                    [window]() { MainWindowFileActions::handleDu(window); });
     QObject::connect(window->rmdirAction, &QAction::triggered, 
                     [window]() { MainWindowFileActions::handleRmdir(window); });
     QObject::connect(window->exitAction, &QAction::triggered, window, &QWidget::close);
@@ -328,6 +419,12 @@ void MainWindowUI::createActions(MainWindow* window)
     QObject::connect(window->execProgramAction, &QAction::triggered, 
                     [window]() { MainWindowTestActions::handleExecuteProgram(window); });
 
+    // 작업 패널 표시/숨김
+    window->jobsAction = window->jobDock->toggleViewAction();
+    window->jobsAction->setIcon(QIcon::fromTheme("utilities-terminal"));
+    window->jobsAction->setText(QObject::tr("작업"));
+    window->jobsAction->setStatusTip(QObject::tr("실행 중인 프로그램과 출력 보기"));
+
     // 초기 상태 설정
     window->deleteAction->setEnabled(false);
     window->copyAction->setEnabled(false);
@@ -367,6 +464,8 @@ void MainWindowUI::createToolBar(MainWindow* window)
     fileToolBar->addAction(window->chmodAction);
     fileToolBar->addSeparator();
     fileToolBar->addAction(window->lsAction);
+    fileToolBar->addAction(window->duAction);
+    fileToolBar->addAction(window->grepAction);
     fileToolBar->addSeparator();
     fileToolBar->addAction(window->rmdirAction);
     fileToolBar->addSeparator();
@@ -382,6 +481,7 @@ void MainWindowUI::createToolBar(MainWindow* window)
     testToolBar->setObjectName("testToolBar");
     testToolBar->addAction(window->mmapTestAction);
     testToolBar->addAction(window->execProgramAction);
+    testToolBar->addAction(window->jobsAction);
 }
 
 void MainWindowUI::createMenuBar(MainWindow* window)
@@ -399,6 +499,8 @@ void MainWindowUI::createMenuBar(MainWindow* window)
     fileMenu->addAction(window->chmodAction);
     fileMenu->addSeparator();
     fileMenu->addAction(window->lsAction);
+    fileMenu->addAction(window->duAction);
+    fileMenu->addAction(window->grepAction);
     fileMenu->addSeparator();
     fileMenu->addAction(window->rmdirAction);
     fileMenu->addSeparator();
@@ -413,6 +515,7 @@ void MainWindowUI::createMenuBar(MainWindow* window)
     QMenu *testMenu = window->menuBar()->addMenu(QObject::tr("테스트(&T)"));
     testMenu->addAction(window->mmapTestAction);
     testMenu->addAction(window->execProgramAction);
+    testMenu->addAction(window->jobsAction);
 }
 
 void MainWindowUI::handleSelectionChanged(MainWindow* window)
@@ -0,0 +1,116 @@
+#define _GNU_SOURCE
+#include "../include/mapguard.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// 시그널 핸들러가 잠금 없이 읽으므로 모든 필드를 원자적으로 다룸.
+// start가 0이 아니면 유효한 슬롯 (end를 먼저 쓰고 start를 나중에 씀)
+struct guard_slot {
+    int used;
+    uintptr_t start, end;       // end는 페이지 경계로 올림
+    int faulted;
+};
+
+static struct guard_slot slots[MAP_GUARD_SLOTS];
+static pthread_once_t install_once = PTHREAD_ONCE_INIT;
+static struct sigaction previous;
+static int install_error;
+static uintptr_t page_mask;
+
+static void chain_previous(int signo, siginfo_t *info, void *context) {
+    if (previous.sa_flags & SA_SIGINFO) {
+        previous.sa_sigaction(signo, info, context);
+    } else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+        previous.sa_handler(signo);
+    } else {
+        // 우리 매핑이 아님: 기본 동작으로 되돌리고 돌아가면 같은 명령이 다시 SIGBUS를 냄
+        struct sigaction dfl;
+        memset(&dfl, 0, sizeof(dfl));
+        dfl.sa_handler = SIG_DFL;
+        sigemptyset(&dfl.sa_mask);
+        sigaction(SIGBUS, &dfl, NULL);
+    }
+}
+
+static void bus_handler(int signo, siginfo_t *info, void *context) {
+    int saved_errno = errno;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+
+    for (int i = 0; i < MAP_GUARD_SLOTS; i++) {
+        uintptr_t start = __atomic_load_n(&slots[i].start, __ATOMIC_ACQUIRE);
+        if (start == 0 || addr < start) continue;
+        uintptr_t end = __atomic_load_n(&slots[i].end, __ATOMIC_RELAXED);
+        if (addr >= end) continue;
+
+        // 잘린 페이지부터 끝까지 0 페이지로 바꿈. 앞쪽의 유효한 페이지는 그대로 둠
+        uintptr_t page = addr & page_mask;
+        void *patched = mmap((void *)page, end - page, PROT_READ,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        if (patched != MAP_FAILED) {
+            __atomic_store_n(&slots[i].faulted, 1, __ATOMIC_RELEASE);
+            errno = saved_errno;
+            return;
+        }
+        break;
+    }
+
+    chain_previous(signo, info, context);
+    errno = saved_errno;
+}
+
+static void install_handler(void) {
+    page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = bus_handler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGBUS, &sa, &previous) == -1)
+        install_error = errno;
+}
+
+int map_guard_add(const void *addr, size_t len) {
+    pthread_once(&install_once, install_handler);
+    if (install_error) {
+        errno = install_error;
+        return -1;
+    }
+    if (!addr || len == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (int i = 0; i < MAP_GUARD_SLOTS; i++) {
+        int expected = 0;
+        if (!__atomic_compare_exchange_n(&slots[i].used, &expected, 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            continue;
+        uintptr_t start = (uintptr_t)addr;
+        __atomic_store_n(&slots[i].faulted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slots[i].end, (start + len + ~page_mask) & page_mask, __ATOMIC_RELAXED);
+        __atomic_store_n(&slots[i].start, start, __ATOMIC_RELEASE);
+        return i;
+    }
+    errno = ENOSPC;
+    return -1;
+}
+
+int map_guard_take_fault(int slot) {
+    if (slot < 0 || slot >= MAP_GUARD_SLOTS) return 0;
+    return __atomic_exchange_n(&slots[slot].faulted, 0, __ATOMIC_ACQ_REL);
+}
+
+int map_guard_remove(int slot) {
+    if (slot < 0 || slot >= MAP_GUARD_SLOTS) return 0;
+    __atomic_store_n(&slots[slot].start, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&slots[slot].end, 0, __ATOMIC_RELAXED);
+    int faulted = __atomic_exchange_n(&slots[slot].faulted, 0, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&slots[slot].used, 0, __ATOMIC_RELEASE);
+    return faulted;
+}
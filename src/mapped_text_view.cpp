@@ -0,0 +1,226 @@
+#include <QtWidgets>
+#include "../include/mapped_text_view.h"
+#include <climits>
+#include <cstring>
+
+// 한 줄에서 그릴 최대 바이트 수 (개행 없는 거대한 줄 대비)
+static const size_t MAX_RENDER_BYTES = 4096;
+
+MappedTextView::MappedTextView(QWidget *parent) : QAbstractScrollArea(parent)
+{
+    memset(&file, 0, sizeof(file));
+    file.fd = -1;
+
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    setFocusPolicy(Qt::StrongFocus);
+    viewport()->setBackgroundRole(QPalette::Base);
+    viewport()->setAutoFillBackground(true);
+
+    // 스크롤바 위치 = 바이트 오프셋. 그 위치가 속한 줄의 시작부터 그림
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+        if (syncing) return;
+        setTop(mapped_file_line_start(&file, static_cast<size_t>(value) * scale));
+    });
+    connect(horizontalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        viewport()->update();
+    });
+}
+
+MappedTextView::~MappedTextView()
+{
+    if (opened)
+        mapped_file_close(&file);
+}
+
+bool MappedTextView::openFile(const QString &path, QString *error)
+{
+    if (opened) {
+        mapped_file_close(&file);
+        opened = false;
+    }
+    if (mapped_file_open(&file, path.toLocal8Bit().constData()) == -1) {
+        if (error) *error = QString::fromLocal8Bit(strerror(errno));
+        return false;
+    }
+    opened = true;
+
+    scale = file.size / INT_MAX + 1;
+    top = 0;
+    maxLineWidth = 0;
+    horizontalScrollBar()->setValue(0);
+    updateLastTop();
+    syncScrollBars();
+    viewport()->update();
+    emit positionChanged(0, file.size, 0);
+    return true;
+}
+
+// 열어 둔 동안 파일이 잘리거나 늘어났으면 다시 매핑하고 화면 위치를 새 크기에 맞춤
+void MappedTextView::refreshFile()
+{
+    if (!opened || mapped_file_refresh(&file) <= 0) return;
+
+    scale = file.size / INT_MAX + 1;
+    updateLastTop();
+    top = mapped_file_line_start(&file, qMin(top, lastTop));
+    syncScrollBars();
+
+    size_t line = 0;
+    bool known = mapped_file_line_at(&file, top, &line) == 0;
+    emit positionChanged(top, file.size, known ? static_cast<qlonglong>(line) : -1);
+}
+
+void MappedTextView::scrollToOffset(qulonglong offset)
+{
+    refreshFile();
+    setTop(mapped_file_line_start(&file, static_cast<size_t>(offset)));
+}
+
+void MappedTextView::scrollToLine(qulonglong line)
+{
+    // 그 줄까지만 색인을 만들어 감
+    refreshFile();
+    setTop(mapped_file_line_offset(&file, static_cast<size_t>(line)));
+}
+
+int MappedTextView::visibleLines() const
+{
+    return qMax(1, viewport()->height() / fontMetrics().height());
+}
+
+// 마지막 한 화면의 첫 줄: 파일 끝에서 화면 줄 수만큼 거꾸로 감
+void MappedTextView::updateLastTop()
+{
+    size_t offset = mapped_file_line_start(&file, file.size);
+    if (offset == file.size && offset > 0)
+        offset = mapped_file_prev_line(&file, offset);  // 마지막 개행 뒤의 빈 줄은 세지 않음
+    for (int i = 1; i < visibleLines() && offset > 0; i++)
+        offset = mapped_file_prev_line(&file, offset);
+    lastTop = offset;
+}
+
+void MappedTextView::setTop(size_t offset)
+{
+    top = qMin(offset, lastTop);
+    syncScrollBars();
+    viewport()->update();
+
+    size_t line = 0;
+    bool known = mapped_file_line_at(&file, top, &line) == 0;
+    emit positionChanged(top, file.size, known ? static_cast<qlonglong>(line) : -1);
+}
+
+void MappedTextView::scrollLines(int delta)
+{
+    size_t offset = top;
+    for (; delta > 0 && offset < lastTop; delta--)
+        offset = mapped_file_next_line(&file, offset);
+    for (; delta < 0 && offset > 0; delta++)
+        offset = mapped_file_prev_line(&file, offset);
+    setTop(offset);
+}
+
+void MappedTextView::syncScrollBars()
+{
+    syncing = true;
+
+    // 한 화면에 보이는 바이트 수를 페이지 크기로 사용
+    size_t end = top;
+    for (int i = 0; i < visibleLines() && end < file.size; i++)
+        end = mapped_file_next_line(&file, end);
+
+    QScrollBar *vbar = verticalScrollBar();
+    vbar->setRange(0, static_cast<int>(lastTop / scale));
+    vbar->setPageStep(qMax(1, static_cast<int>((end - top) / scale)));
+    vbar->setSingleStep(qMax(1, static_cast<int>((end - top) / scale / visibleLines())));
+    vbar->setValue(static_cast<int>(top / scale));
+
+    QScrollBar *hbar = horizontalScrollBar();
+    hbar->setRange(0, qMax(0, maxLineWidth - viewport()->width() + 8));
+    hbar->setPageStep(viewport()->width());
+    hbar->setSingleStep(fontMetrics().averageCharWidth() * 4);
+
+    syncing = false;
+}
+
+QString MappedTextView::lineText(size_t offset) const
+{
+    size_t length = qMin(mapped_file_line_length(&file, offset), MAX_RENDER_BYTES);
+    if (length > 0 && file.data[offset + length - 1] == '\r')
+        length--;
+    QString text = QString::fromUtf8(file.data + offset, static_cast<int>(length));
+    text.replace(QLatin1Char('\t'), QLatin1String("    "));
+    return text;
+}
+
+void MappedTextView::paintEvent(QPaintEvent *)
+{
+    if (!opened) return;
+    refreshFile();
+
+    QPainter painter(viewport());
+    painter.setFont(font());
+    QFontMetrics fm = fontMetrics();
+    int x = 4 - horizontalScrollBar()->value();
+    int y = fm.ascent();
+    int widest = maxLineWidth;
+
+    // 화면에 들어가는 줄만 mmap 영역에서 바로 읽어 그림
+    size_t offset = top;
+    for (int i = 0; i <= visibleLines() && offset < file.size; i++) {
+        QString text = lineText(offset);
+        painter.drawText(x, y, text);
+        widest = qMax(widest, fm.horizontalAdvance(text));
+        offset = mapped_file_next_line(&file, offset);
+        y += fm.height();
+    }
+
+    if (widest > maxLineWidth) {
+        maxLineWidth = widest;
+        QScrollBar *hbar = horizontalScrollBar();
+        hbar->setRange(0, qMax(0, maxLineWidth - viewport()->width() + 8));
+    }
+}
+
+void MappedTextView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateLastTop();
+    setTop(top);
+}
+
+void MappedTextView::keyPressEvent(QKeyEvent *event)
+{
+    switch (event->key()) {
+    case Qt::Key_Up:       scrollLines(-1); break;
+    case Qt::Key_Down:     scrollLines(1); break;
+    case Qt::Key_PageUp:   scrollLines(-qMax(1, visibleLines() - 1)); break;
+    case Qt::Key_PageDown: scrollLines(qMax(1, visibleLines() - 1)); break;
+    case Qt::Key_Home:     setTop(0); break;
+    case Qt::Key_End:      setTop(lastTop); break;
+    case Qt::Key_Left:
+        horizontalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+        break;
+    case Qt::Key_Right:
+        horizontalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+        break;
+    default:
+        QAbstractScrollArea::keyPressEvent(event);
+    }
+}
+
+void MappedTextView::wheelEvent(QWheelEvent *event)
+{
+    QPoint delta = event->angleDelta();
+    if (delta.y() != 0) {
+        // 한 칸(120)에 세 줄
+        int lines = -delta.y() / 40;
+        if (lines == 0) lines = delta.y() > 0 ? -1 : 1;
+        scrollLines(lines);
+    }
+    if (delta.x() != 0) {
+        QScrollBar *hbar = horizontalScrollBar();
+        hbar->setValue(hbar->value() - delta.x());
+    }
+    event->accept();
+}
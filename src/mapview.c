@@ -0,0 +1,231 @@
+#define _GNU_SOURCE
+#include "../include/mapview.h"
+#include "../include/mapguard.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 파일 전체를 매핑해도 실제로 읽히는 건 접근한 페이지뿐. 빈 파일이면 data = NULL
+static int map_data(struct mapped_file *mf, size_t size) {
+    mf->data = NULL;
+    mf->size = size;
+    mf->guard = -1;
+    if (size == 0) return 0;
+
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, mf->fd, 0);
+    if (data == MAP_FAILED) {
+        mf->size = 0;
+        return -1;
+    }
+    mf->data = data;
+    // 보호 슬롯이 모자라면 보호 없이 열림 (mapped_file_refresh의 fstat 검사만 남음)
+    mf->guard = map_guard_add(data, size);
+    return 0;
+}
+
+static void unmap_data(struct mapped_file *mf) {
+    if (mf->guard != -1)
+        map_guard_remove(mf->guard);
+    if (mf->data)
+        munmap((void *)mf->data, mf->size);
+    mf->data = NULL;
+    mf->size = 0;
+    mf->guard = -1;
+}
+
+static void reset_index(struct mapped_file *mf) {
+    mf->ncheckpoints = 1;
+    mf->scanned_lines = 0;
+    mf->scanned_offset = 0;
+    mf->capped = 0;
+    mf->complete = mf->size == 0;
+}
+
+int mapped_file_open(struct mapped_file *mf, const char *path) {
+    memset(mf, 0, sizeof(*mf));
+    mf->fd = -1;
+    mf->guard = -1;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        errno = S_ISDIR(st.st_mode) ? EISDIR : EINVAL;
+        return -1;
+    }
+
+    mf->checkpoints = malloc(16 * sizeof(size_t));
+    if (!mf->checkpoints) {
+        close(fd);
+        errno = ENOMEM;
+        return -1;
+    }
+    mf->checkpoints[0] = 0;
+    mf->ncheckpoints = 1;
+    mf->checkpoints_capacity = 16;
+
+    mf->fd = fd;
+    if (map_data(mf, (size_t)st.st_size) == -1) {
+        int err = errno;
+        free(mf->checkpoints);
+        close(fd);
+        mf->fd = -1;
+        errno = err;
+        return -1;
+    }
+    mf->complete = mf->size == 0;
+    return 0;
+}
+
+void mapped_file_close(struct mapped_file *mf) {
+    unmap_data(mf);
+    if (mf->fd != -1)
+        close(mf->fd);
+    free(mf->checkpoints);
+    memset(mf, 0, sizeof(*mf));
+    mf->fd = -1;
+    mf->guard = -1;
+}
+
+int mapped_file_refresh(struct mapped_file *mf) {
+    if (mf->fd == -1) return 0;
+
+    struct stat st;
+    if (fstat(mf->fd, &st) == -1) return -1;
+    size_t size = (size_t)st.st_size;
+    int faulted = map_guard_take_fault(mf->guard);
+    if (size == mf->size && !faulted) return 0;
+
+    // 줄었거나 잘린 페이지를 0으로 덮었다면 내용이 바뀐 것이므로 색인을 처음부터 다시 만듦
+    int shrunk = size < mf->size || faulted;
+    unmap_data(mf);
+    if (map_data(mf, size) == -1) {
+        int err = errno;
+        reset_index(mf);
+        errno = err;
+        return -1;
+    }
+    if (shrunk) {
+        reset_index(mf);
+    } else if (mf->complete) {
+        // 늘어난 경우: 마지막 줄이 이어졌을 수 있으므로 마지막 체크포인트부터 다시 훑음
+        mf->scanned_lines = (mf->ncheckpoints - 1) * MAPPED_LINE_STRIDE;
+        mf->scanned_offset = mf->checkpoints[mf->ncheckpoints - 1];
+        mf->complete = 0;
+    }
+    return 1;
+}
+
+size_t mapped_file_line_start(const struct mapped_file *mf, size_t offset) {
+    if (offset > mf->size) offset = mf->size;
+    if (offset == 0) return 0;
+    const char *nl = memrchr(mf->data, '\n', offset);
+    return nl ? (size_t)(nl - mf->data) + 1 : 0;
+}
+
+size_t mapped_file_next_line(const struct mapped_file *mf, size_t offset) {
+    if (offset >= mf->size) return mf->size;
+    const char *nl = memchr(mf->data + offset, '\n', mf->size - offset);
+    return nl ? (size_t)(nl - mf->data) + 1 : mf->size;
+}
+
+size_t mapped_file_prev_line(const struct mapped_file *mf, size_t offset) {
+    size_t start = mapped_file_line_start(mf, offset);
+    return start == 0 ? 0 : mapped_file_line_start(mf, start - 1);
+}
+
+size_t mapped_file_line_length(const struct mapped_file *mf, size_t offset) {
+    if (offset >= mf->size) return 0;
+    const char *nl = memchr(mf->data + offset, '\n', mf->size - offset);
+    return (size_t)((nl ? nl : mf->data + mf->size) - (mf->data + offset));
+}
+
+// line번째 줄을 넘어설 때까지 (또는 파일 끝까지) 색인을 늘림
+static void extend_index(struct mapped_file *mf, size_t line) {
+    while (!mf->complete && mf->scanned_lines <= line) {
+        const char *nl = NULL;
+        if (mf->scanned_offset < mf->size)
+            nl = memchr(mf->data + mf->scanned_offset, '\n', mf->size - mf->scanned_offset);
+        if (!nl) {
+            // 개행으로 끝나지 않는 마지막 줄
+            if (mf->scanned_offset < mf->size) {
+                mf->scanned_lines++;
+                mf->scanned_offset = mf->size;
+            }
+            mf->complete = 1;
+            break;
+        }
+
+        mf->scanned_offset = (size_t)(nl - mf->data) + 1;
+        mf->scanned_lines++;
+        if (mf->scanned_lines % MAPPED_LINE_STRIDE == 0 && !mf->capped) {
+            if (mf->ncheckpoints == mf->checkpoints_capacity) {
+                size_t new_capacity = mf->checkpoints_capacity * 2;
+                size_t *grown = realloc(mf->checkpoints, new_capacity * sizeof(size_t));
+                if (!grown) {
+                    // checkpoints[k]가 k * STRIDE번째 줄이어야 하므로 하나를 건너뛰면 뒤가 모두 어긋남.
+                    // 여기서 기록을 멈추고 뒤쪽 줄은 마지막 체크포인트부터 memchr로 걸어감
+                    mf->capped = 1;
+                    continue;
+                }
+                mf->checkpoints = grown;
+                mf->checkpoints_capacity = new_capacity;
+            }
+            mf->checkpoints[mf->ncheckpoints++] = mf->scanned_offset;
+        }
+    }
+}
+
+size_t mapped_file_line_offset(struct mapped_file *mf, size_t line) {
+    extend_index(mf, line);
+    if (line >= mf->scanned_lines)
+        return line == mf->scanned_lines ? mf->scanned_offset : mf->size;
+
+    size_t k = line / MAPPED_LINE_STRIDE;
+    if (k >= mf->ncheckpoints) k = mf->ncheckpoints - 1;
+    size_t offset = mf->checkpoints[k];
+    for (size_t i = k * MAPPED_LINE_STRIDE; i < line; i++)
+        offset = mapped_file_next_line(mf, offset);
+    return offset;
+}
+
+int mapped_file_line_at(const struct mapped_file *mf, size_t offset, size_t *line) {
+    if (offset > mf->size) offset = mf->size;
+    if (!mf->complete && offset > mf->scanned_offset) return -1;
+
+    // offset 이하인 마지막 체크포인트를 이분 탐색
+    size_t lo = 0, hi = mf->ncheckpoints;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (mf->checkpoints[mid] <= offset) lo = mid;
+        else hi = mid;
+    }
+
+    size_t count = lo * MAPPED_LINE_STRIDE;
+    size_t pos = mf->checkpoints[lo];
+    while (pos < offset) {
+        const char *nl = memchr(mf->data + pos, '\n', offset - pos);
+        if (!nl) break;
+        count++;
+        pos = (size_t)(nl - mf->data) + 1;
+    }
+    *line = count;
+    return 0;
+}
+
+size_t mapped_file_line_count(struct mapped_file *mf) {
+    extend_index(mf, (size_t)-2);
+    return mf->scanned_lines;
+}
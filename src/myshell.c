@@ -0,0 +1,39 @@
+#include "../include/commands.h"
+#include "../include/shell.h"
+#include "../include/config.h"
+#include <signal.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+// Qt 없이 쉘만 띄우는 진입점. libfsops만 링크하므로 디스플레이가 없는 곳에서도 실행됨.
+// 인자가 없으면 대화형, -c/스크립트가 있으면 배치로 실행 (shell_batch_main 참고)
+int main(int argc, char **argv) {
+    int batch_status = shell_batch_main(argc, argv);
+    if (batch_status != SHELL_NOT_BATCH) return batch_status;
+    if (argc > 1) {
+        fprintf(stderr, "알 수 없는 옵션: %s\n", argv[1]);
+        fprintf(stderr, "사용법: %s [-t] [-s] [-e] [-c \"명령\" | 스크립트.fsh | -]\n", argv[0]);
+        return SHELL_SYNTAX_ERROR;
+    }
+
+    mkdir(BASE_DIR, DEFAULT_DIR_MODE);
+
+    if (ENABLE_CHROOT) {
+        if (setup_chroot(BASE_DIR) != 0) {
+            fprintf(stderr, "Failed to setup chroot environment\n");
+            return 1;
+        }
+    }
+
+    if (ENABLE_SIGNALS) {
+        struct sigaction sa;
+
+        sa.sa_handler = handle_sigint;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = 0;
+        sigaction(SIGINT, &sa, NULL);
+    }
+
+    run_terminal();
+    return 0;
+}
@@ -0,0 +1,278 @@
+#define _GNU_SOURCE
+#include "../include/pidsig.h"
+#include "../include/procscan.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc 2.36 전에는 래퍼가 없으므로 시스템 콜 번호로 직접 호출
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+// pidfd가 없는 프로세스가 있으면 /proc/<pid>/stat으로 종료를 확인하는 간격
+#define PID_FALLBACK_POLL_MS 50
+
+static const struct {
+    int sig;
+    const char *name;
+} signal_names[] = {
+    { SIGHUP, "HUP" }, { SIGINT, "INT" }, { SIGQUIT, "QUIT" }, { SIGILL, "ILL" },
+    { SIGTRAP, "TRAP" }, { SIGABRT, "ABRT" }, { SIGBUS, "BUS" }, { SIGFPE, "FPE" },
+    { SIGKILL, "KILL" }, { SIGUSR1, "USR1" }, { SIGSEGV, "SEGV" }, { SIGUSR2, "USR2" },
+    { SIGPIPE, "PIPE" }, { SIGALRM, "ALRM" }, { SIGTERM, "TERM" }, { SIGCHLD, "CHLD" },
+    { SIGCONT, "CONT" }, { SIGSTOP, "STOP" }, { SIGTSTP, "TSTP" }, { SIGTTIN, "TTIN" },
+    { SIGTTOU, "TTOU" }, { SIGURG, "URG" }, { SIGXCPU, "XCPU" }, { SIGXFSZ, "XFSZ" },
+    { SIGVTALRM, "VTALRM" }, { SIGPROF, "PROF" }, { SIGWINCH, "WINCH" }, { SIGIO, "IO" },
+    { SIGSYS, "SYS" },
+};
+
+int signal_parse(const char *text) {
+    if (!text || !*text) return -1;
+    if (text[0] >= '0' && text[0] <= '9') {
+        char *end;
+        long sig = strtol(text, &end, 10);
+        return *end == '\0' && sig >= 0 && sig < NSIG ? (int)sig : -1;
+    }
+    if (strncasecmp(text, "SIG", 3) == 0)
+        text += 3;
+    for (size_t i = 0; i < sizeof(signal_names) / sizeof(signal_names[0]); i++) {
+        if (strcasecmp(text, signal_names[i].name) == 0)
+            return signal_names[i].sig;
+    }
+    return -1;
+}
+
+const char *signal_name(int sig) {
+    for (size_t i = 0; i < sizeof(signal_names) / sizeof(signal_names[0]); i++) {
+        if (signal_names[i].sig == sig)
+            return signal_names[i].name;
+    }
+    return NULL;
+}
+
+// /proc/<pid>/stat을 다시 읽음. 없으면 -1 (errno = ESRCH)
+static int read_stat(pid_t pid, struct proc_info *info) {
+    char path[32], buf[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        errno = ESRCH;
+        return -1;
+    }
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (len <= 0 || proc_parse_stat(buf, (size_t)len, info, 4) == -1) {
+        errno = ESRCH;
+        return -1;
+    }
+    return 0;
+}
+
+void pid_target_init(struct pid_target *t, pid_t pid, unsigned long long starttime) {
+    t->pid = pid;
+    t->starttime = starttime;
+    t->pidfd = -1;
+    t->state = PID_TARGET_PENDING;
+    t->error = 0;
+}
+
+static int target_fail(struct pid_target *t, int err) {
+    pid_target_close(t);
+    t->state = PID_TARGET_FAILED;
+    t->error = err;
+    errno = err;
+    return -1;
+}
+
+int pid_target_open(struct pid_target *t) {
+    if (t->state != PID_TARGET_PENDING)
+        return t->state == PID_TARGET_ALIVE ? 0 : -1;
+    if (t->pid <= 0)
+        return target_fail(t, EINVAL);
+
+    t->pidfd = (int)syscall(SYS_pidfd_open, t->pid, 0);
+    if (t->pidfd == -1 && errno != ENOSYS)
+        return target_fail(t, errno);
+
+    // pidfd를 연 뒤에도 같은 시작 시각이면 pidfd는 목록에서 본 그 프로세스를 가리킴
+    // (pidfd가 없으면 확인과 kill() 사이에 짧은 틈이 남음)
+    if (t->starttime) {
+        struct proc_info info;
+        if (read_stat(t->pid, &info) == -1 || info.starttime != t->starttime)
+            return target_fail(t, ESRCH);
+    }
+    t->state = PID_TARGET_ALIVE;
+    return 0;
+}
+
+int pid_target_signal(struct pid_target *t, int sig) {
+    if (pid_target_open(t) == -1)
+        return -1;
+
+    int rc = t->pidfd != -1 ? (int)syscall(SYS_pidfd_send_signal, t->pidfd, sig, NULL, 0)
+                            : kill(t->pid, sig);
+    if (rc == -1) {
+        int err = errno;
+        if (err == ESRCH) {
+            // 열어 둔 사이에 끝남
+            pid_target_close(t);
+            t->state = PID_TARGET_EXITED;
+            t->error = err;
+            errno = err;
+            return -1;
+        }
+        return target_fail(t, err);
+    }
+    return 0;
+}
+
+int pid_target_poll(struct pid_target *t) {
+    if (t->state != PID_TARGET_ALIVE)
+        return t->state == PID_TARGET_EXITED;
+
+    int exited;
+    if (t->pidfd != -1) {
+        struct pollfd pfd = { t->pidfd, POLLIN, 0 };
+        exited = poll(&pfd, 1, 0) > 0;
+    } else {
+        // 좀비도 끝난 것으로 봄. 시작 시각이 바뀌었으면 pid가 재사용된 것
+        struct proc_info info;
+        exited = read_stat(t->pid, &info) == -1 || info.state == 'Z' ||
+                 (t->starttime && info.starttime != t->starttime);
+    }
+    if (exited) {
+        pid_target_close(t);
+        t->state = PID_TARGET_EXITED;
+    }
+    return exited;
+}
+
+void pid_target_close(struct pid_target *t) {
+    if (t->pidfd != -1) {
+        close(t->pidfd);
+        t->pidfd = -1;
+    }
+}
+
+size_t pid_batch_signal(struct pid_target *targets, size_t n, int sig) {
+    size_t sent = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (pid_target_signal(&targets[i], sig) == 0)
+            sent++;
+    }
+    return sent;
+}
+
+static long long now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+size_t pid_batch_wait(struct pid_target *targets, size_t n, int timeout_ms) {
+    struct pollfd *pfds = malloc((n ? n : 1) * sizeof(*pfds));
+    size_t *which = malloc((n ? n : 1) * sizeof(*which));
+    long long deadline = timeout_ms >= 0 ? now_ms() + timeout_ms : -1;
+
+    for (;;) {
+        size_t npfd = 0, alive = 0;
+        int fallback = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (targets[i].state != PID_TARGET_ALIVE) continue;
+            if (targets[i].pidfd == -1 || !pfds || !which) {
+                // pidfd가 없거나 배열을 못 만들었으면 하나씩 확인
+                if (pid_target_poll(&targets[i])) continue;
+                fallback = 1;
+            } else {
+                pfds[npfd].fd = targets[i].pidfd;
+                pfds[npfd].events = POLLIN;
+                pfds[npfd].revents = 0;
+                which[npfd++] = i;
+            }
+            alive++;
+        }
+        if (alive == 0) break;
+
+        // 시간이 다 됐어도 한 번은 기다리지 않고 확인 (timeout_ms = 0이면 확인만)
+        int wait_ms = -1, last = 0;
+        if (deadline >= 0) {
+            long long left = deadline - now_ms();
+            last = left <= 0;
+            wait_ms = last ? 0 : left > INT_MAX ? INT_MAX : (int)left;
+        }
+        if (fallback && (wait_ms < 0 || wait_ms > PID_FALLBACK_POLL_MS))
+            wait_ms = PID_FALLBACK_POLL_MS;
+
+        int ready = poll(npfd ? pfds : NULL, npfd, wait_ms);
+        if (ready == -1 && errno != EINTR) break;
+        for (size_t k = 0; ready > 0 && k < npfd; k++) {
+            if (pfds[k].revents) {
+                pid_target_close(&targets[which[k]]);
+                targets[which[k]].state = PID_TARGET_EXITED;
+            }
+        }
+        if (last) break;
+    }
+    free(pfds);
+    free(which);
+
+    size_t alive = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (targets[i].state == PID_TARGET_ALIVE) alive++;
+    }
+    return alive;
+}
+
+void pid_batch_close(struct pid_target *targets, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        pid_target_close(&targets[i]);
+}
+
+int proc_pattern_compile(struct proc_pattern *p, const char *pattern, int flags,
+                         char *err, size_t errsize) {
+    int cflags = REG_EXTENDED | REG_NOSUB;
+    if (flags & PROC_MATCH_ICASE) cflags |= REG_ICASE;
+    p->flags = flags;
+
+    char *anchored = NULL;
+    if (flags & PROC_MATCH_EXACT) {
+        size_t len = strlen(pattern);
+        anchored = malloc(len + 5);
+        if (!anchored) {
+            if (err && errsize) snprintf(err, errsize, "%s", strerror(ENOMEM));
+            return -1;
+        }
+        snprintf(anchored, len + 5, "^(%s)$", pattern);
+        pattern = anchored;
+    }
+
+    int rc = regcomp(&p->re, pattern, cflags);
+    free(anchored);
+    if (rc != 0) {
+        if (err && errsize) regerror(rc, &p->re, err, errsize);
+        return -1;
+    }
+    return 0;
+}
+
+int proc_pattern_match(const struct proc_pattern *p, const char *comm, const char *cmdline) {
+    const char *text = (p->flags & PROC_MATCH_FULL) && cmdline ? cmdline : comm;
+    return text && regexec(&p->re, text, 0, NULL, 0) == 0;
+}
+
+void proc_pattern_free(struct proc_pattern *p) {
+    regfree(&p->re);
+}
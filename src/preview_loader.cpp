@@ -0,0 +1,132 @@
+#include "../include/preview_loader.h"
+#include "../include/utils.h"
+#include "../include/dirscan.h"
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QStringList>
+#include <functional>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+class PreviewTask : public QRunnable {
+public:
+    explicit PreviewTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+}  // namespace
+
+PreviewLoader::PreviewLoader(QObject *parent) : QObject(parent), cache(CACHE_ENTRIES)
+{
+    // 디스크가 느릴 때 요청이 몰려도 I/O가 서로 밀어내지 않도록 작게 유지
+    pool.setMaxThreadCount(2);
+}
+
+PreviewLoader::~PreviewLoader()
+{
+    cancel();
+    pool.waitForDone();
+}
+
+void PreviewLoader::request(const QString &path)
+{
+    qulonglong gen = ++generation;
+    // 아직 시작하지 않은 이전 요청은 큐에서 바로 제거
+    pool.clear();
+    pool.start(new PreviewTask([this, gen, path]() { run(gen, path); }));
+}
+
+void PreviewLoader::cancel()
+{
+    ++generation;
+    pool.clear();
+}
+
+void PreviewLoader::run(qulonglong gen, const QString &path)
+{
+    if (stale(gen)) return;
+
+    QByteArray localPath = path.toLocal8Bit();
+    struct stat st;
+    if (stat(localPath.constData(), &st) == -1) {
+        if (!stale(gen))
+            emit previewReady(gen, tr("파일을 열 수 없습니다."), -1, QDateTime());
+        return;
+    }
+
+    PreviewKey key = { static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino),
+                       static_cast<qint64>(st.st_mtim.tv_sec),
+                       static_cast<qint64>(st.st_mtim.tv_nsec) };
+    {
+        QMutexLocker locker(&cacheLock);
+        if (Entry *hit = cache.object(key)) {
+            Entry entry = *hit;
+            locker.unlock();
+            if (!stale(gen))
+                emit previewReady(gen, entry.text, entry.size, entry.modified);
+            return;
+        }
+    }
+
+    Entry *entry = new Entry;
+    entry->size = static_cast<qint64>(st.st_size);
+    entry->modified = QDateTime::fromSecsSinceEpoch(st.st_mtime);
+
+    if (S_ISREG(st.st_mode)) {
+        int fd = open(localPath.constData(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            delete entry;
+            if (!stale(gen))
+                emit previewReady(gen, tr("파일을 열 수 없습니다."), st.st_size,
+                                  QDateTime::fromSecsSinceEpoch(st.st_mtime));
+            return;
+        }
+        char buf[PREVIEW_BYTES];
+        ssize_t n = pread(fd, buf, sizeof(buf), 0);
+        close(fd);
+        if (n < 0) n = 0;
+
+        if (!buffer_looks_binary(buf, static_cast<size_t>(n)) && st.st_size < 1024 * 1024) {
+            entry->text = QString::fromLocal8Bit(buf, static_cast<int>(n));
+        } else {
+            entry->text = tr("바이너리 파일은 미리보기를 지원하지 않습니다.");
+        }
+    } else if (S_ISDIR(st.st_mode)) {
+        QStringList entries;
+        struct dir_listing listing;
+        if (dir_listing_open(&listing, localPath.constData(), DIRSCAN_SKIP_DOTS) == 0) {
+            entries.reserve(static_cast<int>(listing.count));
+            for (size_t i = 0; i < listing.count; ++i) {
+                // 큰 디렉토리에서도 새 요청이 오면 바로 멈춤
+                if ((i & 1023) == 0 && stale(gen)) break;
+                entries << QString::fromLocal8Bit(dir_entry_name(&listing, &listing.entries[i]));
+            }
+            dir_listing_free(&listing);
+        }
+        if (stale(gen)) {
+            delete entry;
+            return;
+        }
+        entries.sort(Qt::CaseInsensitive);
+        int total = entries.size();
+        if (total > MAX_DIR_ENTRIES) {
+            entries.erase(entries.begin() + MAX_DIR_ENTRIES, entries.end());
+            entries << tr("... 외 %1개").arg(total - MAX_DIR_ENTRIES);
+        }
+        entry->text = tr("디렉토리 내용:\n\n") + entries.join("\n");
+    }
+
+    Entry result = *entry;
+    {
+        QMutexLocker locker(&cacheLock);
+        cache.insert(key, entry);
+    }
+    if (!stale(gen))
+        emit previewReady(gen, result.text, result.size, result.modified);
+}
@@ -0,0 +1,144 @@
+#include "../include/process_monitor.h"
+#include <QRunnable>
+#include <functional>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+class ScanTask : public QRunnable {
+public:
+    explicit ScanTask(std::function<void()> fn) : fn(std::move(fn)) {}
+    void run() override { fn(); }
+
+private:
+    std::function<void()> fn;
+};
+
+}  // namespace
+
+ProcessMonitor::ProcessMonitor(QObject *parent) : QObject(parent)
+{
+    // 이전 표본(history)을 순서대로 갱신해야 하므로 한 스레드
+    pool.setMaxThreadCount(1);
+    connect(&timer, &QTimer::timeout, this, [this]() { refresh(); });
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+    timer.stop();
+    pool.waitForDone();
+    proc_scanner_free(scanner);
+    free(buffer);
+}
+
+void ProcessMonitor::start(int intervalMs)
+{
+    timer.start(intervalMs);
+    refresh();
+}
+
+void ProcessMonitor::stop()
+{
+    timer.stop();
+}
+
+void ProcessMonitor::refresh()
+{
+    if (busy) return;
+    busy = true;
+    pool.start(new ScanTask([this]() { scan(); }));
+}
+
+void ProcessMonitor::scan()
+{
+    if (!scanner && !(scanner = proc_scanner_create())) {
+        QString message = tr("/proc을 열 수 없습니다: %1").arg(QString::fromLocal8Bit(strerror(errno)));
+        QMetaObject::invokeMethod(this, [this, message]() {
+            busy = false;
+            emit scanFailed(message);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    auto sample = std::make_shared<Sample>();
+    size_t count = 0;
+    if (proc_scan(scanner, PROC_SCAN_ALL, &buffer, &count, &capacity, &sample->metrics) == -1) {
+        QString message = tr("프로세스 목록을 읽을 수 없습니다: %1").arg(QString::fromLocal8Bit(strerror(errno)));
+        QMetaObject::invokeMethod(this, [this, message]() {
+            busy = false;
+            emit scanFailed(message);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    // CPU%는 두 표본 사이 벽시계 시간에 대한 CPU 시간 비율
+    static const double clockTicks = sysconf(_SC_CLK_TCK) > 0 ? sysconf(_SC_CLK_TCK) : 100;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    qint64 now = static_cast<qint64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    double seconds = lastScanNs ? (now - lastScanNs) / 1e9 : 0;
+    sample->intervalMs = seconds * 1000;
+    lastScanNs = now;
+
+    int n = static_cast<int>(count);
+    sample->pid.resize(n);
+    sample->ppid.resize(n);
+    sample->uid.resize(n);
+    sample->state.resize(n);
+    sample->tty.resize(n);
+    sample->cpu.resize(n);
+    sample->rss.resize(n);
+    sample->vsz.resize(n);
+    sample->cpuTicks.resize(n);
+    sample->starttime.resize(n);
+    sample->commandOffset.resize(n);
+    sample->commands.reserve(n * 48);
+
+    QHash<pid_t, History> next;
+    next.reserve(n);
+    for (int i = 0; i < n; i++) {
+        struct proc_info &info = buffer[i];
+        unsigned long long ticks = info.utime + info.stime;
+        float cpu = 0;
+        QByteArray command;
+
+        auto it = history.constFind(info.pid);
+        if (it != history.constEnd() && it->starttime == info.starttime) {
+            // 이미 본 프로세스: cmdline은 다시 읽지 않음
+            unsigned long long delta = ticks >= it->ticks ? ticks - it->ticks : 0;
+            cpu = seconds > 0 ? static_cast<float>(delta / clockTicks / seconds * 100.0) : 0;
+            command = it->cmdline;
+        } else {
+            proc_read_cmdline(scanner, info.pid, info.comm, info.cmdline, sizeof(info.cmdline));
+            command = QByteArray(info.cmdline);
+        }
+        next.insert(info.pid, { info.starttime, ticks, command });
+
+        sample->pid[i] = info.pid;
+        sample->ppid[i] = info.ppid;
+        sample->uid[i] = info.uid;
+        sample->state[i] = info.state;
+        sample->tty[i] = info.tty_nr;
+        sample->cpu[i] = cpu;
+        sample->rss[i] = static_cast<quint32>(info.rss);
+        sample->vsz[i] = info.vsz;
+        sample->cpuTicks[i] = ticks;
+        sample->starttime[i] = info.starttime;
+        sample->commandOffset[i] = static_cast<quint32>(sample->commands.size());
+        sample->commands.append(command);
+        sample->commands.append('\0');
+        sample->totalCpu += cpu;
+    }
+    history.swap(next);
+
+    std::shared_ptr<const Sample> result = sample;
+    QMetaObject::invokeMethod(this, [this, result]() {
+        busy = false;
+        current = result;
+        emit sampleReady();
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,430 @@
+#include "../include/process_table_model.h"
+#include "../include/procscan.h"
+#include "../include/du.h"
+#include <QMap>
+#include <algorithm>
+#include <numeric>
+#include <pwd.h>
+#include <string.h>
+#include <unistd.h>
+
+ProcessTableModel::ProcessTableModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+QString ProcessTableModel::userName(uid_t uid) const
+{
+    auto it = users.constFind(uid);
+    if (it != users.constEnd()) return *it;
+
+    struct passwd pw, *result = nullptr;
+    char buf[1024];
+    QString name = getpwuid_r(uid, &pw, buf, sizeof(buf), &result) == 0 && result
+                   ? QString::fromLocal8Bit(result->pw_name) : QString::number(uid);
+    users.insert(uid, name);
+    return name;
+}
+
+int ProcessTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : order.size();
+}
+
+int ProcessTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || !current) return QVariant();
+    int i = order[index.row()];
+    const ProcessMonitor::Sample &s = *current;
+
+    if (role == Qt::TextAlignmentRole) {
+        bool numeric = index.column() == Pid || index.column() == Cpu ||
+                       index.column() == Rss || index.column() == Time;
+        return numeric ? QVariant(Qt::AlignRight | Qt::AlignVCenter) : QVariant();
+    }
+    if (role != Qt::DisplayRole) return QVariant();
+
+    switch (index.column()) {
+    case Pid:
+        return static_cast<int>(s.pid[i]);
+    case User:
+        return userName(s.uid[i]);
+    case Cpu:
+        return QString::number(s.cpu[i], 'f', 1);
+    case Rss:
+        return s.rss[i];
+    case State:
+        return QString(QChar::fromLatin1(s.state[i]));
+    case Tty: {
+        char tty[16];
+        proc_format_tty(s.tty[i], tty, sizeof(tty));
+        return QString::fromLatin1(tty);
+    }
+    case Time: {
+        static const quint64 clockTicks = sysconf(_SC_CLK_TCK) > 0 ? sysconf(_SC_CLK_TCK) : 100;
+        quint64 seconds = s.cpuTicks[i] / clockTicks;
+        return QString::asprintf("%02llu:%02llu:%02llu", seconds / 3600, seconds / 60 % 60, seconds % 60);
+    }
+    case Command:
+        return QString::fromLocal8Bit(s.command(i));
+    }
+    return QVariant();
+}
+
+QVariant ProcessTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+    switch (section) {
+    case Pid: return QStringLiteral("PID");
+    case User: return tr("사용자");
+    case Cpu: return QStringLiteral("CPU%");
+    case Rss: return QStringLiteral("RSS(KB)");
+    case State: return tr("상태");
+    case Tty: return QStringLiteral("TTY");
+    case Time: return QStringLiteral("TIME");
+    case Command: return QStringLiteral("CMD");
+    }
+    return QVariant();
+}
+
+void ProcessTableModel::setSample(std::shared_ptr<const ProcessMonitor::Sample> sample)
+{
+    relayout(std::move(sample));
+}
+
+void ProcessTableModel::sort(int column, Qt::SortOrder direction)
+{
+    sortColumn = column;
+    sortOrder = direction;
+    relayout(current);
+}
+
+// 표본 교체와 재정렬은 행 수가 바뀌더라도 layoutChanged 하나로 알림.
+// 뷰의 선택/현재 항목(영구 인덱스)은 같은 프로세스(pid + 시작 시각)의 새 행으로 옮김
+void ProcessTableModel::relayout(std::shared_ptr<const ProcessMonitor::Sample> next)
+{
+    emit layoutAboutToBeChanged();
+
+    const QModelIndexList from = persistentIndexList();
+    QVector<QPair<pid_t, quint64>> keys;
+    keys.reserve(from.size());
+    for (const QModelIndex &index : from) {
+        int i = order[index.row()];
+        keys.append({ current->pid[i], current->starttime[i] });
+    }
+
+    current = std::move(next);
+    order.resize(current ? current->size() : 0);
+    std::iota(order.begin(), order.end(), 0);
+    sortRows();
+
+    if (!from.isEmpty()) {
+        QHash<pid_t, int> rowOf;
+        rowOf.reserve(order.size());
+        for (int row = 0; row < order.size(); ++row)
+            rowOf.insert(current->pid[order[row]], row);
+
+        QModelIndexList to;
+        to.reserve(from.size());
+        for (int k = 0; k < from.size(); ++k) {
+            int row = rowOf.value(keys[k].first, -1);
+            bool same = row != -1 && current->starttime[order[row]] == keys[k].second;
+            to.append(same ? index(row, from[k].column()) : QModelIndex());
+        }
+        changePersistentIndexList(from, to);
+    }
+
+    emit layoutChanged();
+}
+
+// 표시 문자열이 아니라 열 배열의 값으로 비교하므로 2만 행도 몇 ms 안에 정렬됨
+void ProcessTableModel::sortRows()
+{
+    if (!current || sortColumn < 0) return;
+    const ProcessMonitor::Sample &s = *current;
+    bool ascending = sortOrder == Qt::AscendingOrder;
+
+    auto sortBy = [this, ascending](auto key) {
+        std::stable_sort(order.begin(), order.end(), [&key, ascending](int a, int b) {
+            return ascending ? key(a) < key(b) : key(b) < key(a);
+        });
+    };
+
+    switch (sortColumn) {
+    case Pid:
+        sortBy([&s](int i) { return s.pid[i]; });
+        break;
+    case User: {
+        // uid마다 이름 순위를 한 번만 매기고 순위(정수)로 정렬
+        QMap<QString, uid_t> byName;
+        for (uid_t uid : s.uid)
+            byName.insert(userName(uid), uid);
+        QHash<uid_t, int> rank;
+        int next = 0;
+        for (auto it = byName.constBegin(); it != byName.constEnd(); ++it)
+            rank.insert(it.value(), next++);
+        QVector<int> keys(s.size());
+        for (int i = 0; i < s.size(); ++i)
+            keys[i] = rank.value(s.uid[i]);
+        sortBy([&keys](int i) { return keys[i]; });
+        break;
+    }
+    case Cpu:
+        sortBy([&s](int i) { return s.cpu[i]; });
+        break;
+    case Rss:
+        sortBy([&s](int i) { return s.rss[i]; });
+        break;
+    case State:
+        sortBy([&s](int i) { return s.state[i]; });
+        break;
+    case Tty:
+        sortBy([&s](int i) { return s.tty[i]; });
+        break;
+    case Time:
+        sortBy([&s](int i) { return s.cpuTicks[i]; });
+        break;
+    case Command:
+        std::stable_sort(order.begin(), order.end(), [&s, ascending](int a, int b) {
+            int cmp = strcmp(s.command(a), s.command(b));
+            return ascending ? cmp < 0 : cmp > 0;
+        });
+        break;
+    }
+}
+
+ProcessFilterProxy::ProcessFilterProxy(QObject *parent) : QSortFilterProxyModel(parent) {}
+
+void ProcessFilterProxy::setPidFilter(pid_t value)
+{
+    pid = value;
+    invalidateFilter();
+}
+
+void ProcessFilterProxy::setUserFilter(const QString &name)
+{
+    userSet = !name.isEmpty();
+    if (userSet) {
+        // 이름이 아니면 uid 숫자로 봄, 둘 다 아니면 아무것도 맞지 않음
+        struct passwd pw, *result = nullptr;
+        char buf[1024];
+        bool numeric = false;
+        uid_t value = name.toUInt(&numeric);
+        if (getpwnam_r(name.toLocal8Bit().constData(), &pw, buf, sizeof(buf), &result) == 0 && result)
+            uid = result->pw_uid;
+        else
+            uid = numeric ? value : static_cast<uid_t>(-1);
+    }
+    invalidateFilter();
+}
+
+void ProcessFilterProxy::setStateFilter(char value)
+{
+    state = value;
+    invalidateFilter();
+}
+
+void ProcessFilterProxy::setMinRss(quint32 kb)
+{
+    minRss = kb;
+    invalidateFilter();
+}
+
+void ProcessFilterProxy::setCommandFilter(const QString &text)
+{
+    command = text.toLocal8Bit();
+    invalidateFilter();
+}
+
+void ProcessFilterProxy::sort(int column, Qt::SortOrder order)
+{
+    // 원본 모델이 배열로 정렬하고, 프록시는 원본 순서를 그대로 유지
+    if (sourceModel())
+        sourceModel()->sort(column, order);
+}
+
+bool ProcessFilterProxy::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+    const ProcessTableModel *model = static_cast<const ProcessTableModel *>(sourceModel());
+    const ProcessMonitor::Sample *s = model->sample();
+    if (!s) return false;
+    int i = model->sampleRow(sourceRow);
+
+    if (pid && s->pid[i] != pid) return false;
+    if (userSet && s->uid[i] != uid) return false;
+    if (state && s->state[i] != state) return false;
+    if (s->rss[i] < minRss) return false;
+    if (!command.isEmpty() && !strcasestr(s->command(i), command.constData())) return false;
+    return true;
+}
+
+ProcessTreeModel::ProcessTreeModel(QObject *parent) : QAbstractItemModel(parent) {}
+
+ProcessTreeModel::~ProcessTreeModel()
+{
+    proc_tree_free(&tree);
+}
+
+void ProcessTreeModel::setSample(std::shared_ptr<const ProcessMonitor::Sample> sample)
+{
+    emit layoutAboutToBeChanged();
+
+    const QModelIndexList from = persistentIndexList();
+    QVector<QPair<pid_t, quint64>> keys;
+    keys.reserve(from.size());
+    for (const QModelIndex &index : from) {
+        int i = sampleRow(index);
+        keys.append({ current->pid[i], current->starttime[i] });
+    }
+
+    // 새 트리를 만들지 못하면 (메모리 부족) 빈 트리로 둠
+    proc_tree_free(&tree);
+    current = std::move(sample);
+    int n = current->size();
+    if (proc_tree_build(current->pid.constData(), current->ppid.constData(),
+                        static_cast<size_t>(n), &tree) == -1) {
+        proc_tree_free(&tree);
+        n = 0;
+    }
+
+    cpuSum.resize(n);
+    rssSum.resize(n);
+    vszSum.resize(n);
+    for (int i = 0; i < n; ++i) {
+        cpuSum[i] = current->cpu[i];
+        rssSum[i] = current->rss[i];
+        vszSum[i] = current->vsz[i];
+    }
+    if (n > 0) {
+        proc_tree_sum(&tree, cpuSum.constData(), cpuSum.data());
+        proc_tree_sum(&tree, rssSum.constData(), rssSum.data());
+        proc_tree_sum(&tree, vszSum.constData(), vszSum.data());
+    }
+
+    if (!from.isEmpty()) {
+        QHash<pid_t, int> nodeOf;
+        nodeOf.reserve(n);
+        for (int i = 0; i < n; ++i)
+            nodeOf.insert(current->pid[i], i);
+
+        QModelIndexList to;
+        to.reserve(from.size());
+        for (int k = 0; k < from.size(); ++k) {
+            int node = nodeOf.value(keys[k].first, -1);
+            bool same = node != -1 && current->starttime[node] == keys[k].second;
+            to.append(same ? createIndex(static_cast<int>(tree.position[node]), from[k].column(),
+                                         static_cast<quintptr>(node))
+                           : QModelIndex());
+        }
+        changePersistentIndexList(from, to);
+    }
+
+    emit layoutChanged();
+}
+
+QVector<int> ProcessTreeModel::subtreeRows(const QModelIndex &index) const
+{
+    QVector<int> rows;
+    if (!index.isValid()) return rows;
+
+    // 전위 순서에서 하위 트리는 연속 구간
+    size_t node = static_cast<size_t>(sampleRow(index));
+    size_t start = tree.preorder_pos[node];
+    rows.reserve(static_cast<int>(tree.subtree_size[node]));
+    for (size_t k = start; k < start + tree.subtree_size[node]; ++k)
+        rows.append(static_cast<int>(tree.preorder[k]));
+    return rows;
+}
+
+QModelIndex ProcessTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (row < 0 || column < 0 || column >= ColumnCount) return QModelIndex();
+
+    size_t node;
+    if (!parent.isValid()) {
+        if (static_cast<size_t>(row) >= tree.nroots) return QModelIndex();
+        node = tree.roots[row];
+    } else {
+        size_t p = static_cast<size_t>(sampleRow(parent));
+        size_t first = tree.child_start[p];
+        if (first + static_cast<size_t>(row) >= tree.child_start[p + 1]) return QModelIndex();
+        node = tree.children[first + row];
+    }
+    return createIndex(row, column, static_cast<quintptr>(node));
+}
+
+QModelIndex ProcessTreeModel::parent(const QModelIndex &child) const
+{
+    if (!child.isValid()) return QModelIndex();
+    size_t p = tree.parent[sampleRow(child)];
+    if (p == PROC_TREE_NONE) return QModelIndex();
+    return createIndex(static_cast<int>(tree.position[p]), 0, static_cast<quintptr>(p));
+}
+
+int ProcessTreeModel::rowCount(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) return static_cast<int>(tree.nroots);
+    if (parent.column() != 0) return 0;
+    size_t p = static_cast<size_t>(sampleRow(parent));
+    return static_cast<int>(tree.child_start[p + 1] - tree.child_start[p]);
+}
+
+int ProcessTreeModel::columnCount(const QModelIndex &) const
+{
+    return ColumnCount;
+}
+
+QVariant ProcessTreeModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || !current) return QVariant();
+    int i = sampleRow(index);
+    const ProcessMonitor::Sample &s = *current;
+
+    if (role == Qt::TextAlignmentRole) {
+        return index.column() == Command ? QVariant() : QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role == Qt::ToolTipRole) {
+        char rss[16];
+        du_format_size(static_cast<unsigned long long>(s.rss[i]) * 1024, rss);
+        return tr("자신: CPU %1%, RSS %2\n하위 트리: 프로세스 %3개")
+               .arg(s.cpu[i], 0, 'f', 1).arg(QString::fromLatin1(rss)).arg(tree.subtree_size[i]);
+    }
+    if (role != Qt::DisplayRole) return QVariant();
+
+    char size[16];
+    switch (index.column()) {
+    case Command:
+        return QString::fromLocal8Bit(s.command(i));
+    case Pid:
+        return static_cast<int>(s.pid[i]);
+    case Count:
+        return static_cast<qulonglong>(tree.subtree_size[i]);
+    case Cpu:
+        return QString::number(cpuSum[i], 'f', 1);
+    case Rss:
+        du_format_size(static_cast<unsigned long long>(rssSum[i]) * 1024, size);
+        return QString::fromLatin1(size);
+    case Vsz:
+        du_format_size(static_cast<unsigned long long>(vszSum[i]) * 1024, size);
+        return QString::fromLatin1(size);
+    }
+    return QVariant();
+}
+
+QVariant ProcessTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+    switch (section) {
+    case Command: return QStringLiteral("CMD");
+    case Pid: return QStringLiteral("PID");
+    case Count: return tr("프로세스 수");
+    case Cpu: return tr("CPU% (합)");
+    case Rss: return tr("RSS (합)");
+    case Vsz: return tr("VSZ (합)");
+    }
+    return QVariant();
+}
@@ -0,0 +1,264 @@
+#define _GNU_SOURCE
+#include "../include/procscan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/stat.h>
+
+// stat 한 줄은 comm(최대 64바이트)을 포함해도 수백 바이트라 이 크기면 필요한 필드까지 한 번에 읽힘
+#define PROC_STAT_BUF   1024
+
+struct proc_scanner {
+    DIR *dir;                  // /proc (스캔마다 rewinddir로 다시 읽음)
+    unsigned long page_kb;
+    uid_t uid;
+    char buf[PROC_STAT_BUF];
+};
+
+struct proc_scanner *proc_scanner_create(void) {
+    struct proc_scanner *s = calloc(1, sizeof(*s));
+    if (!s) return NULL;
+
+    s->dir = opendir("/proc");
+    if (!s->dir) {
+        int err = errno;
+        free(s);
+        errno = err;
+        return NULL;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    s->page_kb = page > 0 ? (unsigned long)page / 1024 : 4;
+    s->uid = getuid();
+    return s;
+}
+
+void proc_scanner_free(struct proc_scanner *s) {
+    if (!s) return;
+    closedir(s->dir);
+    free(s);
+}
+
+// 공백을 건너뛰고 10진수 하나를 읽음 (음수 허용)
+static int parse_number(const char **pp, const char *end, long long *out) {
+    const char *p = *pp;
+    while (p < end && *p == ' ') p++;
+
+    int negative = 0;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    if (p >= end || *p < '0' || *p > '9') return -1;
+
+    unsigned long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+        value = value * 10 + (unsigned long long)(*p++ - '0');
+
+    *out = negative ? -(long long)value : (long long)value;
+    *pp = p;
+    return 0;
+}
+
+// stat의 필드 번호 (proc(5) 기준, 1부터). state(3) 다음부터 rss(24)까지 읽음
+enum {
+    STAT_PPID = 4, STAT_PGRP = 5, STAT_SESSION = 6, STAT_TTY_NR = 7,
+    STAT_UTIME = 14, STAT_STIME = 15, STAT_NICE = 19, STAT_NUM_THREADS = 20,
+    STAT_STARTTIME = 22, STAT_VSIZE = 23, STAT_RSS = 24
+};
+
+int proc_parse_stat(const char *buf, size_t len, struct proc_info *p, unsigned long page_kb) {
+    const char *end = buf + len;
+
+    long long pid;
+    const char *cursor = buf;
+    if (parse_number(&cursor, end, &pid) == -1) return -1;
+
+    // comm에는 공백과 괄호가 들어갈 수 있으므로 첫 '('부터 마지막 ')'까지를 comm으로 봄
+    const char *open = memchr(buf, '(', len);
+    const char *close = memrchr(buf, ')', len);
+    if (!open || !close || close < open || close + 3 > end) return -1;
+
+    size_t comm_len = (size_t)(close - open - 1);
+    if (comm_len >= sizeof(p->comm)) comm_len = sizeof(p->comm) - 1;
+    memcpy(p->comm, open + 1, comm_len);
+    p->comm[comm_len] = '\0';
+
+    if (close[1] != ' ') return -1;
+    p->state = close[2];
+    cursor = close + 3;
+
+    long long fields[STAT_RSS + 1];
+    for (int i = STAT_PPID; i <= STAT_RSS; i++) {
+        if (parse_number(&cursor, end, &fields[i]) == -1) return -1;
+    }
+
+    p->pid = (pid_t)pid;
+    p->ppid = (pid_t)fields[STAT_PPID];
+    p->pgrp = (pid_t)fields[STAT_PGRP];
+    p->sid = (pid_t)fields[STAT_SESSION];
+    p->tty_nr = (int)fields[STAT_TTY_NR];
+    p->utime = (unsigned long long)fields[STAT_UTIME];
+    p->stime = (unsigned long long)fields[STAT_STIME];
+    p->nice = (int)fields[STAT_NICE];
+    p->num_threads = (int)fields[STAT_NUM_THREADS];
+    p->starttime = (unsigned long long)fields[STAT_STARTTIME];
+    p->vsz = (unsigned long)(fields[STAT_VSIZE] / 1024);
+    p->rss = (unsigned long)fields[STAT_RSS] * page_kb;
+    return 0;
+}
+
+void proc_format_tty(int tty_nr, char *buf, size_t size) {
+    unsigned major = ((unsigned)tty_nr >> 8) & 0xfff;
+    unsigned minor = ((unsigned)tty_nr & 0xff) | (((unsigned)tty_nr >> 12) & 0xfff00);
+
+    if (tty_nr == 0)
+        snprintf(buf, size, "?");
+    else if (major >= 136 && major <= 143)
+        snprintf(buf, size, "pts/%u", (major - 136) * 256 + minor);
+    else if (major == 4 && minor < 64)
+        snprintf(buf, size, "tty%u", minor);
+    else if (major == 4)
+        snprintf(buf, size, "ttyS%u", minor - 64);
+    else
+        snprintf(buf, size, "%u,%u", major, minor);
+}
+
+// 숫자로만 된 이름이면 pid, 아니면 0
+static pid_t parse_pid_name(const char *name) {
+    long value = 0;
+    for (const char *c = name; *c; c++) {
+        if (*c < '0' || *c > '9' || value > 4194304) return 0;
+        value = value * 10 + (*c - '0');
+    }
+    return (pid_t)value;
+}
+
+// NUL로 구분된 인자들을 공백으로 이어 붙임 (끝의 NUL은 그대로)
+static void join_cmdline(char *cmdline, size_t n) {
+    while (n > 0 && cmdline[n - 1] == '\0') n--;
+    for (size_t i = 0; i < n; i++) {
+        if (cmdline[i] == '\0') cmdline[i] = ' ';
+    }
+}
+
+static int read_cmdline(struct proc_scanner *s, pid_t pid, const char *comm, char *buf, size_t size,
+                        struct proc_scan_metrics *m) {
+    char path[32];
+    snprintf(path, sizeof(path), "%d/cmdline", (int)pid);
+    int fd = openat(dirfd(s->dir), path, O_RDONLY | O_CLOEXEC);
+    m->syscalls++;
+    if (fd == -1) {
+        snprintf(buf, size, "[%s]", comm);
+        return -1;
+    }
+
+    ssize_t n = read(fd, buf, size - 1);
+    m->syscalls += 2;
+    close(fd);
+    if (n > 0) {
+        m->bytes_read += (unsigned long long)n;
+        buf[n] = '\0';
+        join_cmdline(buf, (size_t)n);
+    } else {
+        buf[0] = '\0';
+    }
+    // 커널 스레드는 cmdline이 비어 있으므로 ps처럼 [comm]으로 표시
+    if (buf[0] == '\0')
+        snprintf(buf, size, "[%s]", comm);
+    return 0;
+}
+
+int proc_read_cmdline(struct proc_scanner *s, pid_t pid, const char *comm, char *buf, size_t size) {
+    struct proc_scan_metrics m;
+    memset(&m, 0, sizeof(m));
+    return read_cmdline(s, pid, comm, buf, size, &m);
+}
+
+static double elapsed_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+int proc_scan(struct proc_scanner *s, int flags, struct proc_info **procs, size_t *count,
+              size_t *capacity, struct proc_scan_metrics *metrics) {
+    struct proc_scan_metrics m;
+    memset(&m, 0, sizeof(m));
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    *count = 0;
+    rewinddir(s->dir);
+    int proc_fd = dirfd(s->dir);
+
+    struct dirent *entry;
+    while ((entry = readdir(s->dir))) {
+        m.entries++;
+        if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) continue;
+        pid_t pid = parse_pid_name(entry->d_name);
+        if (pid <= 0) continue;
+
+        char path[32];
+        snprintf(path, sizeof(path), "%d/stat", (int)pid);
+        int fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+        m.syscalls++;
+        if (fd == -1) {
+            // 목록을 읽은 뒤 종료된 프로세스
+            if (errno == ENOENT || errno == ESRCH) m.vanished++;
+            continue;
+        }
+
+        // /proc/<pid> 아래 파일의 소유자는 프로세스의 실효 uid와 같음
+        struct stat st;
+        int stat_ok = fstat(fd, &st) == 0;
+        m.syscalls++;
+        if (stat_ok && !(flags & PROC_SCAN_ALL) && st.st_uid != s->uid) {
+            close(fd);
+            m.syscalls++;
+            m.filtered++;
+            continue;
+        }
+
+        ssize_t n = read(fd, s->buf, sizeof(s->buf) - 1);
+        m.syscalls += 2;
+        close(fd);
+        if (!stat_ok || n <= 0) {
+            m.vanished++;
+            continue;
+        }
+        m.bytes_read += (unsigned long long)n;
+
+        if (*count == *capacity) {
+            size_t new_capacity = *capacity ? *capacity * 2 : 256;
+            struct proc_info *grown = realloc(*procs, new_capacity * sizeof(**procs));
+            if (!grown) {
+                errno = ENOMEM;
+                return -1;
+            }
+            *procs = grown;
+            *capacity = new_capacity;
+        }
+        struct proc_info *p = &(*procs)[*count];
+        memset(p, 0, sizeof(*p));
+        if (proc_parse_stat(s->buf, (size_t)n, p, s->page_kb) == -1) continue;
+        p->uid = st.st_uid;
+        p->gid = st.st_gid;
+
+        if (flags & PROC_SCAN_CMDLINE) {
+            read_cmdline(s, pid, p->comm, p->cmdline, sizeof(p->cmdline), &m);
+        } else {
+            memcpy(p->cmdline, p->comm, sizeof(p->comm));
+        }
+        (*count)++;
+    }
+
+    m.procs = *count;
+    m.elapsed_ms = elapsed_since(&start);
+    if (metrics) *metrics = m;
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "../include/proctree.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// pid -> 노드 번호 (선형 탐사, pid는 0보다 큼)
+struct pid_map {
+    pid_t *keys;
+    size_t *values;
+    size_t mask;
+};
+
+static size_t pid_hash(pid_t pid, size_t mask) {
+    return ((size_t)(unsigned)pid * 0x9E3779B1u) & mask;
+}
+
+static int pid_map_init(struct pid_map *map, size_t n) {
+    size_t size = 16;
+    while (size < n * 2) size <<= 1;
+    map->keys = calloc(size, sizeof(*map->keys));
+    map->values = malloc(size * sizeof(*map->values));
+    map->mask = size - 1;
+    return map->keys && map->values ? 0 : -1;
+}
+
+static void pid_map_put(struct pid_map *map, pid_t pid, size_t value) {
+    size_t slot = pid_hash(pid, map->mask);
+    while (map->keys[slot] != 0 && map->keys[slot] != pid)
+        slot = (slot + 1) & map->mask;
+    map->keys[slot] = pid;
+    map->values[slot] = value;
+}
+
+static size_t pid_map_get(const struct pid_map *map, pid_t pid) {
+    if (pid <= 0) return PROC_TREE_NONE;
+    size_t slot = pid_hash(pid, map->mask);
+    while (map->keys[slot] != 0) {
+        if (map->keys[slot] == pid) return map->values[slot];
+        slot = (slot + 1) & map->mask;
+    }
+    return PROC_TREE_NONE;
+}
+
+void proc_tree_free(struct proc_tree *tree) {
+    free(tree->parent);
+    free(tree->child_start);
+    free(tree->children);
+    free(tree->roots);
+    free(tree->position);
+    free(tree->preorder);
+    free(tree->preorder_pos);
+    free(tree->subtree_size);
+    free(tree->depth);
+    memset(tree, 0, sizeof(*tree));
+}
+
+// 부모 사슬을 따라가다 지금 걷는 경로로 되돌아오면 순환이므로 그 자리에서 끊음.
+// 각 노드는 한 번만 경로에 오르므로 전체 O(n)
+static void break_cycles(size_t *parent, size_t n, unsigned char *state, size_t *path) {
+    enum { UNSEEN, ON_PATH, DONE };
+    memset(state, UNSEEN, n);
+
+    for (size_t i = 0; i < n; i++) {
+        if (state[i] != UNSEEN) continue;
+
+        size_t len = 0;
+        size_t node = i;
+        for (;;) {
+            state[node] = ON_PATH;
+            path[len++] = node;
+            size_t p = parent[node];
+            if (p == PROC_TREE_NONE || state[p] == DONE) break;
+            if (state[p] == ON_PATH) {
+                parent[node] = PROC_TREE_NONE;
+                break;
+            }
+            node = p;
+        }
+        while (len > 0)
+            state[path[--len]] = DONE;
+    }
+}
+
+int proc_tree_build(const pid_t *pids, const pid_t *ppids, size_t n, struct proc_tree *tree) {
+    memset(tree, 0, sizeof(*tree));
+    tree->count = n;
+
+    struct pid_map map = { NULL, NULL, 0 };
+    unsigned char *state = malloc(n ? n : 1);
+    size_t *stack = malloc((n ? n : 1) * sizeof(*stack));
+    tree->parent = malloc((n ? n : 1) * sizeof(*tree->parent));
+    tree->child_start = calloc(n + 1, sizeof(*tree->child_start));
+    tree->children = malloc((n ? n : 1) * sizeof(*tree->children));
+    tree->roots = malloc((n ? n : 1) * sizeof(*tree->roots));
+    tree->position = malloc((n ? n : 1) * sizeof(*tree->position));
+    tree->preorder = malloc((n ? n : 1) * sizeof(*tree->preorder));
+    tree->preorder_pos = malloc((n ? n : 1) * sizeof(*tree->preorder_pos));
+    tree->subtree_size = malloc((n ? n : 1) * sizeof(*tree->subtree_size));
+    tree->depth = malloc((n ? n : 1) * sizeof(*tree->depth));
+    if (pid_map_init(&map, n) == -1 || !state || !stack || !tree->parent || !tree->child_start ||
+        !tree->children || !tree->roots || !tree->position || !tree->preorder ||
+        !tree->preorder_pos || !tree->subtree_size || !tree->depth) {
+        free(map.keys);
+        free(map.values);
+        free(state);
+        free(stack);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++)
+        pid_map_put(&map, pids[i], i);
+    for (size_t i = 0; i < n; i++) {
+        size_t p = ppids[i] != pids[i] ? pid_map_get(&map, ppids[i]) : PROC_TREE_NONE;
+        tree->parent[i] = p;
+    }
+    free(map.keys);
+    free(map.values);
+
+    break_cycles(tree->parent, n, state, stack);
+    free(state);
+
+    // 자식 수를 세어 구간을 잡고 (CSR), 입력 순서대로 채움
+    for (size_t i = 0; i < n; i++) {
+        if (tree->parent[i] != PROC_TREE_NONE)
+            tree->child_start[tree->parent[i] + 1]++;
+    }
+    for (size_t i = 0; i < n; i++)
+        tree->child_start[i + 1] += tree->child_start[i];
+    for (size_t i = 0; i < n; i++) {
+        size_t p = tree->parent[i];
+        if (p == PROC_TREE_NONE) {
+            tree->position[i] = tree->nroots;
+            tree->roots[tree->nroots++] = i;
+        } else {
+            // child_start[p]를 채울 위치로 잠시 쓰고 아래에서 되돌림
+            tree->position[i] = tree->child_start[p];
+            tree->children[tree->child_start[p]++] = i;
+        }
+    }
+    // 채우면서 각 구간의 시작이 끝으로 밀렸으므로 한 칸씩 당겨서 복원
+    for (size_t i = n; i > 0; i--)
+        tree->child_start[i] = tree->child_start[i - 1];
+    tree->child_start[0] = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t p = tree->parent[i];
+        if (p != PROC_TREE_NONE)
+            tree->position[i] -= tree->child_start[p];
+    }
+
+    // 전위 순서: 스택에 자식을 역순으로 넣어 입력 순서대로 방문
+    size_t top = 0, visited = 0;
+    for (size_t r = tree->nroots; r > 0; r--) {
+        size_t root = tree->roots[r - 1];
+        tree->depth[root] = 0;
+        stack[top++] = root;
+    }
+    while (top > 0) {
+        size_t node = stack[--top];
+        tree->preorder_pos[node] = visited;
+        tree->preorder[visited++] = node;
+        for (size_t c = tree->child_start[node + 1]; c > tree->child_start[node]; c--) {
+            size_t child = tree->children[c - 1];
+            tree->depth[child] = tree->depth[node] + 1;
+            stack[top++] = child;
+        }
+    }
+    free(stack);
+
+    // 하위 트리 크기: 전위 순서를 거꾸로 훑으면 자식이 항상 부모보다 먼저 끝남
+    for (size_t i = 0; i < n; i++)
+        tree->subtree_size[i] = 1;
+    for (size_t k = n; k > 0; k--) {
+        size_t node = tree->preorder[k - 1];
+        if (tree->parent[node] != PROC_TREE_NONE)
+            tree->subtree_size[tree->parent[node]] += tree->subtree_size[node];
+    }
+    return 0;
+}
+
+void proc_tree_sum(const struct proc_tree *tree, const double *values, double *sums) {
+    if (sums != values)
+        memcpy(sums, values, tree->count * sizeof(*sums));
+    for (size_t k = tree->count; k > 0; k--) {
+        size_t node = tree->preorder[k - 1];
+        size_t p = tree->parent[node];
+        if (p != PROC_TREE_NONE)
+            sums[p] += sums[node];
+    }
+}
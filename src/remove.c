@@ -0,0 +1,434 @@
+#define _GNU_SOURCE
+#include "../include/remove.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+// 자식 디렉토리가 남아 있는 동안 열어 둘 디렉토리 fd의 최대 수 (작업 하나 기준,
+// RLIMIT_NOFILE의 1/4도 넘지 않음). 이보다 깊은 트리는 fd 없이 두었다가
+// 자식이 필요할 때 가까운 조상부터 다시 엶
+#define REMOVE_MAX_OPEN_DIRS  256
+
+// 디렉토리 하나. 한도 안이면 자식 디렉토리가 남아 있는 동안 fd를 열어 두고,
+// 참조 수가 0이 되면 부모 기준으로 rmdir 한 뒤 부모의 참조를 하나 놓음
+struct rm_node {
+    struct rm_node *parent;   // NULL이면 최상위 (name은 전체 경로)
+    int fd;                   // 열어 둔 디렉토리 fd, 없으면 -1 (자식이 생기기 전에 정해지고 바뀌지 않음)
+    int opened;               // 디렉토리로 열어 읽었으면 1 (그때만 rmdir)
+    unsigned refs;            // 탐색 중 1 + 처리 중인 자식 디렉토리 수
+    char name[];
+};
+
+struct remove_job {
+    int nworkers;
+    pthread_t *workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct rm_node **queue;   // 스택 (깊이 우선에 가깝게 처리해 대기 노드 수를 줄임)
+    size_t queue_len;
+    size_t queue_capacity;
+    int active;               // 지금 디렉토리를 처리 중인 워커 수
+    int running_workers;
+    int open_dirs;            // 열어 둔 rm_node.fd 수 (max_open_dirs까지)
+    int max_open_dirs;
+
+    int cancel;
+    unsigned long long files_removed;
+    unsigned long long dirs_removed;
+    unsigned long long errors;
+    int finished;
+
+    pthread_mutex_t error_lock;
+    char error[MAX_PATH_SIZE * 2];
+};
+
+static int job_canceled(const struct remove_job *job) {
+    return __atomic_load_n(&job->cancel, __ATOMIC_RELAXED);
+}
+
+// 오류 메시지용 경로 (부모 체인을 따라 이어 붙임)
+static size_t node_path(const struct rm_node *node, char *buf, size_t size) {
+    size_t len = node->parent ? node_path(node->parent, buf, size) : 0;
+    if (len + 1 >= size) return len;
+    int written = snprintf(buf + len, size - len, "%s%s", node->parent ? "/" : "", node->name);
+    if (written < 0) return len;
+    len += (size_t)written;
+    return len < size ? len : size - 1;
+}
+
+static void job_record_error(struct remove_job *job, const struct rm_node *dir,
+                             const char *name, int err) {
+    __atomic_add_fetch(&job->errors, 1, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&job->error_lock);
+    if (job->error[0] == '\0') {
+        char path[MAX_PATH_SIZE];
+        path[0] = '\0';
+        size_t len = dir ? node_path(dir, path, sizeof(path)) : 0;
+        if (name)
+            snprintf(path + len, sizeof(path) - len, "%s%s", len ? "/" : "", name);
+        snprintf(job->error, sizeof(job->error), "%s: %s", path, strerror(err));
+    }
+    pthread_mutex_unlock(&job->error_lock);
+}
+
+static struct rm_node *node_new(struct rm_node *parent, const char *name) {
+    size_t len = strlen(name);
+    struct rm_node *node = malloc(sizeof(*node) + len + 1);
+    if (!node) return NULL;
+    node->parent = parent;
+    node->fd = -1;
+    node->opened = 0;
+    node->refs = 1;
+    memcpy(node->name, name, len + 1);
+    return node;
+}
+
+// dir(NULL이면 작업 디렉토리)을 가리키는 fd. 열어 둔 fd가 없으면 fd가 있는 가장 가까운
+// 조상(없으면 최상위)부터 남은 이름들을 open_dir_chain으로 다시 열어 *tmp에 넣어 줌
+// (-1이 아니면 호출한 쪽이 닫음)
+static int dir_fd(const struct rm_node *dir, int *tmp) {
+    *tmp = -1;
+    if (!dir) return AT_FDCWD;
+    if (dir->fd != -1) return dir->fd;
+
+    size_t depth = 0;
+    const struct rm_node *base = dir;
+    while (base && base->fd == -1) {
+        base = base->parent;
+        depth++;
+    }
+    const char **names = malloc(depth * sizeof(*names));
+    if (!names) {
+        errno = ENOMEM;
+        return -1;
+    }
+    const struct rm_node *step = dir;
+    for (size_t i = depth; i > 0; i--) {
+        names[i - 1] = step->name;
+        step = step->parent;
+    }
+
+    int cur = base ? base->fd : AT_FDCWD;
+    size_t first = 0;
+    if (!base) {
+        // 최상위는 사용자가 준 경로이므로 처음 열 때와 같은 플래그로 엶
+        *tmp = openat(AT_FDCWD, names[0], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (*tmp == -1) {
+            int err = errno;
+            free(names);
+            errno = err;
+            return -1;
+        }
+        cur = *tmp;
+        first = 1;
+    }
+    if (first < depth) {
+        int fd = open_dir_chain(cur, names + first, depth - first);
+        int err = errno;
+        if (*tmp != -1) close(*tmp);
+        *tmp = fd;
+        if (fd == -1) {
+            free(names);
+            errno = err;
+            return -1;
+        }
+    }
+    free(names);
+    return *tmp;
+}
+
+static int parent_fd(const struct rm_node *node, int *tmp) {
+    return dir_fd(node->parent, tmp);
+}
+
+// 참조를 놓고, 0이 되면 디렉토리를 지운 뒤 부모로 올라감 (재귀 대신 반복)
+static void node_release(struct remove_job *job, struct rm_node *node) {
+    while (node && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        struct rm_node *parent = node->parent;
+        if (node->fd != -1) {
+            close(node->fd);
+            __atomic_sub_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED);
+        }
+
+        if (node->opened && !job_canceled(job)) {
+            int tmp;
+            int pfd = parent_fd(node, &tmp);
+            if (pfd != -1 && unlinkat(pfd, node->name, AT_REMOVEDIR) == 0) {
+                __atomic_add_fetch(&job->dirs_removed, 1, __ATOMIC_RELAXED);
+            } else if (errno != ENOTEMPTY || __atomic_load_n(&job->errors, __ATOMIC_RELAXED) == 0) {
+                // 하위 항목 삭제 실패로 비지 않은 경우는 이미 보고됨
+                job_record_error(job, parent, node->name, errno);
+            }
+            if (tmp != -1) close(tmp);
+        }
+        free(node);
+        node = parent;
+    }
+}
+
+// 하위 디렉토리는 모두 힙의 스택으로 넘김 (그 자리에서 재귀하면 트리 깊이만큼 C 스택을 씀).
+// 스택을 늘리지 못하면 -1
+static int queue_push(struct remove_job *job, struct rm_node *node) {
+    int result = 0;
+    pthread_mutex_lock(&job->lock);
+    if (job->queue_len == job->queue_capacity) {
+        size_t new_capacity = job->queue_capacity ? job->queue_capacity * 2 : 16;
+        struct rm_node **grown = realloc(job->queue, new_capacity * sizeof(*grown));
+        if (!grown) {
+            result = -1;
+            goto out;
+        }
+        job->queue = grown;
+        job->queue_capacity = new_capacity;
+    }
+    job->queue[job->queue_len++] = node;
+    pthread_cond_signal(&job->cond);
+out:
+    pthread_mutex_unlock(&job->lock);
+    return result;
+}
+
+static void process_node(struct remove_job *job, struct rm_node *node) {
+    if (job_canceled(job)) {
+        node_release(job, node);
+        return;
+    }
+
+    int tmp;
+    int pfd = parent_fd(node, &tmp);
+    int fd = pfd == -1 ? -1 : openat(pfd, node->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd == -1) {
+        int err = errno;
+        // 디렉토리가 아니면 (최상위 파일, 심볼릭 링크 등) 그냥 unlink
+        if (pfd != -1 && (err == ENOTDIR || err == ELOOP)) {
+            if (unlinkat(pfd, node->name, 0) == 0)
+                __atomic_add_fetch(&job->files_removed, 1, __ATOMIC_RELAXED);
+            else
+                job_record_error(job, node->parent, node->name, errno);
+        } else if (err != ENOENT) {
+            job_record_error(job, node->parent, node->name, err);
+        }
+        if (tmp != -1) close(tmp);
+        node_release(job, node);
+        return;
+    }
+    if (tmp != -1) close(tmp);
+
+    // 한도 안이면 자식들이 openat/rmdir에 쓰도록 fd를 남겨 둠. 읽기는 복제한 fd로 하고
+    // 다 읽으면 DIR 스트림은 바로 닫으므로, 깊은 트리에서도 열린 fd가 한도를 넘지 않음
+    int keep = __atomic_add_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED) <= job->max_open_dirs;
+    int scan_fd = fd;
+    if (keep && (scan_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0)) == -1) {
+        keep = 0;
+        scan_fd = fd;
+    }
+    if (!keep)
+        __atomic_sub_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED);
+
+    DIR *dir = fdopendir(scan_fd);
+    if (!dir) {
+        job_record_error(job, node->parent, node->name, errno);
+        close(scan_fd);
+        if (keep) {
+            close(fd);
+            __atomic_sub_fetch(&job->open_dirs, 1, __ATOMIC_RELAXED);
+        }
+        node_release(job, node);
+        return;
+    }
+    node->fd = keep ? fd : -1;
+    node->opened = 1;
+
+    struct dirent *d;
+    while (!job_canceled(job) && (errno = 0, d = readdir(dir)) != NULL) {
+        if (d->d_name[0] == '.' &&
+            (d->d_name[1] == '\0' || (d->d_name[1] == '.' && d->d_name[2] == '\0')))
+            continue;
+
+        if (d->d_type != DT_DIR) {
+            // 유형을 모르면 먼저 파일로 지워 보고, 디렉토리라서 실패하면 아래로 내려감
+            if (unlinkat(scan_fd, d->d_name, 0) == 0) {
+                __atomic_add_fetch(&job->files_removed, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            if (d->d_type != DT_UNKNOWN || (errno != EISDIR && errno != EPERM)) {
+                if (errno != ENOENT)
+                    job_record_error(job, node, d->d_name, errno);
+                continue;
+            }
+        }
+
+        struct rm_node *child = node_new(node, d->d_name);
+        if (!child) {
+            job_record_error(job, node, d->d_name, ENOMEM);
+            continue;
+        }
+        __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+        if (queue_push(job, child) == -1) {
+            job_record_error(job, node, d->d_name, ENOMEM);
+            free(child);
+            __atomic_sub_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+        }
+    }
+    if (!job_canceled(job) && errno != 0)
+        job_record_error(job, node->parent, node->name, errno);
+    closedir(dir);
+
+    node_release(job, node);
+}
+
+static void *worker_main(void *arg) {
+    struct remove_job *job = arg;
+
+    pthread_mutex_lock(&job->lock);
+    for (;;) {
+        if (job->queue_len > 0) {
+            struct rm_node *node = job->queue[--job->queue_len];
+            job->active++;
+            pthread_mutex_unlock(&job->lock);
+
+            process_node(job, node);
+
+            pthread_mutex_lock(&job->lock);
+            job->active--;
+            if (job->queue_len == 0 && job->active == 0)
+                pthread_cond_broadcast(&job->cond);
+            continue;
+        }
+        // 큐가 비었고 처리 중인 워커도 없으면 더 생길 작업이 없음
+        if (job->active == 0) break;
+        pthread_cond_wait(&job->cond, &job->lock);
+    }
+    int last = --job->running_workers == 0;
+    pthread_mutex_unlock(&job->lock);
+
+    if (last)
+        __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+struct remove_job *remove_job_start(const char *const *paths, size_t n, int workers) {
+    if (workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (workers > REMOVE_MAX_WORKERS) workers = REMOVE_MAX_WORKERS;
+
+    struct remove_job *job = calloc(1, sizeof(*job));
+    if (!job) return NULL;
+    job->workers = calloc((size_t)workers, sizeof(pthread_t));
+    job->queue = calloc(n ? n : 1, sizeof(*job->queue));
+    if (!job->workers || !job->queue) {
+        free(job->workers);
+        free(job->queue);
+        free(job);
+        return NULL;
+    }
+    job->queue_capacity = n ? n : 1;
+    job->max_open_dirs = REMOVE_MAX_OPEN_DIRS;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+        limit.rlim_cur / 4 < (rlim_t)job->max_open_dirs)
+        job->max_open_dirs = (int)(limit.rlim_cur / 4);
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->cond, NULL);
+    pthread_mutex_init(&job->error_lock, NULL);
+
+    // 최상위 항목은 워커 시작 전에 모두 큐에 넣음
+    for (size_t i = 0; i < n; i++) {
+        struct rm_node *node = node_new(NULL, paths[i]);
+        if (!node) {
+            job_record_error(job, NULL, paths[i], ENOMEM);
+            continue;
+        }
+        job->queue[job->queue_len++] = node;
+    }
+
+    for (int i = 0; i < workers; i++) {
+        if (pthread_create(&job->workers[i], NULL, worker_main, job) != 0)
+            break;
+        pthread_mutex_lock(&job->lock);
+        job->nworkers++;
+        job->running_workers++;
+        pthread_mutex_unlock(&job->lock);
+    }
+    if (job->nworkers == 0) {
+        for (size_t i = 0; i < job->queue_len; i++)
+            free(job->queue[i]);
+        job->queue_len = 0;
+        remove_job_free(job);
+        errno = EAGAIN;
+        return NULL;
+    }
+    return job;
+}
+
+void remove_job_progress(struct remove_job *job, struct remove_progress *out) {
+    out->files_removed = __atomic_load_n(&job->files_removed, __ATOMIC_RELAXED);
+    out->dirs_removed = __atomic_load_n(&job->dirs_removed, __ATOMIC_RELAXED);
+    out->errors = __atomic_load_n(&job->errors, __ATOMIC_RELAXED);
+    out->finished = __atomic_load_n(&job->finished, __ATOMIC_ACQUIRE);
+}
+
+void remove_job_cancel(struct remove_job *job) {
+    __atomic_store_n(&job->cancel, 1, __ATOMIC_RELAXED);
+}
+
+int remove_job_wait(struct remove_job *job) {
+    for (int i = 0; i < job->nworkers; i++)
+        pthread_join(job->workers[i], NULL);
+    job->nworkers = 0;
+    __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+
+    if (job_canceled(job)) {
+        errno = ECANCELED;
+        return -1;
+    }
+    return job->errors ? -1 : 0;
+}
+
+const char *remove_job_error(struct remove_job *job) {
+    return job->error[0] ? job->error : NULL;
+}
+
+void remove_job_free(struct remove_job *job) {
+    if (!job) return;
+    pthread_mutex_destroy(&job->lock);
+    pthread_cond_destroy(&job->cond);
+    pthread_mutex_destroy(&job->error_lock);
+    free(job->queue);
+    free(job->workers);
+    free(job);
+}
+
+int remove_tree(const char *path, int workers, struct remove_progress *out,
+                char *error, size_t error_size) {
+    if (out)
+        memset(out, 0, sizeof(*out));
+    if (error && error_size > 0)
+        error[0] = '\0';
+
+    struct remove_job *job = remove_job_start(&path, 1, workers);
+    if (!job) return -1;
+
+    int result = remove_job_wait(job);
+    int saved_errno = errno;
+    if (out)
+        remove_job_progress(job, out);
+    if (error && error_size > 0) {
+        const char *message = remove_job_error(job);
+        snprintf(error, error_size, "%s", message ? message : "");
+    }
+    remove_job_free(job);
+    errno = saved_errno;
+    return result;
+}
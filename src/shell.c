@@ -0,0 +1,753 @@
+#define _GNU_SOURCE
+#include "../include/shell.h"
+#include "../include/commands.h"
+#include "../include/jobspawn.h"
+#include "../include/utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+char current_dir[MAX_PATH_SIZE] = BASE_DIR;
+volatile sig_atomic_t interrupted = 0;
+
+// 파이프라인 단계 스레드의 입력 fd (SHELL_BUILTIN_STDIN 빌트인만 씀, 없으면 -1)
+static __thread int stage_input = -1;
+
+void handle_sigint(int signo) {
+    (void)signo;
+    interrupted = 1;
+    printf("\n종료하려면 'exit' 또는 'quit'를 입력하세요\n");
+    printf("%s $ ", current_dir);
+    fflush(stdout);
+}
+
+// ---- 빌트인 ----
+
+static int builtin_help(int argc, char *const argv[]) {
+    (void)argc; (void)argv;
+    call_help();
+    return 0;
+}
+
+static int builtin_ls(int argc, char *const argv[]) {
+    struct ls_options opts = {0};
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0) opts.sort_by_time = 1;
+        else if (strcmp(argv[i], "-S") == 0) opts.sort_by_size = 1;
+        else if (strcmp(argv[i], "-r") == 0) opts.reverse_sort = 1;
+        else if (strcmp(argv[i], "-T") == 0) opts.show_all_times = 1;
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) opts.stat_workers = atoi(argv[++i]);
+    }
+    call_ls(current_dir, &opts);
+    return 0;
+}
+
+static int builtin_cd(int argc, char *const argv[]) {
+    if (argc < 2) {
+        printf("cd: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    char new_dir[MAX_PATH_SIZE];
+    call_cd(current_dir, argv[1], new_dir);
+    strcpy(current_dir, new_dir);
+    return 0;
+}
+
+static int builtin_mkdir(int argc, char *const argv[]) {
+    if (argc < 2) {
+        printf("mkdir: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    call_mkdir(current_dir, argv[1]);
+    return 0;
+}
+
+static int builtin_rmdir(int argc, char *const argv[]) {
+    if (argc < 2) {
+        printf("rmdir: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    call_rmdir(current_dir, argv[1]);
+    return 0;
+}
+
+static int builtin_rename(int argc, char *const argv[]) {
+    if (argc < 3) {
+        printf("rename: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    return call_rename(current_dir, argv[1], argv[2]) == 0 ? 0 : 1;
+}
+
+static int builtin_ln(int argc, char *const argv[]) {
+    int symbolic = 0, i = 1;
+    if (i < argc && strcmp(argv[i], "-s") == 0) {
+        symbolic = 1;
+        i++;
+    }
+    if (argc - i < 2) {
+        printf("ln: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    call_ln(current_dir, argv[i], argv[i + 1], symbolic);
+    return 0;
+}
+
+static int builtin_rm(int argc, char *const argv[]) {
+    int recursive = 0, i = 1;
+    if (i < argc && strcmp(argv[i], "-r") == 0) {
+        recursive = 1;
+        i++;
+    }
+    if (i >= argc) {
+        printf("rm: 인자가 누락되었습니다\n");
+        printf("사용법: rm [-r] <파일/디렉토리>\n");
+        return 1;
+    }
+    call_rm(current_dir, argv[i], recursive);
+    return 0;
+}
+
+static int builtin_chmod(int argc, char *const argv[]) {
+    if (argc < 3) {
+        printf("chmod: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    return call_chmod(current_dir, argv[2], argv[1]) == 0 ? 0 : 1;
+}
+
+static int builtin_cat(int argc, char *const argv[]) {
+    if (argc < 2 && stage_input != -1) {
+        FILE *out = shell_output();
+        char buf[64 * 1024];
+        ssize_t n;
+        while ((n = read(stage_input, buf, sizeof(buf))) > 0 || (n == -1 && errno == EINTR)) {
+            if (n > 0 && fwrite(buf, 1, (size_t)n, out) != (size_t)n) return 1;   // 뒤 단계가 끝남
+        }
+        return n == 0 ? 0 : 1;
+    }
+    if (argc < 2) {
+        printf("cat: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    call_cat(current_dir, argv[1]);
+    return 0;
+}
+
+static int builtin_cp(int argc, char *const argv[]) {
+    if (argc < 3) {
+        printf("cp: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    call_cp(current_dir, argv[1], argv[2]);
+    return 0;
+}
+
+static int builtin_ps(int argc, char *const argv[]) {
+    // parse_ps_options는 옵션 문자열 하나를 받으므로 다시 이어 붙임
+    char options[SHELL_LINE_SIZE];
+    size_t len = 0;
+    options[0] = '\0';
+    for (int i = 1; i < argc; i++) {
+        int n = snprintf(options + len, sizeof(options) - len, "%s%s", i > 1 ? " " : "", argv[i]);
+        if (n < 0 || (size_t)n >= sizeof(options) - len) break;
+        len += (size_t)n;
+    }
+    call_ps(argc > 1 ? options : NULL);
+    return 0;
+}
+
+static int builtin_kill(int argc, char *const argv[]) {
+    if (argc < 2) {
+        printf("kill: 인자가 누락되었습니다\n");
+        return 1;
+    }
+    return call_kill(argv[1], argc > 2 ? argv[2] : NULL) == 0 ? 0 : 1;
+}
+
+static int builtin_pkill(int argc, char *const argv[]) {
+    struct pkill_options opts = { SIGTERM, 0, 0, 0 };
+    const char *pattern = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        if (pattern || option[0] != '-' || option[1] == '\0') pattern = option;
+        else if (strcmp(option, "-f") == 0) opts.match_flags |= PROC_MATCH_FULL;
+        else if (strcmp(option, "-x") == 0) opts.match_flags |= PROC_MATCH_EXACT;
+        else if (strcmp(option, "-i") == 0) opts.match_flags |= PROC_MATCH_ICASE;
+        else if (strcmp(option, "-n") == 0) opts.list_only = 1;
+        else if (strcmp(option, "-w") == 0) {
+            if (i + 1 < argc) opts.wait_sec = atoi(argv[++i]);
+        }
+        else if ((opts.sig = signal_parse(option + 1)) == -1) {
+            printf("pkill: 알 수 없는 시그널: %s\n", option + 1);
+            return 1;
+        }
+    }
+    if (!pattern) {
+        printf("pkill: 패턴이 누락되었습니다\n");
+        printf("사용법: pkill [-시그널] [-f] [-x] [-i] [-n] [-w 초] <패턴>\n");
+        return 1;
+    }
+    return call_pkill(pattern, &opts) == 0 ? 0 : 1;
+}
+
+static int builtin_mmap_test(int argc, char *const argv[]) {
+    if (argc < 2) {
+        printf("mmap_test: 파일 이름을 지정해주세요\n");
+        printf("사용법: mmap_test <파일> [메시지 수] [생산자 수]\n");
+        return 1;
+    }
+    struct mmap_test_options opts;
+    mmap_test_default_options(&opts);
+    if (argc > 2) opts.messages = strtoul(argv[2], NULL, 10);
+    if (argc > 3) opts.producers = atoi(argv[3]);
+    call_mmap_test(argv[1], &opts);
+    return 0;
+}
+
+static int builtin_cpbench(int argc, char *const argv[]) {
+    call_cp_bench(current_dir, argc > 1 ? argv[1] : NULL);
+    return 0;
+}
+
+static int builtin_ls_bench(int argc, char *const argv[]) {
+    call_ls_bench(argc > 1 ? argv[1] : NULL);
+    return 0;
+}
+
+static int builtin_du(int argc, char *const argv[]) {
+    struct du_options opts = { -1, 0, 0 };
+    int apparent = 0, human = 0;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        if (strcmp(option, "-s") == 0) opts.max_depth = 0;
+        else if (strcmp(option, "-b") == 0) apparent = 1;
+        else if (strcmp(option, "-h") == 0) human = 1;
+        else if (strcmp(option, "-f") == 0) opts.flags |= DU_NO_CACHE;
+        else if (strcmp(option, "-d") == 0 || strcmp(option, "-j") == 0) {
+            if (i + 1 >= argc) continue;
+            if (option[1] == 'd') opts.max_depth = atoi(argv[++i]);
+            else opts.workers = atoi(argv[++i]);
+        }
+        else path = option;
+    }
+    call_du(current_dir, path, &opts, apparent, human);
+    return 0;
+}
+
+static int builtin_grep(int argc, char *const argv[]) {
+    struct grep_options opts = { 0, 0, 0, 0 };
+    const char *pattern = NULL, *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        if (!pattern && strcmp(option, "-i") == 0) opts.flags |= GREP_IGNORE_CASE;
+        else if (!pattern && strcmp(option, "-E") == 0) opts.flags |= GREP_REGEX;
+        else if (!pattern && strcmp(option, "-a") == 0) opts.flags |= GREP_BINARY;
+        else if (!pattern && (strcmp(option, "-m") == 0 || strcmp(option, "-j") == 0)) {
+            if (i + 1 >= argc) continue;
+            if (option[1] == 'm') opts.max_matches = strtoull(argv[++i], NULL, 10);
+            else opts.workers = atoi(argv[++i]);
+        }
+        else if (!pattern) pattern = option;
+        else path = option;
+    }
+    if (!pattern) {
+        printf("grep: 패턴이 누락되었습니다\n");
+        printf("사용법: grep [-i] [-E] [-a] [-m N] [-j N] <패턴> [경로]\n");
+        return 1;
+    }
+    // 경로 없이 파이프라인/리디렉션 뒤에 오면 그 입력을 검색 (ps | grep foo)
+    if (!path && stage_input != -1)
+        return call_grep_fd(stage_input, pattern, &opts) == 0 ? 0 : 1;
+    call_grep(current_dir, pattern, path, &opts);
+    return 0;
+}
+
+static int builtin_statbench(int argc, char *const argv[]) {
+    call_stat_bench(current_dir, argc > 1 ? argv[1] : NULL);
+    return 0;
+}
+
+static int builtin_exit(int argc, char *const argv[]) {
+    (void)argc; (void)argv;
+    return SHELL_EXIT;
+}
+
+// 빌트인 이름의 완전 해시: 첫 글자, 마지막 글자, 길이만으로 아래 이름들이 모두 다른 칸에 들어감.
+// 칸 번호를 같은 매크로로 컴파일 시간에 계산하므로, 이름을 추가했을 때 충돌하면
+// 같은 칸을 두 번 초기화하게 되어 -Woverride-init 경고가 남 (그때는 계수를 다시 찾아야 함)
+#define BUILTIN_HASH(first, last, len) \
+    ((unsigned)((unsigned char)(first) * 2u + (unsigned char)(last) * 13u + (unsigned)(len)) \
+     & (SHELL_BUILTIN_SLOTS - 1))
+#define BUILTIN_SLOT(name, first, last) [BUILTIN_HASH(first, last, sizeof(name) - 1)]
+
+static const struct shell_builtin builtins[SHELL_BUILTIN_SLOTS] = {
+    BUILTIN_SLOT("help", 'h', 'p')           = { "help",      builtin_help,      SHELL_BUILTIN_STREAM },
+    BUILTIN_SLOT("ls", 'l', 's')             = { "ls",        builtin_ls,        SHELL_BUILTIN_STREAM },
+    BUILTIN_SLOT("cd", 'c', 'd')             = { "cd",        builtin_cd,        0 },
+    BUILTIN_SLOT("mkdir", 'm', 'r')          = { "mkdir",     builtin_mkdir,     0 },
+    BUILTIN_SLOT("rmdir", 'r', 'r')          = { "rmdir",     builtin_rmdir,     0 },
+    BUILTIN_SLOT("rename", 'r', 'e')         = { "rename",    builtin_rename,    0 },
+    BUILTIN_SLOT("ln", 'l', 'n')             = { "ln",        builtin_ln,        0 },
+    BUILTIN_SLOT("rm", 'r', 'm')             = { "rm",        builtin_rm,        0 },
+    BUILTIN_SLOT("chmod", 'c', 'd')          = { "chmod",     builtin_chmod,     0 },
+    BUILTIN_SLOT("cat", 'c', 't')            = { "cat",       builtin_cat,       SHELL_BUILTIN_STREAM | SHELL_BUILTIN_STDIN },
+    BUILTIN_SLOT("cp", 'c', 'p')             = { "cp",        builtin_cp,        0 },
+    BUILTIN_SLOT("ps", 'p', 's')             = { "ps",        builtin_ps,        SHELL_BUILTIN_STREAM },
+    BUILTIN_SLOT("kill", 'k', 'l')           = { "kill",      builtin_kill,      0 },
+    BUILTIN_SLOT("pkill", 'p', 'l')          = { "pkill",     builtin_pkill,     0 },
+    BUILTIN_SLOT("mmap_test", 'm', 't')      = { "mmap_test", builtin_mmap_test, SHELL_BUILTIN_STREAM },
+    BUILTIN_SLOT("cpbench", 'c', 'h')        = { "cpbench",   builtin_cpbench,   0 },
+    BUILTIN_SLOT("ls_bench", 'l', 'h')       = { "ls_bench",  builtin_ls_bench,  0 },
+    BUILTIN_SLOT("du", 'd', 'u')             = { "du",        builtin_du,        SHELL_BUILTIN_STREAM },
+    BUILTIN_SLOT("grep", 'g', 'p')           = { "grep",      builtin_grep,      SHELL_BUILTIN_STREAM | SHELL_BUILTIN_STDIN },
+    BUILTIN_SLOT("statbench", 's', 'h')      = { "statbench", builtin_statbench, 0 },
+    BUILTIN_SLOT("exit", 'e', 't')           = { "exit",      builtin_exit,      0 },
+    BUILTIN_SLOT("quit", 'q', 't')           = { "quit",      builtin_exit,      0 },
+};
+
+const struct shell_builtin *shell_find_builtin(const char *name) {
+    size_t len = strlen(name);
+    if (len == 0) return NULL;
+    const struct shell_builtin *b = &builtins[BUILTIN_HASH(name[0], name[len - 1], len)];
+    return b->name && strcmp(b->name, name) == 0 ? b : NULL;
+}
+
+// ---- 파서 ----
+
+static int is_operator(char c) {
+    return c == '|' || c == '<' || c == '>';
+}
+
+// 형식 문자열은 호출하는 쪽의 리터럴이어야 함 (컴파일러가 인자와 맞는지 검사)
+__attribute__((format(printf, 3, 4)))
+static int parse_fail(char *err, size_t errsize, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(err, errsize, fmt, ap);
+    va_end(ap);
+    return -1;
+}
+
+int shell_parse(const char *line, struct shell_pipeline *pl, char *err, size_t errsize) {
+    memset(pl, 0, sizeof(*pl));
+    size_t used = 0;
+    const char *redirect = NULL;    // 파일 이름을 기다리는 연산자 ("<", ">", ">>")
+    struct shell_stage *stage = &pl->stages[0];
+    const char *p = line;
+
+    for (;;) {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+        if (*p == '\0') break;
+
+        if (is_operator(*p)) {
+            if (redirect)
+                return parse_fail(err, errsize, "'%s' 뒤에 파일 이름이 없습니다", redirect);
+            if (*p == '|') {
+                if (stage->argc == 0)
+                    return parse_fail(err, errsize, "'%s' 앞에 명령이 없습니다", "|");
+                if (pl->output)
+                    return parse_fail(err, errsize, "'%s'는 마지막 명령에만 쓸 수 있습니다",
+                                      pl->append ? ">>" : ">");
+                if (pl->count + 1 >= SHELL_MAX_STAGES)
+                    return parse_fail(err, errsize, "파이프라인 단계가 너무 많습니다");
+                stage = &pl->stages[++pl->count];
+                p++;
+            } else if (*p == '<') {
+                if (pl->count > 0)
+                    return parse_fail(err, errsize, "'%s'는 첫 명령에만 쓸 수 있습니다", "<");
+                if (pl->input)
+                    return parse_fail(err, errsize, "'%s' 리디렉션이 중복되었습니다", "<");
+                redirect = "<";
+                p++;
+            } else {
+                if (pl->output)
+                    return parse_fail(err, errsize, "'%s' 리디렉션이 중복되었습니다", ">");
+                redirect = p[1] == '>' ? ">>" : ">";
+                p += strlen(redirect);
+            }
+            continue;
+        }
+
+        // 단어: 따옴표 안은 그대로, 밖에서는 공백이나 연산자에서 끝남
+        char *word = pl->text + used;
+        char quote = 0;
+        while (*p && (quote || (!is_operator(*p) && *p != ' ' && *p != '\t' &&
+                                *p != '\n' && *p != '\r'))) {
+            if (quote && *p == quote) quote = 0;
+            else if (!quote && (*p == '\'' || *p == '"')) quote = *p;
+            else {
+                if (used + 1 >= sizeof(pl->text))
+                    return parse_fail(err, errsize, "명령이 너무 깁니다");
+                pl->text[used++] = *p;
+            }
+            p++;
+        }
+        if (quote)
+            return parse_fail(err, errsize, "따옴표가 닫히지 않았습니다");
+        pl->text[used++] = '\0';
+
+        if (redirect) {
+            if (redirect[0] == '<') {
+                pl->input = word;
+            } else {
+                pl->output = word;
+                pl->append = redirect[1] == '>';
+            }
+            redirect = NULL;
+        } else {
+            if (stage->argc >= SHELL_MAX_ARGS)
+                return parse_fail(err, errsize, "인자가 너무 많습니다");
+            stage->argv[stage->argc++] = word;
+        }
+    }
+
+    if (redirect)
+        return parse_fail(err, errsize, "'%s' 뒤에 파일 이름이 없습니다", redirect);
+    if (stage->argc == 0) {
+        if (pl->count > 0)
+            return parse_fail(err, errsize, "'%s' 뒤에 명령이 없습니다", "|");
+        if (pl->input || pl->output)
+            return parse_fail(err, errsize, "리디렉션할 명령이 없습니다");
+        return 0;   // 빈 줄
+    }
+    pl->count++;
+    return 0;
+}
+
+// ---- 실행 ----
+
+struct stage_run {
+    const struct shell_builtin *builtin;    // NULL이면 외부 프로그램
+    const struct shell_stage *stage;
+    pid_t pid;                              // 외부 프로그램 (-1이면 띄우지 못함)
+    pthread_t thread;
+    int started;
+    int in_fd, out_fd;                      // -1이면 쉘의 stdin/stdout
+    int status;
+};
+
+static void *builtin_stage_main(void *arg) {
+    struct stage_run *run = arg;
+
+    // 읽는 쪽이 먼저 끝나면 프로세스 전체가 SIGPIPE로 죽지 않고 쓰기가 EPIPE로 실패하게 함
+    sigset_t pipe_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, NULL);
+
+    // 입력을 읽지 않는 빌트인은 바로 닫아 앞 단계가 막히지 않고 EPIPE/SIGPIPE로 끝나게 함
+    if (run->in_fd != -1 && !(run->builtin->flags & SHELL_BUILTIN_STDIN)) {
+        close(run->in_fd);
+        run->in_fd = -1;
+    }
+    stage_input = run->in_fd;
+
+    FILE *out = NULL;
+    if (run->out_fd != -1) {
+        out = fdopen(run->out_fd, "w");
+        if (!out) {
+            perror("fdopen");
+            close(run->out_fd);
+            if (run->in_fd != -1) close(run->in_fd);
+            run->status = 1;
+            return NULL;
+        }
+        shell_set_output(out);
+    }
+
+    run->status = run->builtin->fn(run->stage->argc, run->stage->argv);
+
+    if (out) {
+        shell_set_output(NULL);
+        fclose(out);
+    } else {
+        fflush(stdout);
+    }
+    if (run->in_fd != -1) close(run->in_fd);
+    return NULL;
+}
+
+static int open_redirect(const char *path, int flags) {
+    char abs_path[MAX_PATH_SIZE];
+    get_absolute_path(current_dir, path, abs_path);
+    if (!is_within_base_dir(abs_path)) {
+        printf("오류: %s 외부의 파일로 리디렉션할 수 없습니다\n", BASE_DIR);
+        return -1;
+    }
+    int fd = open(abs_path, flags | O_CLOEXEC, DEFAULT_FILE_MODE);
+    if (fd == -1) perror(path);
+    return fd;
+}
+
+static int wait_status(pid_t pid) {
+    int status;
+    while (waitpid(pid, &status, 0) == -1) {
+        if (errno != EINTR) return 1;
+    }
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
+    if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    return 1;
+}
+
+int shell_run_pipeline(const struct shell_pipeline *pl) {
+    if (pl->count == 0) return 0;
+
+    struct stage_run runs[SHELL_MAX_STAGES];
+    memset(runs, 0, sizeof(runs));
+    for (int i = 0; i < pl->count; i++) {
+        runs[i].stage = &pl->stages[i];
+        runs[i].builtin = shell_find_builtin(pl->stages[i].argv[0]);
+        runs[i].pid = -1;
+    }
+
+    // 리디렉션도 파이프도 없는 빌트인은 쉘 스레드에서 그대로 실행 (cd 등이 상태를 바꿀 수 있음)
+    if (pl->count == 1 && !pl->input && !pl->output && runs[0].builtin)
+        return runs[0].builtin->fn(runs[0].stage->argc, runs[0].stage->argv);
+
+    for (int i = 0; i < pl->count; i++) {
+        if (runs[i].builtin && !(runs[i].builtin->flags & SHELL_BUILTIN_STREAM)) {
+            printf("%s: 파이프라인이나 리디렉션에서 쓸 수 없는 명령입니다\n", runs[i].builtin->name);
+            return 1;
+        }
+    }
+
+    int in_fd = -1, out_file = -1;
+    if (pl->input && (in_fd = open_redirect(pl->input, O_RDONLY)) == -1)
+        return 1;
+    if (pl->output) {
+        int flags = O_WRONLY | O_CREAT | (pl->append ? O_APPEND : O_TRUNC);
+        if ((out_file = open_redirect(pl->output, flags)) == -1) {
+            if (in_fd != -1) close(in_fd);
+            return 1;
+        }
+    }
+
+    // 쉘의 stdout에 남은 내용이 단계들의 출력보다 늦게 나가지 않도록
+    fflush(stdout);
+
+    for (int i = 0; i < pl->count; i++) {
+        struct stage_run *run = &runs[i];
+        int next_in = -1;
+        run->in_fd = in_fd;
+        run->out_fd = i + 1 < pl->count ? -1 : out_file;
+        if (i + 1 < pl->count) {
+            int p[2];
+            if (pipe2(p, O_CLOEXEC) == -1) {
+                perror("pipe2");
+                if (in_fd != -1) close(in_fd);
+                if (out_file != -1) close(out_file);
+                run->status = 1;
+                for (int j = i + 1; j < pl->count; j++) runs[j].status = 1;
+                break;
+            }
+            run->out_fd = p[1];
+            next_in = p[0];
+        }
+
+        if (run->builtin) {
+            // 스레드가 in_fd/out_fd를 넘겨받아 닫음
+            if (pthread_create(&run->thread, NULL, builtin_stage_main, run) == 0) {
+                run->started = 1;
+            } else {
+                printf("%s: 스레드를 만들 수 없습니다\n", run->builtin->name);
+                if (run->in_fd != -1) close(run->in_fd);
+                if (run->out_fd != -1) close(run->out_fd);
+                run->status = 1;
+            }
+        } else {
+            const int fds[3] = { run->in_fd, run->out_fd, -1 };
+            if (job_spawn_fds(run->stage->argv[0], run->stage->argv, current_dir, fds, 0,
+                              &run->pid) == -1) {
+                printf("%s: %s\n", run->stage->argv[0], strerror(errno));
+                run->pid = -1;
+                run->status = SHELL_NOT_FOUND;
+            }
+            if (run->in_fd != -1) close(run->in_fd);
+            if (run->out_fd != -1) close(run->out_fd);
+        }
+
+        in_fd = next_in;
+    }
+
+    for (int i = 0; i < pl->count; i++) {
+        if (runs[i].builtin && runs[i].started) pthread_join(runs[i].thread, NULL);
+        else if (!runs[i].builtin && runs[i].pid > 0) runs[i].status = wait_status(runs[i].pid);
+    }
+    return runs[pl->count - 1].status;
+}
+
+int shell_execute(const char *line) {
+    static struct shell_pipeline pl;    // 쉘 스레드 하나만 씀
+    char err[128];
+
+    if (shell_parse(line, &pl, err, sizeof(err)) == -1) {
+        printf("구문 오류: %s\n", err);
+        return SHELL_SYNTAX_ERROR;
+    }
+    return shell_run_pipeline(&pl);
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+int shell_run_batch(FILE *in, const char *name, int flags, struct shell_batch_stats *stats) {
+    static struct shell_pipeline pl;
+    char err[128];
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    unsigned long lineno = 0;
+    int status = 0;
+    struct timespec start, end, cmd_start;
+
+    memset(stats, 0, sizeof(*stats));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while ((len = getline(&line, &cap, in)) != -1) {
+        lineno++;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) line[--len] = '\0';
+        const char *p = line + strspn(line, " \t");
+        if (*p == '\0' || *p == '#') continue;
+
+        if (len >= SHELL_LINE_SIZE) {
+            printf("%s:%lu: 줄이 너무 깁니다 (최대 %d바이트)\n", name, lineno, SHELL_LINE_SIZE - 1);
+            status = SHELL_SYNTAX_ERROR;
+        } else if (shell_parse(p, &pl, err, sizeof(err)) == -1) {
+            printf("%s:%lu: 구문 오류: %s\n", name, lineno, err);
+            status = SHELL_SYNTAX_ERROR;
+        } else {
+            if (flags & SHELL_BATCH_TIMING) clock_gettime(CLOCK_MONOTONIC, &cmd_start);
+            status = shell_run_pipeline(&pl);
+            if (status == SHELL_EXIT) {
+                status = 0;
+                break;
+            }
+            if (flags & SHELL_BATCH_TIMING) {
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                fflush(stdout);
+                fprintf(stderr, "[%9.3f ms] %s\n", elapsed_ms(&cmd_start, &end), p);
+            }
+        }
+
+        stats->commands++;
+        if (status != 0) {
+            stats->failed++;
+            if (flags & SHELL_BATCH_STOP_ERROR) break;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    stats->elapsed_ms = elapsed_ms(&start, &end);
+    free(line);
+    fflush(stdout);
+    return status;
+}
+
+static void batch_usage(void) {
+    fprintf(stderr, "사용법: myshell [-t] [-s] [-e] (-c \"명령\" | 스크립트.fsh | -)\n");
+}
+
+int shell_batch_main(int argc, char **argv) {
+    const char *command = NULL, *script = NULL;
+    int flags = 0, summary = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0) {
+            if (i + 1 >= argc) {
+                batch_usage();
+                return SHELL_SYNTAX_ERROR;
+            }
+            command = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0) {
+            flags |= SHELL_BATCH_TIMING;
+            summary = 1;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            summary = 1;
+        } else if (strcmp(argv[i], "-e") == 0) {
+            flags |= SHELL_BATCH_STOP_ERROR;
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            script = argv[i];
+        } else {
+            return SHELL_NOT_BATCH;     // 모르는 옵션은 호출한 쪽(Qt 등)에 맡김
+        }
+    }
+    if (!command && !script) return SHELL_NOT_BATCH;
+    if (command && script) {
+        batch_usage();
+        return SHELL_SYNTAX_ERROR;
+    }
+
+    // 스크립트는 BASE_DIR로 옮기기 전에 열어야 상대 경로가 호출한 위치 기준이 됨.
+    // -c 문자열도 같은 경로로 돌리므로 줄바꿈으로 여러 명령을 줄 수 있음
+    FILE *in;
+    const char *name;
+    if (command) {
+        in = fmemopen((void *)command, strlen(command), "r");
+        name = "-c";
+    } else if (strcmp(script, "-") == 0) {
+        in = stdin;
+        name = "stdin";
+    } else {
+        in = fopen(script, "re");
+        name = script;
+    }
+    if (!in) {
+        perror(command ? "fmemopen" : script);
+        return SHELL_NOT_FOUND;
+    }
+
+    mkdir(BASE_DIR, DEFAULT_DIR_MODE);
+    if (ENABLE_CHROOT && setup_chroot(BASE_DIR) != 0) {
+        fprintf(stderr, "Failed to setup chroot environment\n");
+        if (in != stdin) fclose(in);
+        return 1;
+    }
+
+    struct shell_batch_stats stats;
+    int status = shell_run_batch(in, name, flags, &stats);
+    if (in != stdin) fclose(in);
+
+    if (summary) {
+        double sec = stats.elapsed_ms / 1000.0;
+        fprintf(stderr, "명령 %lu개 (실패 %lu개), %.3f초, %.0f 명령/s\n",
+                stats.commands, stats.failed, sec, sec > 0 ? stats.commands / sec : 0.0);
+    }
+    return status;
+}
+
+void run_terminal(void) {
+    char *command = (char *)malloc(SHELL_LINE_SIZE);
+    if (!command) {
+        perror("malloc");
+        return;
+    }
+
+    while (1) {
+        interrupted = 0;
+        printf("%s $ ", current_dir);
+        fflush(stdout);
+
+        if (!fgets(command, SHELL_LINE_SIZE, stdin)) {
+            if (interrupted) {
+                clearerr(stdin);
+                continue;
+            }
+            break;
+        }
+
+        if (shell_execute(command) == SHELL_EXIT) break;
+    }
+
+    free(command);
+}
@@ -0,0 +1,359 @@
+#define _GNU_SOURCE
+#include "../include/shmring.h"
+#include "../include/config.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SHM_RING_MAGIC      0x474e4952u     // "RING"
+#define SHM_RING_VERSION    1
+
+// 매핑 앞부분. 자주 쓰는 값은 쓰는 쪽끼리 모아 캐시 라인을 나눔:
+// 읽기 전용 설정 / 소비자(head) / 생산자(tail) / 깨우기용 카운터
+struct shm_ring_shared {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t slot_size;
+    uint32_t msg_max;
+    uint32_t flags;
+
+    _Alignas(SHM_RING_CACHELINE) _Atomic uint64_t head;
+    _Alignas(SHM_RING_CACHELINE) _Atomic uint64_t tail;
+
+    // 데이터가 들어왔음을 알리는 이벤트 (소비자가 잠듦)
+    _Alignas(SHM_RING_CACHELINE) _Atomic uint32_t data_event;
+    _Atomic uint32_t data_waiters;
+    _Atomic uint64_t consumer_sleeps;
+
+    // 자리가 났음을 알리는 이벤트 (생산자들이 잠듦)
+    _Alignas(SHM_RING_CACHELINE) _Atomic uint32_t space_event;
+    _Atomic uint32_t space_waiters;
+    _Atomic uint64_t producer_sleeps;
+};
+
+_Static_assert(offsetof(struct shm_ring_shared, tail) - offsetof(struct shm_ring_shared, head)
+               >= SHM_RING_CACHELINE, "head와 tail은 다른 캐시 라인에 있어야 함");
+
+// 슬롯: seq == 위치이면 비어 있어 그 위치의 생산자가 쓸 수 있고,
+// seq == 위치 + 1이면 채워져 소비자가 읽을 수 있음 (읽은 뒤 위치 + capacity로 돌려놓음)
+struct shm_ring_slot {
+    _Atomic uint64_t seq;
+    uint32_t len;
+    uint32_t reserved;
+    unsigned char data[];
+};
+
+static size_t header_size(void) {
+    return (sizeof(struct shm_ring_shared) + SHM_RING_CACHELINE - 1) & ~(size_t)(SHM_RING_CACHELINE - 1);
+}
+
+static struct shm_ring_slot *slot_at(const struct shm_ring *ring, uint64_t pos) {
+    return (struct shm_ring_slot *)(ring->slots + (size_t)(pos & ring->mask) * ring->slot_size);
+}
+
+// CPU가 하나면 상대가 돌 수 없으므로 돌며 기다리지 않고 바로 잠듦
+static int spin_limit(void) {
+    static int limit = -1;      // 어느 스레드가 계산해도 같은 값이라 relaxed로 충분
+    int cached = __atomic_load_n(&limit, __ATOMIC_RELAXED);
+    if (cached < 0) {
+        cached = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SHM_RING_SPIN : 0;
+        __atomic_store_n(&limit, cached, __ATOMIC_RELAXED);
+    }
+    return cached;
+}
+
+static void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// 공유 매핑이므로 FUTEX_PRIVATE_FLAG 없이 씀 (다른 프로세스와 같은 futex)
+static int futex_wait(_Atomic uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    return syscall(SYS_futex, addr, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+static void futex_wake(_Atomic uint32_t *addr, int count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+static int map_ring(struct shm_ring *ring, int fd, size_t size) {
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) return -1;
+    ring->shared = base;
+    ring->slots = (unsigned char *)base + header_size();
+    ring->map_size = size;
+    return 0;
+}
+
+int shm_ring_create(struct shm_ring *ring, const char *path, uint32_t capacity,
+                    uint32_t msg_max, int flags) {
+    memset(ring, 0, sizeof(*ring));
+    if (capacity < 2 || capacity > (1u << 24) || msg_max == 0 || msg_max > (1u << 20)) {
+        errno = EINVAL;
+        return -1;
+    }
+    uint32_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+
+    // 슬롯을 캐시 라인 단위로 맞춰 이웃한 슬롯을 쓰는 생산자와 소비자가 같은 줄을 공유하지 않게 함
+    size_t slot_size = (sizeof(struct shm_ring_slot) + msg_max + SHM_RING_CACHELINE - 1) &
+                       ~(size_t)(SHM_RING_CACHELINE - 1);
+    size_t size = header_size() + (size_t)cap * slot_size;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, DEFAULT_FILE_MODE);
+    if (fd == -1) return -1;
+    // 이전 내용을 지우고 새 크기로 (남아 있던 슬롯 seq가 섞이지 않게)
+    if (ftruncate(fd, 0) == -1 || ftruncate(fd, (off_t)size) == -1 || map_ring(ring, fd, size) == -1) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    close(fd);
+
+    struct shm_ring_shared *s = ring->shared;
+    s->capacity = cap;
+    s->slot_size = (uint32_t)slot_size;
+    s->msg_max = msg_max;
+    s->flags = flags;
+    atomic_init(&s->head, 0);
+    atomic_init(&s->tail, 0);
+    ring->mask = cap - 1;
+    ring->slot_size = (uint32_t)slot_size;
+    ring->msg_max = msg_max;
+    ring->flags = flags;
+    for (uint32_t i = 0; i < cap; i++)
+        atomic_init(&slot_at(ring, i)->seq, i);
+
+    // 다른 프로세스는 magic을 보고 초기화가 끝났는지 판단
+    s->version = SHM_RING_VERSION;
+    atomic_thread_fence(memory_order_release);
+    s->magic = SHM_RING_MAGIC;
+    return 0;
+}
+
+int shm_ring_open(struct shm_ring *ring, const char *path) {
+    memset(ring, 0, sizeof(*ring));
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd == -1) return -1;
+
+    struct stat st;
+    int rc = fstat(fd, &st);
+    if (rc == 0 && (size_t)st.st_size < header_size()) {
+        errno = EINVAL;
+        rc = -1;
+    }
+    if (rc == 0) rc = map_ring(ring, fd, (size_t)st.st_size);
+    int saved = errno;
+    close(fd);    // 매핑은 fd를 닫아도 남음
+    if (rc == -1) {
+        errno = saved;
+        return -1;
+    }
+
+    struct shm_ring_shared *s = ring->shared;
+    atomic_thread_fence(memory_order_acquire);
+    if (s->magic != SHM_RING_MAGIC || s->version != SHM_RING_VERSION ||
+        header_size() + (size_t)s->capacity * s->slot_size > ring->map_size) {
+        shm_ring_close(ring);
+        errno = EINVAL;
+        return -1;
+    }
+    ring->mask = s->capacity - 1;
+    ring->slot_size = s->slot_size;
+    ring->msg_max = s->msg_max;
+    ring->flags = (int)s->flags;
+    return 0;
+}
+
+void shm_ring_close(struct shm_ring *ring) {
+    if (ring->shared) munmap(ring->shared, ring->map_size);
+    memset(ring, 0, sizeof(*ring));
+}
+
+int shm_ring_try_send(struct shm_ring *ring, const void *msg, size_t len) {
+    struct shm_ring_shared *s = ring->shared;
+    if (len > ring->msg_max) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    struct shm_ring_slot *slot;
+    uint64_t pos = atomic_load_explicit(&s->tail, memory_order_relaxed);
+    for (;;) {
+        slot = slot_at(ring, pos);
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (!(ring->flags & SHM_RING_MPSC)) {
+                atomic_store_explicit(&s->tail, pos + 1, memory_order_relaxed);
+                break;
+            }
+            if (atomic_compare_exchange_weak_explicit(&s->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            errno = EAGAIN;     // 소비자가 아직 한 바퀴 전 메시지를 읽지 않음
+            return -1;
+        } else {
+            pos = atomic_load_explicit(&s->tail, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->data, msg, len);
+    slot->len = (uint32_t)len;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+
+    // 소비자가 대기 카운터를 올린 뒤 링을 다시 확인하므로, 둘 중 하나는 반드시 상대를 봄
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&s->data_waiters, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&s->data_event, 1, memory_order_relaxed);
+        futex_wake(&s->data_event, 1);
+    }
+    return 0;
+}
+
+ssize_t shm_ring_try_recv(struct shm_ring *ring, void *buf, size_t size) {
+    struct shm_ring_shared *s = ring->shared;
+    uint64_t pos = atomic_load_explicit(&s->head, memory_order_relaxed);
+    struct shm_ring_slot *slot = slot_at(ring, pos);
+    uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if ((int64_t)(seq - (pos + 1)) < 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    size_t len = slot->len < size ? slot->len : size;
+    memcpy(buf, slot->data, len);
+    atomic_store_explicit(&slot->seq, pos + ring->mask + 1, memory_order_release);
+    atomic_store_explicit(&s->head, pos + 1, memory_order_relaxed);
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&s->space_waiters, memory_order_relaxed)) {
+        // 한 칸 날 때마다 깨우면 생산자가 한 개 쓰고 다시 잠들기를 반복하므로, 절반이 빌 때
+        // 한꺼번에 깨움. 생산자는 가득 찬 것을 보고 잠들었으니 절반까지는 반드시 읽게 됨
+        uint64_t used = atomic_load_explicit(&s->tail, memory_order_relaxed) - (pos + 1);
+        if (used <= (ring->mask + 1) / 2) {
+            atomic_fetch_add_explicit(&s->space_event, 1, memory_order_relaxed);
+            futex_wake(&s->space_event, INT_MAX);
+        }
+    }
+    return (ssize_t)len;
+}
+
+// deadline까지 남은 시간. 이미 지났으면 0
+static int remaining(const struct timespec *deadline, struct timespec *left) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    left->tv_sec = deadline->tv_sec - now.tv_sec;
+    left->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if (left->tv_nsec < 0) {
+        left->tv_sec--;
+        left->tv_nsec += 1000000000L;
+    }
+    return left->tv_sec >= 0;
+}
+
+static void make_deadline(int timeout_ms, struct timespec *deadline) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+// 한 번 시도하는 함수 (성공하면 0 이상, 기다려야 하면 -1과 EAGAIN)
+typedef ssize_t (*ring_attempt_fn)(struct shm_ring *ring, void *arg);
+
+// 이벤트 카운트 대기: 잠시 다시 시도해 보고, 이벤트 값을 읽고, 대기자로 등록한 뒤 한 번 더
+// 시도하고, 그래도 안 되면 그 값에서 잠듦. 등록과 상대의 확인 사이에 seq_cst 울타리가 있어
+// 상대는 등록을 보거나 우리가 상대의 변경을 보므로 깨우기를 놓치지 않음
+static ssize_t ring_wait(struct shm_ring *ring, ring_attempt_fn attempt, void *arg,
+                         _Atomic uint32_t *event, _Atomic uint32_t *waiters,
+                         _Atomic uint64_t *sleeps, int timeout_ms) {
+    struct timespec deadline, left;
+    if (timeout_ms >= 0) make_deadline(timeout_ms, &deadline);
+
+    for (;;) {
+        for (int spin = 0, limit = spin_limit(); spin < limit; spin++) {
+            ssize_t rc = attempt(ring, arg);
+            if (rc != -1 || errno != EAGAIN) return rc;
+            cpu_relax();
+        }
+
+        uint32_t seen = atomic_load_explicit(event, memory_order_relaxed);
+        atomic_fetch_add_explicit(waiters, 1, memory_order_seq_cst);
+        ssize_t rc = attempt(ring, arg);
+        if (rc != -1 || errno != EAGAIN) {
+            atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+            return rc;
+        }
+        if (timeout_ms >= 0 && !remaining(&deadline, &left)) {
+            atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        atomic_fetch_add_explicit(sleeps, 1, memory_order_relaxed);
+        futex_wait(event, seen, timeout_ms >= 0 ? &left : NULL);
+        atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+    }
+}
+
+struct send_args {
+    const void *msg;
+    size_t len;
+};
+
+static ssize_t attempt_send(struct shm_ring *ring, void *arg) {
+    struct send_args *a = arg;
+    return shm_ring_try_send(ring, a->msg, a->len);
+}
+
+struct recv_args {
+    void *buf;
+    size_t size;
+};
+
+static ssize_t attempt_recv(struct shm_ring *ring, void *arg) {
+    struct recv_args *a = arg;
+    return shm_ring_try_recv(ring, a->buf, a->size);
+}
+
+int shm_ring_send(struct shm_ring *ring, const void *msg, size_t len, int timeout_ms) {
+    struct shm_ring_shared *s = ring->shared;
+    struct send_args args = { msg, len };
+    return (int)ring_wait(ring, attempt_send, &args, &s->space_event, &s->space_waiters,
+                          &s->producer_sleeps, timeout_ms);
+}
+
+ssize_t shm_ring_recv(struct shm_ring *ring, void *buf, size_t size, int timeout_ms) {
+    struct shm_ring_shared *s = ring->shared;
+    struct recv_args args = { buf, size };
+    return ring_wait(ring, attempt_recv, &args, &s->data_event, &s->data_waiters,
+                     &s->consumer_sleeps, timeout_ms);
+}
+
+void shm_ring_get_stats(const struct shm_ring *ring, struct shm_ring_stats *stats) {
+    struct shm_ring_shared *s = ring->shared;
+    stats->capacity = ring->mask + 1;
+    stats->msg_max = ring->msg_max;
+    stats->sent = atomic_load_explicit(&s->tail, memory_order_relaxed);
+    stats->received = atomic_load_explicit(&s->head, memory_order_relaxed);
+    stats->producer_sleeps = atomic_load_explicit(&s->producer_sleeps, memory_order_relaxed);
+    stats->consumer_sleeps = atomic_load_explicit(&s->consumer_sleeps, memory_order_relaxed);
+}
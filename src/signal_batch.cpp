@@ -0,0 +1,129 @@
+#include "../include/signal_batch.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+SignalBatch::SignalBatch(const QVector<Target> &list, QObject *parent) : QObject(parent)
+{
+    targets.resize(list.size());
+    for (int i = 0; i < list.size(); ++i)
+        pid_target_init(&targets[i], list[i].pid, list[i].starttime);
+
+    escalateTimer.setSingleShot(true);
+    deadline.setSingleShot(true);
+    connect(&escalateTimer, &QTimer::timeout, this, [this]() { escalate(); });
+    connect(&deadline, &QTimer::timeout, this, [this]() { finish(); });
+    connect(&pollTimer, &QTimer::timeout, this, [this]() { poll(); });
+}
+
+SignalBatch::~SignalBatch()
+{
+    pid_batch_close(targets.data(), targets.size());
+}
+
+void SignalBatch::start(int sig, bool waitForExit, int escalateMs)
+{
+    sentSignal = sig;
+    waiting = waitForExit;
+    pid_batch_signal(targets.data(), targets.size(), sig);
+    for (const struct pid_target &t : targets) {
+        if (t.state == PID_TARGET_FAILED && t.error != ESRCH && firstError.isEmpty())
+            firstError = tr("PID %1: %2").arg(t.pid).arg(QString::fromLocal8Bit(strerror(t.error)));
+    }
+
+    if (!waitForExit) {
+        finish();
+        return;
+    }
+
+    pollTimer.start(POLL_INTERVAL_MS);
+    if (escalateMs > 0 && sig != SIGKILL)
+        escalateTimer.start(escalateMs);
+    else
+        deadline.start(DEFAULT_WAIT_MS);
+    checkDone();
+}
+
+void SignalBatch::poll()
+{
+    int before = aliveCount();
+    // 시간 제한 0: 끝난 대상만 EXITED로 바꾸고 바로 돌아옴
+    pid_batch_wait(targets.data(), targets.size(), 0);
+    if (aliveCount() != before) {
+        emit progress();
+        checkDone();
+    }
+}
+
+void SignalBatch::escalate()
+{
+    killSent = true;
+    for (struct pid_target &t : targets) {
+        if (t.state == PID_TARGET_ALIVE)
+            pid_target_signal(&t, SIGKILL);
+    }
+    emit progress();
+    deadline.start(KILL_WAIT_MS);
+    checkDone();
+}
+
+void SignalBatch::checkDone()
+{
+    if (!done && aliveCount() == 0)
+        finish();
+}
+
+void SignalBatch::finish()
+{
+    if (done) return;
+    done = true;
+    escalateTimer.stop();
+    deadline.stop();
+    pollTimer.stop();
+    emit finished();
+}
+
+int SignalBatch::exitedCount() const
+{
+    int n = 0;
+    for (const struct pid_target &t : targets) {
+        // ESRCH: 목록을 읽은 뒤 끝났거나 pid가 재사용됨
+        if (t.state == PID_TARGET_EXITED || (t.state == PID_TARGET_FAILED && t.error == ESRCH))
+            ++n;
+    }
+    return n;
+}
+
+int SignalBatch::failedCount() const
+{
+    int n = 0;
+    for (const struct pid_target &t : targets) {
+        if (t.state == PID_TARGET_FAILED && t.error != ESRCH)
+            ++n;
+    }
+    return n;
+}
+
+int SignalBatch::aliveCount() const
+{
+    int n = 0;
+    for (const struct pid_target &t : targets) {
+        if (t.state == PID_TARGET_ALIVE)
+            ++n;
+    }
+    return n;
+}
+
+QString SignalBatch::summary() const
+{
+    const char *name = signal_name(sentSignal);
+    QString signalText = name ? QStringLiteral("SIG") + QLatin1String(name) : QString::number(sentSignal);
+    QString text = waiting ? tr("프로세스 %1개에 %2: 종료 %3개, 실행 중 %4개")
+                             .arg(total()).arg(signalText).arg(exitedCount()).arg(aliveCount())
+                           : tr("프로세스 %1개에 %2 보냄").arg(total() - failedCount()).arg(signalText);
+    if (killSent)
+        text += tr(" (SIGKILL로 올림)");
+    if (failedCount() > 0)
+        text += tr(", 실패 %1개 (%2)").arg(failedCount()).arg(firstError);
+    return text;
+}
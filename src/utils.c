@@ -9,8 +9,52 @@
 #include <errno.h>
 #include <limits.h>
 #include <grp.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <linux/openat2.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "../include/commands.h"
 
-void print_permissions(struct stat *file_stat) {
+#define ID_CACHE_SLOTS       1024   // 2의 거듭제곱
+#define TIME_CACHE_SLOTS     16
+#define OUT_BUF_FLUSH_SIZE   (256 * 1024)
+
+// uid/gid -> 이름 캐시 (passwd/group 파일이 바뀌면 무효화)
+struct id_cache_slot {
+    unsigned int id;
+    int used;
+    char name[ID_NAME_MAX];
+};
+
+struct id_cache {
+    struct id_cache_slot slots[ID_CACHE_SLOTS];
+    size_t used;
+    const char *source;      // 변경 감시 대상 파일
+    dev_t dev;
+    ino_t ino;
+    struct timespec mtime;
+    off_t size;
+    time_t checked_at;       // 마지막으로 파일을 확인한 시각 (초 단위로 제한)
+};
+
+static struct id_cache user_cache = { .source = "/etc/passwd" };
+static struct id_cache group_cache = { .source = "/etc/group" };
+static pthread_mutex_t id_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 하루 단위 날짜 캐시: 같은 날의 시각은 strftime 없이 초 단위 연산으로 포맷
+struct day_cache_slot {
+    time_t start;            // 그날 00:00:00 (지역 시간)
+    char date[16];           // "YYYY-MM-DD"
+    int valid;
+};
+
+static __thread struct day_cache_slot day_cache[TIME_CACHE_SLOTS];
+
+void format_permissions(const struct stat *file_stat, char *buf) {
     char type = '-';
     if (S_ISDIR(file_stat->st_mode)) type = 'd';
     else if (S_ISLNK(file_stat->st_mode)) type = 'l';
@@ -19,23 +63,37 @@ void print_permissions(struct stat *file_stat) {
     else if (S_ISBLK(file_stat->st_mode)) type = 'b';
     else if (S_ISSOCK(file_stat->st_mode)) type = 's';
 
-    printf("%c%c%c%c%c%c%c%c%c%c",
-        type,
-        (file_stat->st_mode & S_IRUSR) ? 'r' : '-',
-        (file_stat->st_mode & S_IWUSR) ? 'w' : '-',
-        (file_stat->st_mode & S_IXUSR) ? 'x' : '-',
-        (file_stat->st_mode & S_IRGRP) ? 'r' : '-',
-        (file_stat->st_mode & S_IWGRP) ? 'w' : '-',
-        (file_stat->st_mode & S_IXGRP) ? 'x' : '-',
-        (file_stat->st_mode & S_IROTH) ? 'r' : '-',
-        (file_stat->st_mode & S_IWOTH) ? 'w' : '-',
-        (file_stat->st_mode & S_IXOTH) ? 'x' : '-');
+    buf[0] = type;
+    buf[1] = (file_stat->st_mode & S_IRUSR) ? 'r' : '-';
+    buf[2] = (file_stat->st_mode & S_IWUSR) ? 'w' : '-';
+    buf[3] = (file_stat->st_mode & S_IXUSR) ? 'x' : '-';
+    buf[4] = (file_stat->st_mode & S_IRGRP) ? 'r' : '-';
+    buf[5] = (file_stat->st_mode & S_IWGRP) ? 'w' : '-';
+    buf[6] = (file_stat->st_mode & S_IXGRP) ? 'x' : '-';
+    buf[7] = (file_stat->st_mode & S_IROTH) ? 'r' : '-';
+    buf[8] = (file_stat->st_mode & S_IWOTH) ? 'w' : '-';
+    buf[9] = (file_stat->st_mode & S_IXOTH) ? 'x' : '-';
+    buf[10] = '\0';
+}
+
+void print_permissions(struct stat *file_stat) {
+    char buf[11];
+    format_permissions(file_stat, buf);
+    printf("%s", buf);
+}
+
+size_t format_time(const time_t *time, char *buf, size_t size) {
+    struct tm tm_info;
+    if (!localtime_r(time, &tm_info)) {
+        buf[0] = '\0';
+        return 0;
+    }
+    return strftime(buf, size, "%Y-%m-%d %H:%M:%S", &tm_info);
 }
 
 void print_time(const time_t *time) {
-    struct tm *tm_info = localtime(time);
     char buffer[26];
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm_info);
+    format_time(time, buffer, sizeof(buffer));
     printf(" %s", buffer);
 }
 
@@ -117,11 +175,342 @@ int setup_chroot(const char *path) {
 }
 
 void print_user_group(uid_t uid, gid_t gid) {
-    struct passwd *pw = getpwuid(uid);
-    struct group *gr = getgrgid(gid);
-    
-    const char *user_str = pw ? pw->pw_name : "unknown";
-    const char *group_str = gr ? gr->gr_name : "unknown";
+    char user_str[ID_NAME_MAX];
+    char group_str[ID_NAME_MAX];
+
+    uid_to_name(uid, user_str);
+    gid_to_name(gid, group_str);
     
     printf(" %s %s", user_str, group_str);
-}
\ No newline at end of file
+}
+
+static void id_cache_revalidate(struct id_cache *c) {
+    time_t now = time(NULL);
+    if (now == c->checked_at) return;
+    c->checked_at = now;
+
+    struct stat st;
+    if (stat(c->source, &st) == -1) return;
+    if (st.st_dev == c->dev && st.st_ino == c->ino && st.st_size == c->size &&
+        st.st_mtim.tv_sec == c->mtime.tv_sec && st.st_mtim.tv_nsec == c->mtime.tv_nsec)
+        return;
+
+    // 파일이 바뀌었으므로 캐시를 비움
+    memset(c->slots, 0, sizeof(c->slots));
+    c->used = 0;
+    c->dev = st.st_dev;
+    c->ino = st.st_ino;
+    c->size = st.st_size;
+    c->mtime = st.st_mtim;
+}
+
+static struct id_cache_slot *id_cache_find(struct id_cache *c, unsigned int id, int *found) {
+    unsigned int h = (id * 2654435761u) & (ID_CACHE_SLOTS - 1);
+    for (unsigned int i = 0; i < ID_CACHE_SLOTS; i++) {
+        struct id_cache_slot *slot = &c->slots[(h + i) & (ID_CACHE_SLOTS - 1)];
+        if (!slot->used) {
+            *found = 0;
+            return slot;
+        }
+        if (slot->id == id) {
+            *found = 1;
+            return slot;
+        }
+    }
+    *found = 0;
+    return NULL;
+}
+
+static void id_cache_lookup(struct id_cache *c, unsigned int id, int is_group, char *out) {
+    pthread_mutex_lock(&id_cache_lock);
+    id_cache_revalidate(c);
+
+    int found;
+    struct id_cache_slot *slot = id_cache_find(c, id, &found);
+    if (found) {
+        memcpy(out, slot->name, ID_NAME_MAX);
+        pthread_mutex_unlock(&id_cache_lock);
+        return;
+    }
+
+    // 캐시 미스: NSS 조회 (없는 id도 "unknown"으로 캐시)
+    char buf[4096];
+    const char *name = "unknown";
+    if (is_group) {
+        struct group gr, *res = NULL;
+        if (getgrgid_r((gid_t)id, &gr, buf, sizeof(buf), &res) == 0 && res)
+            name = res->gr_name;
+    } else {
+        struct passwd pw, *res = NULL;
+        if (getpwuid_r((uid_t)id, &pw, buf, sizeof(buf), &res) == 0 && res)
+            name = res->pw_name;
+    }
+    snprintf(out, ID_NAME_MAX, "%s", name);
+
+    // 테이블이 3/4 이상 차면 비우고 다시 채움
+    if (!slot || c->used >= ID_CACHE_SLOTS * 3 / 4) {
+        memset(c->slots, 0, sizeof(c->slots));
+        c->used = 0;
+        slot = id_cache_find(c, id, &found);
+    }
+    slot->used = 1;
+    slot->id = id;
+    memcpy(slot->name, out, ID_NAME_MAX);
+    c->used++;
+    pthread_mutex_unlock(&id_cache_lock);
+}
+
+void uid_to_name(uid_t uid, char *out) {
+    id_cache_lookup(&user_cache, (unsigned int)uid, 0, out);
+}
+
+void gid_to_name(gid_t gid, char *out) {
+    id_cache_lookup(&group_cache, (unsigned int)gid, 1, out);
+}
+
+static inline void put2(char *p, int v) {
+    p[0] = (char)('0' + v / 10);
+    p[1] = (char)('0' + v % 10);
+}
+
+// "YYYY-MM-DD HH:MM:SS" (19자)를 buf에 기록. 실패 시 0 반환
+size_t format_time_cached(time_t t, char *buf) {
+    struct day_cache_slot *slot = &day_cache[((unsigned long)(t / 86400)) % TIME_CACHE_SLOTS];
+
+    if (!slot->valid || t < slot->start || t >= slot->start + 86400) {
+        struct tm tm_info;
+        if (!localtime_r(&t, &tm_info))
+            return 0;
+
+        time_t start = t - (tm_info.tm_hour * 3600 + tm_info.tm_min * 60 + tm_info.tm_sec);
+        struct tm end_info;
+        time_t end = start + 86399;
+        // 하루 중 UTC 오프셋이 바뀌는 날(서머타임 전환)은 캐시하지 않음
+        if (!localtime_r(&end, &end_info) || end_info.tm_gmtoff != tm_info.tm_gmtoff ||
+            end_info.tm_mday != tm_info.tm_mday) {
+            return strftime(buf, 20, "%Y-%m-%d %H:%M:%S", &tm_info);
+        }
+
+        strftime(slot->date, sizeof(slot->date), "%Y-%m-%d", &tm_info);
+        slot->start = start;
+        slot->valid = 1;
+    }
+
+    int secs = (int)(t - slot->start);
+    memcpy(buf, slot->date, 10);
+    buf[10] = ' ';
+    put2(buf + 11, secs / 3600);
+    buf[13] = ':';
+    put2(buf + 14, (secs / 60) % 60);
+    buf[16] = ':';
+    put2(buf + 17, secs % 60);
+    buf[19] = '\0';
+    return 19;
+}
+
+void out_buf_init(struct out_buf *ob, int fd) {
+    ob->fd = fd;
+    ob->data = NULL;
+    ob->len = 0;
+    ob->cap = 0;
+    ob->error = 0;
+}
+
+static int out_buf_reserve(struct out_buf *ob, size_t extra) {
+    if (ob->len + extra <= ob->cap) return 0;
+    size_t cap = ob->cap ? ob->cap : 64 * 1024;
+    while (cap < ob->len + extra)
+        cap *= 2;
+    char *grown = realloc(ob->data, cap);
+    if (!grown) {
+        ob->error = ENOMEM;
+        return -1;
+    }
+    ob->data = grown;
+    ob->cap = cap;
+    return 0;
+}
+
+void out_buf_append(struct out_buf *ob, const char *data, size_t len) {
+    if (out_buf_reserve(ob, len) == -1) return;
+    memcpy(ob->data + ob->len, data, len);
+    ob->len += len;
+}
+
+static inline void out_buf_putc(struct out_buf *ob, char c) {
+    if (out_buf_reserve(ob, 1) == -1) return;
+    ob->data[ob->len++] = c;
+}
+
+static void out_buf_put_u64(struct out_buf *ob, unsigned long long v) {
+    char tmp[24];
+    int n = 0;
+    do {
+        tmp[sizeof(tmp) - 1 - n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    out_buf_append(ob, tmp + sizeof(tmp) - n, n);
+}
+
+int out_buf_flush(struct out_buf *ob) {
+    if (ob->fd < 0) return 0;
+    size_t off = 0;
+    while (off < ob->len) {
+        ssize_t n = write(ob->fd, ob->data + off, ob->len - off);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            ob->error = errno;
+            ob->len = 0;
+            return -1;
+        }
+        off += (size_t)n;
+    }
+    ob->len = 0;
+    return 0;
+}
+
+int out_buf_flush_if_full(struct out_buf *ob) {
+    if (ob->len < OUT_BUF_FLUSH_SIZE) return 0;
+    return out_buf_flush(ob);
+}
+
+void out_buf_free(struct out_buf *ob) {
+    free(ob->data);
+    ob->data = NULL;
+    ob->len = ob->cap = 0;
+}
+
+static void out_buf_put_time(struct out_buf *ob, time_t t) {
+    char buf[32];
+    size_t n = format_time_cached(t, buf);
+    out_buf_append(ob, buf, n);
+}
+
+// ls 한 줄을 버퍼에 추가 (printf 없이 직접 포맷)
+void ls_format_entry(struct out_buf *ob, int dirfd, const struct file_info *fi,
+                     int show_all_times) {
+    char perms[11];
+    char user[ID_NAME_MAX], group[ID_NAME_MAX];
+
+    format_permissions(&fi->st, perms);
+    uid_to_name(fi->st.st_uid, user);
+    gid_to_name(fi->st.st_gid, group);
+
+    out_buf_append(ob, perms, 10);
+    out_buf_putc(ob, ' ');
+    out_buf_put_u64(ob, (unsigned long long)fi->st.st_nlink);
+    out_buf_putc(ob, ' ');
+    out_buf_append(ob, user, strlen(user));
+    out_buf_putc(ob, ' ');
+    out_buf_append(ob, group, strlen(group));
+    out_buf_putc(ob, ' ');
+    out_buf_put_u64(ob, (unsigned long long)fi->st.st_size);
+
+    if (show_all_times) {
+        out_buf_append(ob, "\n  Access:  ", 12);
+        out_buf_put_time(ob, fi->st.st_atime);
+        out_buf_append(ob, "\n  Modify:  ", 12);
+        out_buf_put_time(ob, fi->st.st_mtime);
+        out_buf_append(ob, "\n  Change:  ", 12);
+        out_buf_put_time(ob, fi->st.st_ctime);
+        out_buf_putc(ob, '\n');
+    } else {
+        out_buf_putc(ob, ' ');
+        out_buf_put_time(ob, fi->st.st_mtime);
+    }
+    out_buf_putc(ob, ' ');
+    out_buf_append(ob, fi->name, strlen(fi->name));
+
+    // 심볼릭 링크인 경우 링크 내용 표시
+    if (S_ISLNK(fi->st.st_mode)) {
+        char link_path[MAX_PATH_SIZE];
+        ssize_t len = readlinkat(dirfd, fi->name, link_path, sizeof(link_path) - 1);
+        if (len != -1) {
+            out_buf_append(ob, " -> ", 4);
+            out_buf_append(ob, link_path, (size_t)len);
+        }
+    }
+    out_buf_putc(ob, '\n');
+}
+
+// 16바이트(SSE2) 또는 8바이트(SWAR) 단위로 NUL/상위 비트 바이트를 찾음
+int buffer_looks_binary(const void *data, size_t len) {
+    const unsigned char *p = data;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        // 상위 비트가 켜진 바이트(>127)와 0인 바이트의 마스크를 합침
+        int mask = _mm_movemask_epi8(v) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        if (mask) return 1;
+    }
+#else
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, sizeof(w));
+        // w & highs: 상위 비트 바이트, (w - ones) & ~w & highs: 0인 바이트
+        if ((w & highs) || ((w - ones) & ~w & highs)) return 1;
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (p[i] == 0 || p[i] > 127) return 1;
+    }
+    return 0;
+}
+
+int open_dir_chain(int dirfd, const char *const *names, size_t n) {
+    static int no_openat2;   // ENOSYS(또는 seccomp의 EPERM)를 한 번 보면 한 단계씩만 엶
+    if (n == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    char path[PATH_MAX];
+    int cur = dirfd, owned = -1;
+    size_t i = 0;
+    while (i < n) {
+        size_t len = 0, j = i;
+        if (!__atomic_load_n(&no_openat2, __ATOMIC_RELAXED)) {
+            while (j < n) {
+                size_t name_len = strlen(names[j]);
+                if (len + (len > 0) + name_len >= sizeof(path)) break;
+                if (len > 0) path[len++] = '/';
+                memcpy(path + len, names[j], name_len);
+                len += name_len;
+                j++;
+            }
+        }
+
+        int fd;
+        if (j > i) {
+            path[len] = '\0';
+            struct open_how how;
+            memset(&how, 0, sizeof(how));
+            how.flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+            how.resolve = RESOLVE_NO_SYMLINKS;
+            fd = (int)syscall(SYS_openat2, cur, path, &how, sizeof(how));
+            if (fd == -1 && (errno == ENOSYS || errno == EPERM)) {
+                __atomic_store_n(&no_openat2, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+        } else {
+            fd = openat(cur, names[i], O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            j = i + 1;
+        }
+
+        int err = errno;
+        if (owned != -1) close(owned);
+        if (fd == -1) {
+            errno = err;
+            return -1;
+        }
+        owned = cur = fd;
+        i = j;
+    }
+    return owned;
+}
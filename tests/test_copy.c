@@ -0,0 +1,237 @@
+#define _GNU_SOURCE
+#include "test_util.h"
+#include "../include/copy.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// copy_file_range의 8MB 단위와 버퍼 경로의 1MB 단위를 모두 넘고, 끝이 페이지에 맞지 않는 크기
+#define TEST_SIZE  ((size_t)(9 * 1024 * 1024 + 4097))
+
+static unsigned char *expected;
+
+static void fill_pattern(unsigned char *buf, size_t len) {
+    uint32_t x = 2463534242u;
+    for (size_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (unsigned char)x;
+    }
+}
+
+static void write_file(const char *path, const void *data, size_t len) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1 || write(fd, data, len) != (ssize_t)len) {
+        perror(path);
+        exit(2);
+    }
+    close(fd);
+}
+
+// 파일 내용이 expected의 앞 len바이트와 같은지
+static int file_matches(const char *path, size_t len) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return 0;
+    unsigned char *buf = malloc(len + 1);
+    size_t got = 0;
+    ssize_t n;
+    while (buf && (n = read(fd, buf + got, len + 1 - got)) > 0)
+        got += (size_t)n;
+    close(fd);
+    int same = buf && got == len && memcmp(buf, expected, len) == 0;
+    free(buf);
+    return same;
+}
+
+// 일반 파일끼리: copy_file_range가 끝까지 처리
+static void test_copy_file_range(const char *src, const char *dst) {
+    unsigned long long progress = 0;
+    struct copy_stats stats = { 0, COPY_METHOD_NONE, &progress, NULL };
+    CHECK(copy_file(src, dst, &stats) == 0);
+    CHECK(stats.method == COPY_METHOD_RANGE);
+    CHECK(stats.bytes == TEST_SIZE && progress == TEST_SIZE);
+    CHECK(file_matches(dst, TEST_SIZE));
+
+    struct stat st;
+    CHECK(stat(dst, &st) == 0 && (st.st_mode & 0777) == 0644);
+}
+
+struct pipe_reader {
+    int fd;
+    unsigned char *buf;
+    size_t len;
+};
+
+static void *drain_pipe(void *arg) {
+    struct pipe_reader *r = arg;
+    ssize_t n;
+    while (r->len < TEST_SIZE + 1 && (n = read(r->fd, r->buf + r->len, TEST_SIZE + 1 - r->len)) > 0)
+        r->len += (size_t)n;
+    return NULL;
+}
+
+// 대상이 파이프면 copy_file_range는 EINVAL이므로 sendfile로 넘어감
+static void test_sendfile(const char *src) {
+    int p[2];
+    CHECK(pipe(p) == 0);
+    struct pipe_reader reader = { p[0], malloc(TEST_SIZE + 1), 0 };
+    if (!reader.buf) exit(2);
+    pthread_t thread;
+    CHECK(pthread_create(&thread, NULL, drain_pipe, &reader) == 0);
+
+    int in = open(src, O_RDONLY);
+    struct copy_stats stats = { 0 };
+    CHECK(copy_fd(in, p[1], &stats) == 0);
+    CHECK(stats.method == COPY_METHOD_SENDFILE);
+    CHECK(stats.bytes == TEST_SIZE);
+    close(in);
+    close(p[1]);
+
+    pthread_join(thread, NULL);
+    close(p[0]);
+    CHECK(reader.len == TEST_SIZE && memcmp(reader.buf, expected, TEST_SIZE) == 0);
+    free(reader.buf);
+}
+
+// O_APPEND 대상은 copy_file_range가 EBADF, sendfile이 EINVAL이라 버퍼 경로까지 내려감
+static void test_buffer_append(const char *src, const char *dst) {
+    int in = open(src, O_RDONLY);
+    int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    struct copy_stats stats = { 0 };
+    CHECK(copy_fd(in, out, &stats) == 0);
+    CHECK(stats.method == COPY_METHOD_BUFFER);
+    CHECK(stats.bytes == TEST_SIZE);
+    close(in);
+    close(out);
+    CHECK(file_matches(dst, TEST_SIZE));
+}
+
+// 원본이 파이프면 두 시스템 콜 모두 EINVAL
+static void test_buffer_from_pipe(const char *dst) {
+    int p[2];
+    CHECK(pipe(p) == 0);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(p[0]);
+        size_t off = 0;
+        ssize_t n;
+        while (off < TEST_SIZE && (n = write(p[1], expected + off, TEST_SIZE - off)) > 0)
+            off += (size_t)n;
+        _exit(off == TEST_SIZE ? 0 : 1);
+    }
+    close(p[1]);
+
+    int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    struct copy_stats stats = { 0 };
+    CHECK(copy_fd(p[0], out, &stats) == 0);
+    CHECK(stats.method == COPY_METHOD_BUFFER);
+    CHECK(stats.bytes == TEST_SIZE);
+    close(p[0]);
+    close(out);
+    CHECK(file_matches(dst, TEST_SIZE));
+
+    int status = 0;
+    CHECK(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+// 빈 파일은 어느 방식도 복사할 것이 없어 버퍼 경로에서 0바이트로 끝남
+static void test_empty_and_errors(const char *root, const char *src) {
+    char empty[MAX_PATH_SIZE], dst[MAX_PATH_SIZE];
+    test_path(empty, sizeof(empty), root, "empty");
+    test_path(dst, sizeof(dst), root, "empty.copy");
+    write_file(empty, "", 0);
+    struct copy_stats stats = { 0 };
+    CHECK(copy_file(empty, dst, &stats) == 0);
+    CHECK(stats.bytes == 0);
+    CHECK(file_matches(dst, 0));
+
+    // 자기 자신으로 복사하면 O_TRUNC로 원본이 지워지므로 거부
+    errno = 0;
+    CHECK(copy_file(src, src, NULL) == -1 && errno == EINVAL);
+    CHECK(file_matches(src, TEST_SIZE));
+
+    int cancel = 1;
+    struct copy_stats canceled = { 0, COPY_METHOD_NONE, NULL, &cancel };
+    errno = 0;
+    CHECK(copy_file(src, dst, &canceled) == -1 && errno == ECANCELED);
+}
+
+// 복사 작업 하나를 끝까지 돌림. 실패하면 첫 오류 메시지를 error에 복사
+static int run_copy_job(const char *src, const char *dst, char *error, size_t error_size) {
+    const char *sources[1] = { src };
+    const char *targets[1] = { dst };
+    struct copy_job *job = copy_job_start(sources, targets, 1, 1, 0);
+    if (!job) return -1;
+    int result = copy_job_wait(job);
+    snprintf(error, error_size, "%s", copy_job_error(job) ? copy_job_error(job) : "");
+    copy_job_free(job);
+    return result;
+}
+
+// 디렉토리를 자기 안으로 복사하는 것은 경로를 어떻게 적어도 거부해야 함
+static void test_copy_into_itself(const char *root) {
+    char tree[MAX_PATH_SIZE], path[MAX_PATH_SIZE], link[MAX_PATH_SIZE], cwd[MAX_PATH_SIZE];
+    test_path(tree, sizeof(tree), root, "tree");
+    CHECK(mkdir(tree, 0755) == 0);
+    test_path(path, sizeof(path), tree, "sub");
+    CHECK(mkdir(path, 0755) == 0);
+    test_path(path, sizeof(path), tree, "file");
+    write_file(path, "data", 4);
+    test_path(link, sizeof(link), root, "alias");
+    CHECK(symlink("tree/sub", link) == 0);
+
+    const char *inside[] = {
+        "tree/sub/copy",            // 상대 경로
+        "tree/./sub/../copy",       // 정규화되지 않은 경로
+        "alias/copy",               // 원본 안을 가리키는 심볼릭 링크
+        "alias/../../tree/deeper/copy",
+        "tree",                     // 자기 자신
+    };
+    CHECK(getcwd(cwd, sizeof(cwd)) != NULL);
+    CHECK(chdir(root) == 0);
+    char error[MAX_PATH_SIZE * 2], expect[MAX_PATH_SIZE * 2];
+    for (size_t i = 0; i < sizeof(inside) / sizeof(inside[0]); i++) {
+        snprintf(expect, sizeof(expect), "%s: %s", inside[i], strerror(EINVAL));
+        if (run_copy_job("tree", inside[i], error, sizeof(error)) != -1 || strcmp(error, expect) != 0) {
+            fprintf(stderr, "  (대상: %s, 오류: %s)\n", inside[i], error);
+            CHECK(!"자기 안으로 복사가 허용됨");
+        }
+    }
+    struct stat st;
+    CHECK(lstat("tree/copy", &st) == -1 && lstat("tree/sub/copy", &st) == -1);
+    CHECK(lstat("tree/deeper", &st) == -1);
+
+    // 이름이 원본으로 시작할 뿐인 형제 디렉토리는 허용
+    CHECK(run_copy_job("tree", "tree2", error, sizeof(error)) == 0);
+    CHECK(lstat("tree2/sub", &st) == 0 && S_ISDIR(st.st_mode));
+    CHECK(lstat("tree2/file", &st) == 0 && st.st_size == 4);
+    CHECK(chdir(cwd) == 0);
+}
+
+int main(void) {
+    char root[MAX_PATH_SIZE], src[MAX_PATH_SIZE], dst[MAX_PATH_SIZE];
+    test_make_dir(root, sizeof(root), "test_copy");
+    test_path(src, sizeof(src), root, "src");
+    test_path(dst, sizeof(dst), root, "dst");
+
+    expected = malloc(TEST_SIZE);
+    if (!expected) return 2;
+    fill_pattern(expected, TEST_SIZE);
+    write_file(src, expected, TEST_SIZE);
+
+    test_copy_file_range(src, dst);
+    test_sendfile(src);
+    test_buffer_append(src, dst);
+    test_buffer_from_pipe(dst);
+    test_empty_and_errors(root, src);
+    test_copy_into_itself(root);
+
+    free(expected);
+    test_remove_dir(root);
+    return TEST_RESULT();
+}
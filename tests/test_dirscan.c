@@ -0,0 +1,154 @@
+#define _GNU_SOURCE
+#include "test_util.h"
+#include "../include/dirscan.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define VANISH_FILES  200   // DIRSCAN_PARALLEL_MIN보다 많아야 워커 풀을 거침
+
+static void make_file(const char *dir, const char *name, const char *data) {
+    char path[MAX_PATH_SIZE];
+    test_path(path, sizeof(path), dir, name);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        perror(path);
+        exit(2);
+    }
+    if (data && write(fd, data, strlen(data)) != (ssize_t)strlen(data)) {
+        perror(path);
+        exit(2);
+    }
+    close(fd);
+}
+
+static const struct dir_entry *find_entry(const struct dir_listing *l, const char *name) {
+    for (size_t i = 0; i < l->count; i++) {
+        if (strcmp(dir_entry_name(l, &l->entries[i]), name) == 0)
+            return &l->entries[i];
+    }
+    return NULL;
+}
+
+// 이름과 유형: d_type만으로 판별되는 것과 statx로 채운 모드가 일치해야 함
+static void test_names_and_types(const char *root) {
+    char dir[MAX_PATH_SIZE], path[MAX_PATH_SIZE];
+    test_path(dir, sizeof(dir), root, "types");
+    CHECK(mkdir(dir, 0755) == 0);
+    make_file(dir, "file", "hello");
+    test_path(path, sizeof(path), dir, "sub");
+    CHECK(mkdir(path, 0755) == 0);
+    test_path(path, sizeof(path), dir, "link");
+    CHECK(symlink("file", path) == 0);
+    test_path(path, sizeof(path), dir, "fifo");
+    CHECK(mkfifo(path, 0644) == 0);
+
+    struct dir_listing l;
+    CHECK(dir_listing_open(&l, dir, 0) == 0);
+    CHECK(l.count == 6);
+    CHECK(find_entry(&l, ".") && find_entry(&l, ".."));
+    dir_listing_free(&l);
+
+    CHECK(dir_listing_scan(&l, dir, DIRSCAN_SKIP_DOTS, DIRSCAN_NEED_ALL) == 0);
+    CHECK(l.count == 4);
+    CHECK(!find_entry(&l, ".") && !find_entry(&l, ".."));
+
+    const struct dir_entry *e = find_entry(&l, "file");
+    CHECK(e && e->error == 0 && dir_entry_is_reg(e) && e->size == 5);
+    e = find_entry(&l, "sub");
+    CHECK(e && e->error == 0 && dir_entry_is_dir(e) && !dir_entry_is_reg(e));
+    e = find_entry(&l, "link");
+    CHECK(e && e->error == 0 && S_ISLNK(e->mode) && !dir_entry_is_reg(e));
+    e = find_entry(&l, "fifo");
+    CHECK(e && e->error == 0 && S_ISFIFO(e->mode));
+
+    for (size_t i = 0; i < l.count; i++) {
+        struct stat st;
+        CHECK(fstatat(l.dirfd, dir_entry_name(&l, &l.entries[i]), &st, AT_SYMLINK_NOFOLLOW) == 0);
+        CHECK(l.entries[i].mode == st.st_mode);
+        CHECK(l.entries[i].ino == st.st_ino);
+        CHECK(l.entries[i].name_len == strlen(dir_entry_name(&l, &l.entries[i])));
+    }
+    dir_listing_free(&l);
+}
+
+static void test_empty_directory(const char *root) {
+    char dir[MAX_PATH_SIZE];
+    test_path(dir, sizeof(dir), root, "empty");
+    CHECK(mkdir(dir, 0755) == 0);
+
+    struct dir_listing l;
+    CHECK(dir_listing_scan(&l, dir, DIRSCAN_SKIP_DOTS, DIRSCAN_NEED_ALL) == 0);
+    CHECK(l.count == 0);
+    CHECK(dir_listing_fetch(&l, 0, 10, DIRSCAN_NEED_SIZE) == 0);
+    dir_listing_free(&l);
+
+    test_path(dir, sizeof(dir), root, "missing");
+    errno = 0;
+    CHECK(dir_listing_open(&l, dir, 0) == -1);
+    CHECK(errno == ENOENT);
+}
+
+// getdents64로 읽은 뒤 statx 전에 지워지거나 디렉토리로 바뀐 엔트리
+static void test_vanished_entries(const char *root, int workers) {
+    char dir[MAX_PATH_SIZE], path[MAX_PATH_SIZE], name[32];
+    snprintf(name, sizeof(name), "vanish%d", workers);
+    test_path(dir, sizeof(dir), root, name);
+    CHECK(mkdir(dir, 0755) == 0);
+    for (int i = 0; i < VANISH_FILES; i++) {
+        snprintf(name, sizeof(name), "f%03d", i);
+        make_file(dir, name, i % 2 ? "xy" : "x");
+    }
+
+    struct dir_listing l;
+    CHECK(dir_listing_open(&l, dir, DIRSCAN_SKIP_DOTS) == 0);
+    CHECK(l.count == VANISH_FILES);
+    l.workers = workers;
+
+    for (int i = 0; i < VANISH_FILES; i += 3) {
+        snprintf(name, sizeof(name), "f%03d", i);
+        test_path(path, sizeof(path), dir, name);
+        CHECK(unlink(path) == 0);
+        if (i % 2 == 0) continue;
+        // 같은 이름이 디렉토리로 다시 생김: d_type은 DT_REG였지만 statx 결과를 따라야 함
+        CHECK(mkdir(path, 0755) == 0);
+    }
+
+    CHECK(dir_listing_fetch(&l, 0, l.count, DIRSCAN_NEED_SIZE | DIRSCAN_NEED_OWNER) == 0);
+    for (size_t i = 0; i < l.count; i++) {
+        const struct dir_entry *e = &l.entries[i];
+        int n = atoi(dir_entry_name(&l, e) + 1);
+        if (n % 3 != 0) {
+            CHECK(e->error == 0 && dir_entry_is_reg(e));
+            CHECK(e->size == (n % 2 ? 2 : 1));
+        } else if (n % 2 == 0) {
+            CHECK(e->error == ENOENT);
+        } else {
+            CHECK(e->error == 0 && dir_entry_is_dir(e));
+        }
+    }
+
+    // 사라진 엔트리는 다시 조회해도 같은 오류로 남음
+    uint32_t first = 0;
+    for (size_t i = 0; i < l.count; i++) {
+        if (strcmp(dir_entry_name(&l, &l.entries[i]), "f000") == 0)
+            first = (uint32_t)i;
+    }
+    CHECK(dir_listing_fetch_indices(&l, &first, 1, DIRSCAN_NEED_SIZE) == 0);
+    CHECK(l.entries[first].error == ENOENT);
+    dir_listing_free(&l);
+}
+
+int main(void) {
+    char root[MAX_PATH_SIZE];
+    test_make_dir(root, sizeof(root), "test_dirscan");
+
+    test_names_and_types(root);
+    test_empty_directory(root);
+    test_vanished_entries(root, 1);
+    test_vanished_entries(root, 4);
+
+    test_remove_dir(root);
+    return TEST_RESULT();
+}
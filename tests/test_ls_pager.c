@@ -0,0 +1,83 @@
+#define _GNU_SOURCE
+#include "test_util.h"
+#include "../include/commands.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define FILES     1500      // 여러 페이지 (LS_PAGE_SIZE 512)
+#define REMOVED   (FILES / 5)
+
+// 크기가 이름 순서대로 커지므로 -S(큰 것부터)는 이름 역순이 됨
+static void make_files(const char *dir) {
+    char path[MAX_PATH_SIZE], name[32];
+    for (int i = 0; i < FILES; i++) {
+        snprintf(name, sizeof(name), "f%04d", i);
+        test_path(path, sizeof(path), dir, name);
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1 || ftruncate(fd, i + 1) == -1) {
+            perror(path);
+            exit(2);
+        }
+        close(fd);
+    }
+}
+
+// 목록을 연 뒤 첫 페이지를 읽기 전에 5개 중 하나를 지움
+static void remove_every_fifth(const char *dir) {
+    char path[MAX_PATH_SIZE], name[32];
+    for (int i = 0; i < FILES; i += 5) {
+        snprintf(name, sizeof(name), "f%04d", i);
+        test_path(path, sizeof(path), dir, name);
+        CHECK(unlink(path) == 0);
+    }
+}
+
+static void test_vanished(const char *root, const char *sub, int by_size) {
+    char dir[MAX_PATH_SIZE];
+    test_path(dir, sizeof(dir), root, sub);
+    CHECK(mkdir(dir, 0755) == 0);
+    make_files(dir);
+
+    struct ls_options opts = { 0, by_size, 0, 0, 1, 0 };
+    struct ls_pager pager;
+    CHECK(ls_pager_open(&pager, dir, &opts) == 0);
+    CHECK(pager.total == FILES + 2);    // "."과 ".." 포함
+    remove_every_fifth(dir);
+
+    struct file_info *page = malloc(LS_PAGE_SIZE * sizeof(*page));
+    if (!page) exit(2);
+    size_t seen = 0, n;
+    int last = by_size ? FILES : -1;
+    while ((n = ls_pager_next(&pager, page, LS_PAGE_SIZE)) > 0) {
+        seen += n;
+        // 지운 만큼 total이 줄어 pos와 total이 실제로 내보낸 개수와 맞아야 함
+        CHECK(pager.pos == seen);
+        CHECK(pager.pos <= pager.total);
+        for (size_t i = 0; i < n; i++) {
+            if (page[i].name[0] != 'f') continue;
+            int index = atoi(page[i].name + 1);
+            CHECK(index % 5 != 0);
+            CHECK(by_size ? index < last : index > last);
+            CHECK(page[i].st.st_size == index + 1);
+            last = index;
+        }
+    }
+    CHECK(seen == FILES - REMOVED + 2);
+    CHECK(pager.total == seen && pager.pos == pager.total);
+    CHECK(ls_pager_next(&pager, page, LS_PAGE_SIZE) == 0);
+
+    free(page);
+    ls_pager_close(&pager);
+}
+
+int main(void) {
+    char root[MAX_PATH_SIZE];
+    test_make_dir(root, sizeof(root), "test_ls_pager");
+
+    test_vanished(root, "by_name", 0);
+    test_vanished(root, "by_size", 1);
+
+    test_remove_dir(root);
+    return TEST_RESULT();
+}
@@ -0,0 +1,161 @@
+#include "test_util.h"
+#include "../include/proctree.h"
+
+#define MAX_CASE_PROCS  8
+#define CHAIN_LENGTH    100000   // 재귀로 걸으면 스택이 넘치는 깊이
+
+// 입력 pid/ppid와 기대하는 부모 pid (0이면 루트)
+struct tree_case {
+    const char *name;
+    size_t n;
+    pid_t pid[MAX_CASE_PROCS];
+    pid_t ppid[MAX_CASE_PROCS];
+    pid_t expect_parent[MAX_CASE_PROCS];
+};
+
+static const struct tree_case cases[] = {
+    { "빈 목록", 0, { 0 }, { 0 }, { 0 } },
+    { "init과 자식들", 4,
+      { 1, 100, 200, 101 }, { 0, 1, 1, 100 }, { 0, 1, 1, 100 } },
+    { "자기 자신이 부모", 3,
+      { 5, 6, 7 }, { 5, 5, 6 }, { 0, 5, 6 } },
+    { "두 노드 순환", 3,
+      { 10, 20, 30 }, { 20, 10, 10 }, { 20, 0, 10 } },
+    { "세 노드 순환과 꼬리", 5,
+      { 1, 2, 3, 4, 5 }, { 3, 1, 2, 3, 4 }, { 3, 0, 2, 3, 4 } },
+    { "부모가 목록에 없음", 4,
+      { 50, 51, 52, 53 }, { 1, 999, 50, 999 }, { 0, 0, 50, 0 } },
+    { "자식이 부모보다 먼저", 4,
+      { 300, 301, 200, 100 }, { 200, 200, 100, 0 }, { 200, 200, 100, 0 } },
+};
+
+static int is_ancestor(const struct proc_tree *tree, size_t ancestor, size_t node) {
+    for (size_t p = node; p != PROC_TREE_NONE; p = tree->parent[p]) {
+        if (p == ancestor) return 1;
+    }
+    return 0;
+}
+
+// 입력과 무관하게 항상 성립해야 하는 구조: CSR 자식 목록, 전위 순서, 하위 트리 구간, 깊이
+static void check_invariants(const struct proc_tree *tree) {
+    size_t n = tree->count;
+    size_t seen_roots = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t p = tree->parent[i];
+        if (p == PROC_TREE_NONE) {
+            seen_roots++;
+            CHECK(tree->depth[i] == 0);
+            CHECK(tree->position[i] < tree->nroots && tree->roots[tree->position[i]] == i);
+        } else {
+            CHECK(p < n && p != i);
+            CHECK(tree->depth[i] == tree->depth[p] + 1);
+            CHECK(tree->child_start[p] + tree->position[i] < tree->child_start[p + 1]);
+            CHECK(tree->children[tree->child_start[p] + tree->position[i]] == i);
+        }
+
+        // 자식은 입력 순서대로, 하위 트리 크기는 자식들의 합 + 1
+        size_t size = 1;
+        for (size_t c = tree->child_start[i]; c < tree->child_start[i + 1]; c++) {
+            if (c > tree->child_start[i])
+                CHECK(tree->children[c - 1] < tree->children[c]);
+            size += tree->subtree_size[tree->children[c]];
+        }
+        CHECK(tree->subtree_size[i] == size);
+
+        CHECK(tree->preorder_pos[i] < n && tree->preorder[tree->preorder_pos[i]] == i);
+    }
+    CHECK(seen_roots == tree->nroots);
+    CHECK(tree->child_start[0] == 0 && tree->child_start[n] == n - tree->nroots);
+}
+
+// 하위 트리 구간은 그 노드의 자손 전부이고 자손만 들어 있어야 함 (O(n^2), 작은 입력용)
+static void check_subtree_ranges(const struct proc_tree *tree) {
+    for (size_t i = 0; i < tree->count; i++) {
+        size_t begin = tree->preorder_pos[i];
+        size_t end = begin + tree->subtree_size[i];
+        CHECK(end <= tree->count);
+        for (size_t k = 0; k < tree->count; k++) {
+            int inside = k >= begin && k < end;
+            CHECK(inside == is_ancestor(tree, i, tree->preorder[k]));
+        }
+    }
+}
+
+static void check_sums(const struct proc_tree *tree) {
+    double values[MAX_CASE_PROCS], sums[MAX_CASE_PROCS];
+    for (size_t i = 0; i < tree->count; i++)
+        values[i] = (double)(1u << i);
+    proc_tree_sum(tree, values, sums);
+
+    for (size_t i = 0; i < tree->count; i++) {
+        double expect = 0;
+        for (size_t k = 0; k < tree->count; k++) {
+            if (is_ancestor(tree, i, k)) expect += values[k];
+        }
+        CHECK(sums[i] == expect);
+    }
+
+    // values와 sums가 같은 배열이어도 결과가 같아야 함
+    proc_tree_sum(tree, values, values);
+    for (size_t i = 0; i < tree->count; i++)
+        CHECK(values[i] == sums[i]);
+}
+
+static void test_cases(void) {
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const struct tree_case *tc = &cases[c];
+        int before = test_failures;
+
+        struct proc_tree tree;
+        CHECK(proc_tree_build(tc->pid, tc->ppid, tc->n, &tree) == 0);
+        CHECK(tree.count == tc->n);
+        for (size_t i = 0; i < tc->n; i++) {
+            pid_t parent = tree.parent[i] == PROC_TREE_NONE ? 0 : tc->pid[tree.parent[i]];
+            CHECK(parent == tc->expect_parent[i]);
+        }
+        check_invariants(&tree);
+        check_subtree_ranges(&tree);
+        check_sums(&tree);
+        proc_tree_free(&tree);
+
+        if (test_failures != before)
+            fprintf(stderr, "  (경우: %s)\n", tc->name);
+    }
+}
+
+// 일자로 긴 사슬: 전위 순서와 합계가 재귀 없이 끝까지 가야 함
+static void test_long_chain(void) {
+    pid_t *pid = malloc(CHAIN_LENGTH * sizeof(*pid));
+    pid_t *ppid = malloc(CHAIN_LENGTH * sizeof(*ppid));
+    double *values = malloc(CHAIN_LENGTH * sizeof(*values));
+    if (!pid || !ppid || !values) exit(2);
+
+    // 역순으로 넣어 부모가 항상 뒤에 오게 함
+    for (size_t i = 0; i < CHAIN_LENGTH; i++) {
+        pid[i] = (pid_t)(CHAIN_LENGTH - i + 1);
+        ppid[i] = pid[i] - 1;
+        values[i] = 1;
+    }
+
+    struct proc_tree tree;
+    CHECK(proc_tree_build(pid, ppid, CHAIN_LENGTH, &tree) == 0);
+    check_invariants(&tree);
+    CHECK(tree.nroots == 1 && tree.roots[0] == CHAIN_LENGTH - 1);
+    CHECK(tree.depth[0] == CHAIN_LENGTH - 1);
+    CHECK(tree.subtree_size[CHAIN_LENGTH - 1] == CHAIN_LENGTH);
+    proc_tree_sum(&tree, values, values);
+    CHECK(values[CHAIN_LENGTH - 1] == CHAIN_LENGTH);
+    CHECK(values[0] == 1);
+    proc_tree_free(&tree);
+
+    free(pid);
+    free(ppid);
+    free(values);
+}
+
+int main(void) {
+    test_cases();
+    test_long_chain();
+    return TEST_RESULT();
+}
@@ -0,0 +1,162 @@
+#define _GNU_SOURCE
+#include "test_util.h"
+#include "../include/shmring.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// 용량 2짜리 링에 생산자 여럿이 몰려 거의 매번 가득 찬 상태에서 CAS 경쟁과 futex 대기를 거침
+#define RING_CAPACITY   2
+#define MSG_MAX         64
+#define PRODUCERS       4
+#define MESSAGES        20000    // 생산자 하나당
+#define WAIT_MS         10000
+
+struct test_msg {
+    uint32_t producer;
+    uint32_t seq;
+    unsigned char payload[MSG_MAX - 8];
+};
+
+// 길이와 내용이 (생산자, 순번)마다 달라 다른 메시지의 슬롯을 읽거나 섞이면 드러남
+static size_t msg_len(uint32_t producer, uint32_t seq) {
+    return 8 + (producer * 7 + seq) % (MSG_MAX - 8 + 1);
+}
+
+static unsigned char payload_byte(uint32_t producer, uint32_t seq, size_t i) {
+    return (unsigned char)(producer * 31 + seq * 7 + i);
+}
+
+static int produce(struct shm_ring *ring, uint32_t producer) {
+    struct test_msg m;
+    m.producer = producer;
+    for (uint32_t seq = 0; seq < MESSAGES; seq++) {
+        size_t len = msg_len(producer, seq);
+        m.seq = seq;
+        for (size_t i = 0; i < len - 8; i++)
+            m.payload[i] = payload_byte(producer, seq, i);
+        if (shm_ring_send(ring, &m, len, WAIT_MS) == -1) {
+            perror("shm_ring_send");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 생산자별 순서가 지켜지고 모든 메시지가 한 번씩, 내용 그대로 도착해야 함
+static void consume(struct shm_ring *ring) {
+    uint32_t next[PRODUCERS] = { 0 };
+    unsigned long received = 0, bad = 0;
+    struct test_msg m;
+
+    while (received < (unsigned long)PRODUCERS * MESSAGES) {
+        ssize_t n = shm_ring_recv(ring, &m, sizeof(m), WAIT_MS);
+        if (n == -1) {
+            perror("shm_ring_recv");
+            break;
+        }
+        received++;
+        if (n < 8 || m.producer >= PRODUCERS || m.seq != next[m.producer] ||
+            (size_t)n != msg_len(m.producer, m.seq)) {
+            if (bad++ < 5)
+                fprintf(stderr, "순서/길이 오류: 생산자 %u 순번 %u (기대 %u) 길이 %zd\n",
+                        m.producer, m.seq, m.producer < PRODUCERS ? next[m.producer] : 0, n);
+            if (m.producer < PRODUCERS) next[m.producer] = m.seq + 1;
+            continue;
+        }
+        for (size_t i = 0; i < (size_t)n - 8; i++) {
+            if (m.payload[i] != payload_byte(m.producer, m.seq, i)) {
+                bad++;
+                break;
+            }
+        }
+        next[m.producer]++;
+    }
+
+    CHECK(bad == 0);
+    CHECK(received == (unsigned long)PRODUCERS * MESSAGES);
+    for (int p = 0; p < PRODUCERS; p++)
+        CHECK(next[p] == MESSAGES);
+
+    char extra[MSG_MAX];
+    errno = 0;
+    CHECK(shm_ring_try_recv(ring, extra, sizeof(extra)) == -1 && errno == EAGAIN);
+
+    struct shm_ring_stats stats;
+    shm_ring_get_stats(ring, &stats);
+    CHECK(stats.capacity == RING_CAPACITY);
+    CHECK(stats.sent == (uint64_t)PRODUCERS * MESSAGES);
+    CHECK(stats.received == stats.sent);
+}
+
+struct producer_arg {
+    struct shm_ring *ring;
+    uint32_t id;
+    int result;
+};
+
+static void *producer_thread(void *arg) {
+    struct producer_arg *a = arg;
+    a->result = produce(a->ring, a->id);
+    return NULL;
+}
+
+// 한 프로세스 안의 스레드들이 같은 매핑을 공유
+static void test_threads(const char *path) {
+    struct shm_ring ring;
+    CHECK(shm_ring_create(&ring, path, RING_CAPACITY, MSG_MAX, SHM_RING_MPSC) == 0);
+    if (!ring.shared) return;
+
+    pthread_t threads[PRODUCERS];
+    struct producer_arg args[PRODUCERS];
+    for (int p = 0; p < PRODUCERS; p++) {
+        args[p] = (struct producer_arg){ &ring, (uint32_t)p, -1 };
+        CHECK(pthread_create(&threads[p], NULL, producer_thread, &args[p]) == 0);
+    }
+    consume(&ring);
+    for (int p = 0; p < PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+        CHECK(args[p].result == 0);
+    }
+    shm_ring_close(&ring);
+}
+
+// fork한 생산자들이 파일을 따로 shm_ring_open해서 다른 주소에 매핑
+static void test_processes(const char *path) {
+    struct shm_ring ring;
+    CHECK(shm_ring_create(&ring, path, RING_CAPACITY, MSG_MAX, SHM_RING_MPSC) == 0);
+    if (!ring.shared) return;
+
+    pid_t pids[PRODUCERS];
+    for (int p = 0; p < PRODUCERS; p++) {
+        pids[p] = fork();
+        if (pids[p] == 0) {
+            struct shm_ring own;
+            if (shm_ring_open(&own, path) == -1) _exit(1);
+            _exit(produce(&own, (uint32_t)p) == 0 ? 0 : 1);
+        }
+        CHECK(pids[p] > 0);
+    }
+    consume(&ring);
+    for (int p = 0; p < PRODUCERS; p++) {
+        int status = 0;
+        if (pids[p] <= 0) continue;
+        CHECK(waitpid(pids[p], &status, 0) == pids[p]);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    shm_ring_close(&ring);
+}
+
+int main(void) {
+    char root[MAX_PATH_SIZE], path[MAX_PATH_SIZE];
+    test_make_dir(root, sizeof(root), "test_shmring");
+    test_path(path, sizeof(path), root, "ring");
+
+    test_threads(path);
+    test_processes(path);
+
+    test_remove_dir(root);
+    return TEST_RESULT();
+}
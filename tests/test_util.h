@@ -0,0 +1,48 @@
+#pragma once
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include "../include/remove.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ctest 단위 테스트 공용 도우미. 실패한 CHECK는 위치를 찍고 계속 진행하며,
+// main은 TEST_RESULT()로 실패가 하나라도 있으면 1을 돌려줌
+static int test_failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: 실패: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (test_failures ? 1 : 0)
+
+// $TMPDIR(없으면 /tmp) 아래에 빈 작업 디렉토리를 만듦. 실패하면 테스트를 중단
+static inline void test_make_dir(char *path, size_t size, const char *name) {
+    const char *tmp = getenv("TMPDIR");
+    snprintf(path, size, "%s/%s.XXXXXX", tmp && *tmp ? tmp : "/tmp", name);
+    if (!mkdtemp(path)) {
+        perror(path);
+        exit(2);
+    }
+}
+
+// dir/name을 path에 만듦. 잘리면 테스트를 중단
+static inline void test_path(char *path, size_t size, const char *dir, const char *name) {
+    if ((size_t)snprintf(path, size, "%s/%s", dir, name) >= size) {
+        fprintf(stderr, "경로가 너무 깁니다: %s/%s\n", dir, name);
+        exit(2);
+    }
+}
+
+static inline void test_remove_dir(const char *path) {
+    char error[256] = "";
+    if (remove_tree(path, 1, NULL, error, sizeof(error)) == -1)
+        fprintf(stderr, "%s 정리 실패: %s\n", path, error);
+}
+
+#endif // TEST_UTIL_H